@@ -0,0 +1,45 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __ALARM_H
+#define __ALARM_H
+
+/* Includes */
+#include "stm32f1xx.h"
+#include "timebase.h"
+
+/* Exported defines */
+#define ALARM_COUNT					4			// size of the alarm table
+#define ALARM_NONE					0xFFFFFFFF	// no alarm is scheduled
+#define ALARM_EVERY_DAY				0x7F		// weekday mask, bit 0 is sunday, bit 6 is saturday
+#define ALARM_FLAG_ENABLED			0x01
+#define ALARM_FLAG_ONESHOT			0x02		// the alarm is disabled after it rang once
+#define ALARM_FLAG_SKIP_NEXT		0x04		// the next ring is skipped
+/* the time of alarm 0 is kept in BKP_DR6/7 and its rule in BKP_DR8, as older firmware did. The alarms 1..3
+ * are kept in BKP_DR11..16, comment this on devices with 10 backup registers (low and medium density),
+ * the alarms 1..3 are kept in ram only then. */
+#define ALARM_BKP_EXTENDED
+
+/* Exported types */
+typedef struct {
+	uint8_t		hours;
+	uint8_t		minutes;
+	uint8_t		weekdays;			// weekday mask of the days to ring
+	uint8_t		flags;
+	uint32_t	next;				// seconds since the epoch of the next ring
+}Alarm;
+
+/* Exported constants */
+
+/* Exported macro */
+
+/* Exported functions */
+void init_alarm(void);
+void alarm_set(uint8_t index, uint8_t hours, uint8_t minutes, uint8_t weekdays, uint8_t flags, uint32_t now);
+void alarm_set_time(uint8_t index, uint8_t hours, uint8_t minutes, uint32_t now);
+void alarm_disable(uint8_t index);
+void alarm_skip_next(uint8_t index, uint32_t now);
+void alarm_schedule(uint32_t now);
+uint32_t alarm_next(void);
+uint8_t alarm_fired(uint32_t now);
+Alarm* alarm_get(uint8_t index);
+
+#endif
@@ -0,0 +1,43 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __ANIMATION_H
+#define __ANIMATION_H
+
+/* Includes */
+#include "stm32f1xx.h"
+#include "ws2812.h"
+#include "effect.h"
+
+/* Exported defines */
+/* animation asset format, all values are bytes:
+ * header:	ANIMATION_VERSION, palette size, frame period in ms, frame count
+ * palette:	red, green, blue for every palette entry (at most 64)
+ * frames:	frame type, ops... ANIMATION_OP_END
+ * 			a key frame starts on a dark display, a delta frame on the previous frame
+ * 			the ops walk through the pixels row by row, starting at the top left pixel:
+ * 			0x00				end of the frame
+ * 			0x01..0x7F			skip n pixels, they keep the color of the previous frame
+ * 			0x80|(n-1), color	run of n (1..64) pixels with the palette color
+ * 			0xC0|color			1 pixel with the palette color
+ * the assets are generated with tools/anim_encode.py */
+#define ANIMATION_VERSION			1
+#define ANIMATION_HEADER_SIZE		4
+#define ANIMATION_FRAME_DELTA		0x00
+#define ANIMATION_FRAME_KEY			0x01
+#define ANIMATION_OP_END			0x00
+#define ANIMATION_OP_RUN			0x80
+#define ANIMATION_OP_PIXEL			0xC0
+#define ANIMATION_AMBIENT_FULL		26		// ambient light factor at which the palette colors are shown as they are
+
+/* Exported types */
+
+/* Exported constants */
+extern const uint8_t animation_sunrise[];
+
+/* Exported macro */
+
+/* Exported functions */
+void init_animation(uint16_t *ambient_factor);
+uint8_t animation_valid(const uint8_t *animation);
+uint8_t animation_decode_frame(const uint8_t *animation, const uint8_t **position, uint16_t *ambient_factor);
+
+#endif
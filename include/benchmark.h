@@ -0,0 +1,38 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __BENCHMARK_H
+#define __BENCHMARK_H
+
+/* Includes */
+#include "stm32f1xx.h"
+#include "clock.h"
+
+/* Exported defines */
+/* uncomment this to run the render benchmarks once after the initialization, the results are sent as
+ * text over ITM port 0 (printf port of the debugger). The host build runs them with sim/alarmclock_bench. */
+//#define BENCHMARK
+#define BENCHMARK_ITERATIONS		200		// calls of every workload
+#define BENCHMARK_LINE_LENGTH		96		// maximum length of a result line
+/* the counter of the measurements, the host build replaces it with the time of the host in ns */
+#ifndef BENCHMARK_COUNTER
+#define BENCHMARK_COUNTER			get_cyclecount
+#define BENCHMARK_COUNTER_HZ		SystemCoreClock
+#endif
+/* result format, one csv line per workload after the header line:
+ * benchmark,iterations,min,mean,max,hz
+ * min, mean and max are counter ticks of one call without the measurement overhead, hz is the counter frequency */
+
+/* Exported types */
+typedef struct {
+	char		*name;
+	void		(*run)(uint32_t iteration);		// one call of the workload
+}Benchmark;
+
+/* Exported constants */
+
+/* Exported macro */
+
+/* Exported functions */
+void benchmark_run(Alarmclock *alarmclock_param, void (*output)(const char *line));
+void benchmark_itm_output(const char *line);
+
+#endif
@@ -12,7 +12,6 @@
 #define BUTTON_PLUS				GPIO_PIN_1
 #define BUTTON_MINUS			GPIO_PIN_2
 #define BUTTON_SNOOZE			GPIO_PIN_12
-#define BUTTON_SNOOZE_DOUBLE	0xEFFF	//~GPIO_PIN_12
 #define SWITCH_ALARM			GPIO_PIN_10
 
 /* Exported constants */
@@ -6,6 +6,11 @@
 #include <stdio.h>
 #include "ws2812.h"
 #include "button.h"
+#include "notification.h"
+#include "particle.h"
+#include "digit.h"
+#include "timebase.h"
+#include "alarm.h"
 //#include "lightsensor.h"
 #include "stm32f1xx.h"
 
@@ -18,11 +23,14 @@ typedef enum
 	MODE_TIME_CLOCK,
 	MODE_TIME_SET_CLOCK_h,
 	MODE_TIME_SET_CLOCK_min,
+	MODE_TIME_SET_ALARM_SELECT,
 	MODE_TIME_SET_ALARM_h,
 	MODE_TIME_SET_ALARM_min,
+	MODE_TIME_SET_ALARM_RULE,
 	MODE_TIME_SET_SNOOZE,
 	MODE_TIME_SET_ALARM_STYLE,
-	MODE_TIME_LUX
+	MODE_TIME_LUX,
+	MODE_COUNT
 }Wordclock_Mode;
 
 /*
@@ -47,7 +55,7 @@ typedef enum
 }Alarm_Mode;
 
 /*
-* @brief  enumeration for alarm styles
+* @brief  enumeration for alarm styles, index of the alarm effect in the effect registry
   */
 typedef enum
 {
@@ -55,6 +63,15 @@ typedef enum
 	COLORFALL
 }Alarm_Style;
 
+/*
+* @brief  rule of the alarm rule setup
+  */
+typedef struct {
+	char*				text;
+	uint8_t				weekdays;			// weekday mask of the alarm
+	uint8_t				flags;				// flags of the alarm
+}Alarm_Rule;
+
 /* Exported constants */
 
 /* Exported macro */
@@ -72,7 +89,7 @@ typedef struct {
 	uint8_t				snooze_state;
 	uint8_t				snooze_duration;
 	Alarm_Style			alarm_style;
-	uint16_t			event;
+	Event				event;
 	uint16_t*			ambient_light_factor;
 }Alarmclock;
 
@@ -92,7 +109,9 @@ void RTC_CalendarShow(uint8_t *showtime, uint8_t *showdate);
 void draw_hh_mm(Time_Setup time, Alarmclock *alarmclock_param);
 void alarm_IT(FunctionalState flag);
 void RTC_AlarmEventCallback(Alarmclock *alarmclock_param);
-void increment_mode(Alarmclock *alarmclock_param);
+void RTC_SecondEventCallback(void);
+Wordclock_Mode get_next_mode(Alarmclock *alarmclock_param);
+void restart_setup_blinking(uint32_t phase);
 void increment_clock_color(Alarmclock *alarmclock_param);
 void decrement_clock_color(Alarmclock *alarmclock_param);
 void init_clock(Alarmclock *alarmclock_param);
@@ -100,6 +119,9 @@ void setup_clock_blinking(Alarmclock *alarmclock_param);
 void get_clock_preferences(Alarmclock *alarmclock_param);
 void set_clock_preferences(Alarmclock *alarmclock_param);
 void refresh_clock_display(Alarmclock *alarmclock_param);
+uint8_t clock_tick(Alarmclock *alarmclock_param);
+void clock_request_redraw(void);
+void show_time(Alarmclock *alarmclock_param);
 void draw_mode(Alarmclock *alarmclock_param);
 uint8_t read_alarm_switch(void);
 void draw_lux(Alarmclock *alarmclock_param);
@@ -111,5 +133,14 @@ void show_alarm_style(Alarmclock *alarmclock_param);
 void snooze_plus(Alarmclock *alarmclock_param);
 void snooze_minus(Alarmclock *alarmclock_param);
 void draw_snooze(Alarmclock *alarmclock_param);
+void alarm_select_plus(Alarmclock *alarmclock_param);
+void alarm_select_minus(Alarmclock *alarmclock_param);
+void draw_alarm_select(Alarmclock *alarmclock_param);
+void load_alarm_setup(Alarmclock *alarmclock_param);
+void store_alarm_setup(Alarmclock *alarmclock_param);
+void alarm_rule_plus(Alarmclock *alarmclock_param);
+void alarm_rule_minus(Alarmclock *alarmclock_param);
+void draw_alarm_rule(Alarmclock *alarmclock_param);
+void alarm_select_skip(Alarmclock *alarmclock_param);
 
 #endif
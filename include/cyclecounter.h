@@ -0,0 +1,19 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __CYCLECOUNTER_H
+#define __CYCLECOUNTER_H
+
+/* Includes */
+#include "stm32f1xx.h"
+
+/* Exported defines */
+
+/* Exported constants */
+
+/* Exported macro */
+
+/* Exported functions */
+void init_cyclecounter(void);
+uint32_t get_cyclecount(void);
+uint32_t cycles_to_us(uint32_t cycles);
+
+#endif
@@ -0,0 +1,48 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __DIGIT_H
+#define __DIGIT_H
+
+/* Includes */
+#include "stm32f1xx.h"
+#include "ws2812.h"
+
+/* Exported defines */
+#define DIGIT_BLANK				0		// value of a slot which shows nothing
+
+/* Exported types */
+/*
+* @brief  enumeration digit transitions, index into the transition table
+  */
+typedef enum
+{
+	DIGIT_TRANSITION_NONE,
+	DIGIT_TRANSITION_ROLL,
+	DIGIT_TRANSITION_FADE,
+	DIGIT_TRANSITION_DISSOLVE
+}Digit_Transition;
+
+/*
+* @brief  a digit slot is a number position on the display which changes its value with a transition
+  */
+typedef struct {
+	int16_t				x_offset;
+	int8_t				y_offset;
+	char				value;			// recent number character
+	char				previous;		// number character before the last change
+	Digit_Transition	transition;
+	uint8_t				step;			// step of the running transition
+	uint8_t				animating;		// 1 while the transition is running
+}Digit_Slot;
+
+/* Exported constants */
+
+/* Exported macro */
+
+/* Exported functions */
+void init_digit_slot(Digit_Slot *slot, int16_t x_offset, int8_t y_offset, Digit_Transition transition);
+void digit_slot_set(Digit_Slot *slot, char value);
+void digit_slot_show(Digit_Slot *slot, char value);
+uint8_t digit_slot_animating(Digit_Slot *slot);
+void digit_slot_draw(Digit_Slot *slot, uint8_t *red, uint8_t *green, uint8_t *blue, uint16_t *ambient_factor);
+
+#endif
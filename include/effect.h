@@ -0,0 +1,52 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __EFFECT_H
+#define __EFFECT_H
+
+/* Includes */
+#include "stm32f1xx.h"
+
+/* Exported defines */
+#define EFFECT_REGISTRY_LENGTH		16 		// maximum amount of registered effects, 8 are registered by the firmware
+
+/* Exported types */
+/*
+* @brief  enumeration effect classes, used to look up effects in the registry
+  */
+typedef enum
+{
+	EFFECT_CLASS_SYSTEM,
+	EFFECT_CLASS_ALARM
+}Effect_Class;
+
+typedef struct Effect Effect;
+
+/*
+* @brief  an effect draws one frame per step into the frame buffer, the player sends the frame to the leds
+  */
+struct Effect {
+	char			*name;
+	Effect_Class	effect_class;
+	void			(*init)(Effect *effect);		// called once when the effect is started, optional
+	void			(*step)(Effect *effect);		// draws the frame with the number frame
+	uint8_t			(*done)(Effect *effect);		// returns 1 if the effect is finished
+	uint16_t		frame_period;					// in ms
+	uint16_t		frame;							// frame counter, set by the player
+	void			*data;							// effect specific parameters
+};
+
+/* Exported constants */
+
+/* Exported macro */
+
+/* Exported functions */
+void init_effect(void);
+uint8_t effect_register(Effect *effect);
+uint8_t effect_count(Effect_Class effect_class);
+Effect* effect_get(Effect_Class effect_class, uint8_t index);
+void effect_play(Effect *effect);
+void effect_stop(void);
+uint8_t effect_running(void);
+uint16_t effect_get_frame_period(void);
+uint8_t effect_tick(void);
+
+#endif
@@ -6,15 +6,79 @@
 #include "stm32f1xx.h"
 
 /* Exported defines */
+#define EVENT_COALESCE_RULES		4		// maximum amount of coalescing rules
+#define EVENT_SUBSCRIBERS			8		// maximum amount of subscribers, one bit per subscriber in the subscription table
+
+/* Exported types */
+/*
+* @brief  enumeration event types, the gestures of the buttons and the notifications of the modules
+  */
+typedef enum
+{
+	EVENT_TYPE_NONE,
+	EVENT_TYPE_PRESS,					// button pushed
+	EVENT_TYPE_LONG_PRESS,				// button still pushed after the first debounce period (500 ms)
+	EVENT_TYPE_REPEAT,					// button still pushed, repeated with a shorter period, payload: repeat count
+	EVENT_TYPE_DOUBLE_CLICK,			// button pushed again during the double click window
+	EVENT_TYPE_SWITCH,					// switch changed, payload: 1 if the switch is on
+	EVENT_TYPE_BEEP,					// buzzer toggled, payload: 1 if the buzzer is on
+	EVENT_TYPE_DONE,					// module finished, e.g. the ticker message has been shown completely
+	EVENT_TYPE_COUNT
+}Event_Type;
+
+/*
+* @brief  enumeration event sources
+  */
+typedef enum
+{
+	EVENT_SOURCE_NONE,
+	EVENT_SOURCE_MODE,
+	EVENT_SOURCE_PLUS,
+	EVENT_SOURCE_MINUS,
+	EVENT_SOURCE_SNOOZE,
+	EVENT_SOURCE_SWITCH_ALARM,
+	EVENT_SOURCE_BUZZER,
+	EVENT_SOURCE_TICKER,
+	EVENT_SOURCE_COUNT
+}Event_Source;
+
+typedef struct {
+	uint8_t		type;				// Event_Type
+	uint8_t		source;				// Event_Source
+	uint16_t	payload;			// type specific
+	uint32_t	timestamp;			// HAL tick in ms when the event has been queued
+}Event;
+
+typedef struct {
+	uint32_t	coalesced;			// events which have been merged into a queued event
+	uint32_t	dropped;			// events which have been lost because the queue was full
+	uint8_t		high_watermark;		// most events which have been waiting in the queue
+}Event_Stats;
 
 /* Exported constants */
 
 /* Exported macro */
+/* an event in 32 bit, as it is recorded: type in bits 24..31, source in bits 16..23, payload in bits 0..15 */
+#define EVENT_RECORD(type, source, payload)	(((uint32_t)(type) << 24) | ((uint32_t)(source) << 16) | (uint16_t)(payload))
+#define EVENT_RECORD_TYPE(record)			((uint8_t)((record) >> 24))
+#define EVENT_RECORD_SOURCE(record)			((uint8_t)((record) >> 16))
+#define EVENT_RECORD_PAYLOAD(record)		((uint16_t)(record))
+/* masks of the subscriptions */
+#define EVENT_TYPE_BIT(type)				((uint32_t)1 << (type))
+#define EVENT_SOURCE_BIT(source)			((uint32_t)1 << (source))
+#define EVENT_TYPE_ALL						(EVENT_TYPE_BIT(EVENT_TYPE_COUNT) - 1)
+#define EVENT_SOURCE_ALL					(EVENT_SOURCE_BIT(EVENT_SOURCE_COUNT) - 1)
 
 /* Exported functions */
-uint16_t unqueue_event(void);
-void queue_event(uint16_t GPIO_Pin);
+uint8_t unqueue_event(Event *event);
+uint8_t queue_event(Event_Type type, Event_Source source, uint16_t payload);
 void clear_event_queue(void);
 void init_event_engine(void);
+void event_set_notify(void (*notify)(void));
+uint8_t event_coalesce(Event_Type type, Event_Source source);
+uint8_t event_subscribe(uint32_t type_mask, uint32_t source_mask, void (*handler)(const Event *event));
+void event_dispatch(const Event *event);
+Event_Stats* event_get_stats(void);
+void event_reset_stats(void);
 
 #endif
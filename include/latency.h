@@ -0,0 +1,64 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __LATENCY_H
+#define __LATENCY_H
+
+/* Includes */
+#include "stm32f1xx.h"
+#include "event.h"
+
+/* Exported defines */
+/* the latency of a button is measured from the exti interrupt until the first frame after the event
+ * has been transmitted to the leds. One button is measured at a time, a new button restarts the measurement.
+ * Histogram bin 0 counts latencies below 1 us, bin n counts latencies of 2^(n-1) to 2^n - 1 us,
+ * the last bin counts all latencies above. */
+#define LATENCY_BINS				20		// the last bin starts at ~262 ms
+
+/* Exported types */
+/*
+* @brief  enumeration latency stages, in the order of the path from the button to the leds
+  */
+typedef enum
+{
+	LATENCY_STAGE_EXTI,					// HAL_GPIO_EXTI_Callback
+	LATENCY_STAGE_QUEUED,				// queue_event
+	LATENCY_STAGE_UNQUEUED,				// unqueue_event in the input task
+	LATENCY_STAGE_RENDER,				// render task
+	LATENCY_STAGE_SEND,					// sendbuf_WS2812
+	LATENCY_STAGE_TRANSFER_COMPLETE,	// TransferComplete of the led dma
+	LATENCY_STAGE_COUNT
+}Latency_Stage;
+
+/*
+* @brief  enumeration latency event types, every type has its own histogram
+  */
+typedef enum
+{
+	LATENCY_EVENT_MODE,
+	LATENCY_EVENT_PLUS,
+	LATENCY_EVENT_MINUS,
+	LATENCY_EVENT_SNOOZE,
+	LATENCY_EVENT_SNOOZE_DOUBLE,
+	LATENCY_EVENT_SWITCH_ALARM,
+	LATENCY_EVENT_COUNT
+}Latency_Event;
+
+typedef struct {
+	uint32_t	count;								// measured events
+	uint32_t	max;								// in us
+	uint32_t	stage_sum[LATENCY_STAGE_COUNT];		// in us, time from the previous stage, divide it by count for the average
+	uint16_t	histogram[LATENCY_BINS];			// of the latency from the exti to the transfer complete
+}Latency_Stats;
+
+/* Exported constants */
+
+/* Exported macro */
+
+/* Exported functions */
+void init_latency(void);
+void latency_stamp_event(Latency_Stage stage, Event_Type type, Event_Source source);
+void latency_stamp(Latency_Stage stage);
+Latency_Stats* latency_get_stats(Latency_Event type);
+uint32_t latency_get_dropped(void);
+void latency_reset(void);
+
+#endif
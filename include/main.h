@@ -38,6 +38,63 @@
 #include "buzzer.h"
 #include "lightsensor.h"
 #include "event.h"
+#include "notification.h"
+#include "cyclecounter.h"
+#include "animation.h"
+#include "scheduler.h"
+#include "power.h"
+#include "latency.h"
+#include "profile.h"
+#include "benchmark.h"
+#include "record.h"
+
+/* Exported types */
+/*
+* @brief  enumeration boot stages, the boot profile contains the cycles of every stage
+  */
+typedef enum
+{
+	BOOT_STAGE_HAL,
+	BOOT_STAGE_SYSTEM_CLOCK,
+	BOOT_STAGE_WS2812,
+	BOOT_STAGE_PARTICLE,
+	BOOT_STAGE_BUTTONS,
+	BOOT_STAGE_BUZZER,
+	BOOT_STAGE_LIGHTSENSOR,
+	BOOT_STAGE_ANIMATION,
+	BOOT_STAGE_CLOCK,
+	BOOT_STAGE_EVENT,
+	BOOT_STAGE_NOTIFICATION,
+	BOOT_STAGE_EFFECT,
+	BOOT_STAGE_FIRST_FRAME,
+	BOOT_STAGE_COUNT
+}Boot_Stage;
+
+/*
+* @brief  enumeration mode events, the index of an event in the dispatch table of a mode
+  */
+typedef enum
+{
+	MODE_EVENT_MODE,
+	MODE_EVENT_PLUS,
+	MODE_EVENT_MINUS,
+	MODE_EVENT_SNOOZE,
+	MODE_EVENT_SNOOZE_DOUBLE,
+	MODE_EVENT_SWITCH_ALARM,
+	MODE_EVENT_BUZZER,
+	MODE_EVENT_COUNT,
+	MODE_EVENT_NONE = MODE_EVENT_COUNT		// the event is not handled by any mode
+}Mode_Event;
+
+/*
+* @brief  one state of the mode fsm, all actions are optional
+  */
+typedef struct {
+	void		(*entry)(Alarmclock *alarmclock_param);						// called when the mode is entered
+	void		(*exit)(Alarmclock *alarmclock_param);						// called when the mode is left
+	void		(*tick)(Alarmclock *alarmclock_param);						// called by the render task
+	void		(*event[MODE_EVENT_COUNT])(Alarmclock *alarmclock_param);	// called on the mode event
+}Mode_State;
 
 #endif /* __MAIN_H */
 
@@ -0,0 +1,60 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __NOTIFICATION_H
+#define __NOTIFICATION_H
+
+/* Includes */
+#include "stm32f1xx.h"
+#include "ticker.h"
+
+/* Exported defines */
+#define NOTIFICATION_NO_TIMEOUT			0			// the notification waits until it is shown
+#define NOTIFICATION_TIMEOUT_SHORT		2000		// in ms
+#define NOTIFICATION_TIMEOUT_LONG		10000		// in ms
+
+/* Exported types */
+/*
+* @brief  enumeration notification priorities, a higher priority pre-empts a running notification
+  */
+typedef enum
+{
+	NOTIFICATION_PRIORITY_TOAST,
+	NOTIFICATION_PRIORITY_INFO,
+	NOTIFICATION_PRIORITY_ALARM
+}Notification_Priority;
+
+/*
+* @brief  enumeration notification keys, notifications with the same key are coalesced
+  */
+typedef enum
+{
+	NOTIFICATION_KEY_NONE,
+	NOTIFICATION_KEY_MODE,
+	NOTIFICATION_KEY_COLOR,
+	NOTIFICATION_KEY_ALARM_SWITCH,
+	NOTIFICATION_KEY_SNOOZE,
+	NOTIFICATION_KEY_ALARM
+}Notification_Key;
+
+typedef struct {
+	char					*string;
+	Notification_Priority	priority;
+	Notification_Key		key;
+	uint32_t				post_tick;
+	uint32_t				timeout;
+	uint16_t				order;
+	uint8_t					used;
+}Notification;
+
+/* Exported constants */
+
+/* Exported macro */
+
+/* Exported functions */
+void init_notification(uint8_t *red, uint8_t *green, uint8_t *blue, uint16_t *ambient_factor);
+void notification_post(char *string, Notification_Priority priority, Notification_Key key, uint32_t timeout);
+void notification_cancel(Notification_Key key);
+void notification_clear(void);
+uint8_t notification_busy(void);
+uint8_t notification_tick(void);
+
+#endif
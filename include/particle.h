@@ -0,0 +1,80 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __PARTICLE_H
+#define __PARTICLE_H
+
+/* Includes */
+#include "stm32f1xx.h"
+#include "ws2812.h"
+#include "effect.h"
+
+/* Exported defines */
+#define PARTICLE_POOL_SIZE			32		// maximum amount of live particles
+#define PARTICLE_SUBPIXEL_SHIFT		4		// positions and velocities are in 1/16 pixel
+/* cycle budget per frame at 72 MHz, estimated from the generated code:
+ * - update of a live particle		~40 cycles
+ * - spawn of a particle			~60 cycles
+ * - draw of a live particle		~300 cycles (WS2812_framedata_setPixel)
+ * a full pool costs ~12000 cycles (~170 us) per frame, which is below 1% of the 50 ms clock refresh period
+ * and allows the particles to run behind the clock at full rate. Dead particles cost nothing. */
+#define PARTICLE_CYCLE_BUDGET		12000
+
+/* Exported types */
+/*
+* @brief  enumeration particle styles
+  */
+typedef enum
+{
+	PARTICLE_STYLE_NONE,
+	PARTICLE_STYLE_RAIN,
+	PARTICLE_STYLE_SNOW,
+	PARTICLE_STYLE_SPARKS
+}Particle_Style;
+
+/*
+* @brief  enumeration particle origins
+  */
+typedef enum
+{
+	PARTICLE_ORIGIN_TOP,			// random column in the top row
+	PARTICLE_ORIGIN_ANYWHERE		// random pixel on the display
+}Particle_Origin;
+
+typedef struct {
+	int16_t		x;					// in 1/16 pixel
+	int16_t		y;					// in 1/16 pixel
+	int8_t		vx;					// in 1/16 pixel per frame
+	int8_t		vy;					// in 1/16 pixel per frame
+	uint8_t		life;				// remaining frames
+	uint8_t		next;				// index of the next particle in the live or free list
+}Particle;
+
+typedef struct {
+	Particle_Origin	origin;
+	uint8_t		spawn_chance;		// chance to spawn particles per frame, 0..255
+	uint8_t		spawn_count;		// particles per spawn
+	int8_t		vx_min;
+	uint8_t		vx_range;
+	int8_t		vy_min;
+	uint8_t		vy_range;
+	int8_t		gravity;			// added to vy every frame
+	uint8_t		life;				// in frames
+	uint8_t		fade;				// 1 if the particle fades out with its life
+	uint8_t		red;
+	uint8_t		green;
+	uint8_t		blue;
+}Particle_Preset;
+
+/* Exported constants */
+
+/* Exported macro */
+
+/* Exported functions */
+void init_particle(void);
+void particle_start(Particle_Style style);
+void particle_stop(void);
+Particle_Style particle_get_style(void);
+void particle_tick(void);
+void particle_draw(void);
+uint32_t particle_random(void);
+
+#endif
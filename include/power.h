@@ -0,0 +1,34 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __POWER_H
+#define __POWER_H
+
+/* Includes */
+#include "stm32f1xx_hal.h"
+
+/* Exported defines */
+/* the idle mode is the sleep mode (wfi), all interrupts wake the core up: buttons and switch (exti),
+ * rtc second and alarm, the led transmission, buzzer and snooze timers. The stop mode is not used
+ * because it stops the pll and with it the led transmission and the timers. */
+#define POWER_MAX_IDLE				200		// in ms, limited by the 24 bit systick at 72 MHz
+#define POWER_STATS_WINDOW			1000	// in ms
+
+/* Exported types */
+typedef struct {
+	uint8_t		duty;				// awake time of the last window in percent
+	uint32_t	wakeups;			// wakeups of the last window
+	uint32_t	idle;				// in ms, idle time of the recent window
+	uint32_t	window_wakeups;		// wakeups of the recent window
+	uint32_t	window_start;		// hal tick
+}Power_Stats;
+
+/* Exported constants */
+
+/* Exported macro */
+
+/* Exported functions */
+void init_power(void);
+void power_idle(uint32_t wait);
+void power_wakeup(void);
+Power_Stats* power_get_stats(void);
+
+#endif
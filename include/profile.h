@@ -0,0 +1,79 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __PROFILE_H
+#define __PROFILE_H
+
+/* Includes */
+#include "stm32f1xx.h"
+
+/* Exported defines */
+/* uncomment this to profile the scopes, every scope costs ~30 cycles per call */
+//#define PROFILE
+#define PROFILE_ITM_PORT			1		// stimulus port of the records, has to be enabled by the debugger
+#define PROFILE_REPORT_PERIOD		1000	// in ms, at most ~59 s at 72 MHz
+#define PROFILE_NAME_PERIOD			10		// the scope names are sent with every 10th report
+/* record format, all values are little endian, the records are decoded by tools/profile_decode.py:
+ * report:	PROFILE_RECORD_SYNC, PROFILE_RECORD_REPORT, scope count, core clock in MHz, window cycles (u32)
+ * name:	PROFILE_RECORD_SYNC, PROFILE_RECORD_NAME, scope, length, characters
+ * scope:	PROFILE_RECORD_SYNC, PROFILE_RECORD_SCOPE, scope, calls (u32), min, max and total cycles (u32)
+ * a report is followed by the scopes which have been called in the window, the window starts with the
+ * previous report. The cycles of a scope include the interrupts which ran during the scope. */
+#define PROFILE_RECORD_SYNC			0xA5
+#define PROFILE_RECORD_REPORT		0x01
+#define PROFILE_RECORD_NAME			0x02
+#define PROFILE_RECORD_SCOPE		0x03
+
+/* Exported types */
+/*
+* @brief  enumeration profiling scopes
+  */
+typedef enum
+{
+	PROFILE_SCOPE_SETPIXEL,
+	PROFILE_SCOPE_CLEAR_BUFFER,
+	PROFILE_SCOPE_DRAW_TIME,
+	PROFILE_SCOPE_DRAW_STRING,			// draw_string_frame, draw_string itself waits for the scrolling
+	PROFILE_SCOPE_SENDBUF,
+	PROFILE_SCOPE_ADC_CONV_CPLT,
+	PROFILE_SCOPE_SYSTICK_IRQ,
+	PROFILE_SCOPE_EXTI0_IRQ,
+	PROFILE_SCOPE_EXTI1_IRQ,
+	PROFILE_SCOPE_EXTI2_IRQ,
+	PROFILE_SCOPE_EXTI15_10_IRQ,
+	PROFILE_SCOPE_TIM1_IRQ,
+	PROFILE_SCOPE_TIM2_IRQ,
+	PROFILE_SCOPE_TIM3_IRQ,
+	PROFILE_SCOPE_TIM4_IRQ,
+	PROFILE_SCOPE_RTC_ALARM_IRQ,
+	PROFILE_SCOPE_RTC_IRQ,
+	PROFILE_SCOPE_ADC_IRQ,
+	PROFILE_SCOPE_DMA1_CH1_IRQ,
+	PROFILE_SCOPE_DMA1_CH7_IRQ,
+	PROFILE_SCOPE_COUNT
+}Profile_Scope;
+
+typedef struct {
+	uint32_t	calls;
+	uint32_t	min;			// in cycles
+	uint32_t	max;			// in cycles
+	uint32_t	total;			// in cycles
+	uint32_t	start;			// cycle counter at the begin of the recent call
+}Profile_Stats;
+
+/* Exported constants */
+
+/* Exported macro */
+#ifdef PROFILE
+#define PROFILE_BEGIN(scope)		profile_begin(scope)
+#define PROFILE_END(scope)			profile_end(scope)
+#else
+#define PROFILE_BEGIN(scope)
+#define PROFILE_END(scope)
+#endif
+
+/* Exported functions */
+void init_profile(void);
+void profile_begin(Profile_Scope scope);
+void profile_end(Profile_Scope scope);
+void profile_report(void);
+
+#endif
@@ -0,0 +1,68 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __RECORD_H
+#define __RECORD_H
+
+/* Includes */
+#include "stm32f1xx.h"
+#include "clock.h"
+
+/* Exported defines */
+/* uncomment this to record the inputs and the transmitted frames, the records are sent over RECORD_ITM_PORT */
+//#define RECORD
+/* uncomment this to replay record_scenario (record_scenario.c) on the target after the boot */
+//#define RECORD_REPLAY
+#define RECORD_ITM_PORT				2		// stimulus port of the records, has to be enabled by the debugger
+#define RECORD_BUFFER_LENGTH		64		// records which wait for the flush
+#define RECORD_FLUSH_PERIOD			100		// in ms
+#define RECORD_REPLAY_PERIOD		10		// in ms, resolution of the replay on the target
+#define RECORD_PIN_LEVEL			0x8000	// set in the value of a pin record if the pin was high
+/* record format, all values are little endian, the records are decoded by tools/record_decode.py:
+ * RECORD_SYNC, type, HAL tick in ms (u32), value (u32)
+ * the values of the types are listed in Record_Type. The host simulation replays the pin, adc, rtc and
+ * alarm records, the target replays the event, adc, rtc and alarm records. */
+#define RECORD_SYNC					0x5A
+
+/* Exported types */
+/*
+* @brief  enumeration record types
+  */
+typedef enum
+{
+	RECORD_TYPE_PIN,			// button pin, RECORD_PIN_LEVEL if it was high. Recorded by the exti interrupt and
+								// by the debounce timer when it sees the release, which is up to 500 ms late
+	RECORD_TYPE_EVENT,			// queued event, packed with EVENT_RECORD (event.h), the timestamp is the record time
+	RECORD_TYPE_RTC,			// rtc counter after a second
+	RECORD_TYPE_ALARM,			// rtc counter of the alarm
+	RECORD_TYPE_ADC,			// light sensor sample, recorded if it differs from the previous one
+	RECORD_TYPE_FRAME,			// transmitted frame, the value is 0
+	RECORD_TYPE_COUNT
+}Record_Type;
+
+typedef struct {
+	uint32_t	ms;
+	uint8_t		type;
+	uint32_t	value;
+}Record_Entry;
+
+/* Exported constants */
+extern const Record_Entry record_scenario[];
+extern const uint16_t record_scenario_length;
+
+/* Exported macro */
+#ifdef RECORD
+#define RECORD_INPUT(type, value)	record_input(type, value)
+#else
+#define RECORD_INPUT(type, value)
+#endif
+
+/* Exported functions */
+void init_record(void);
+void record_input(Record_Type type, uint32_t value);
+void record_flush(void);
+uint32_t record_get_dropped(void);
+void record_replay_start(const Record_Entry *entries, uint16_t count, Alarmclock *alarmclock_param);
+uint8_t record_replay_tick(void);
+void record_replay_entry(const Record_Entry *entry);
+uint16_t record_replay_adc(uint16_t sample);
+
+#endif
@@ -0,0 +1,47 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __SCHEDULER_H
+#define __SCHEDULER_H
+
+/* Includes */
+#include "stm32f1xx.h"
+#include "cyclecounter.h"
+
+/* Exported defines */
+#define SCHEDULER_TASKS				8		// maximum amount of tasks
+#define SCHEDULER_IDLE				0xFFFFFFFF	// no task is waiting
+
+/* Exported types */
+typedef struct Task Task;
+
+/*
+* @brief  a task runs to completion, periodic tasks are released every period, one shot tasks once
+  */
+struct Task {
+	char			*name;
+	void			(*run)(void);
+	uint16_t		period;				// in ms, 0 for a one shot task
+	uint16_t		budget;				// in us, a longer run is an overrun
+	volatile uint32_t	release;		// hal tick of the next release, written by interrupts which start the task
+	volatile uint8_t	active;
+	/* statistics, read them with the debugger */
+	uint32_t		runs;
+	uint32_t		overruns;			// runs longer than the budget
+	uint32_t		deadline_misses;	// runs which started after the next release, the missed releases are skipped
+	uint32_t		max_latency;		// in ms, from the release to the start
+	uint32_t		max_cycles;			// longest run
+	uint32_t		last_cycles;
+};
+
+/* Exported constants */
+
+/* Exported macro */
+
+/* Exported functions */
+void init_scheduler(void (*overrun_callback)(Task *task));
+uint8_t scheduler_add(Task *task);
+void scheduler_start(Task *task, uint32_t delay);
+void scheduler_stop(Task *task);
+void scheduler_set_period(Task *task, uint16_t period);
+uint32_t scheduler_run(void);
+
+#endif
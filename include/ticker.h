@@ -0,0 +1,35 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __TICKER_H
+#define __TICKER_H
+
+/* Includes */
+#include "stm32f1xx.h"
+#include "ws2812.h"
+#include "event.h"
+
+/* Exported defines */
+
+/* Exported types */
+/*
+* @brief  enumeration ticker states
+  */
+typedef enum
+{
+	TICKER_IDLE,
+	TICKER_HOLD_START,
+	TICKER_SCROLL,
+	TICKER_HOLD_END
+}Ticker_State;
+
+/* Exported constants */
+
+/* Exported macro */
+
+/* Exported functions */
+void init_ticker(void);
+void ticker_start(char *string, uint8_t *red, uint8_t *green, uint8_t *blue, uint16_t *ambient_factor);
+void ticker_stop(void);
+uint8_t ticker_busy(void);
+uint8_t ticker_tick(void);
+
+#endif
@@ -0,0 +1,32 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __TIMEBASE_H
+#define __TIMEBASE_H
+
+/* Includes */
+#include "stm32f1xx.h"
+
+/* Exported defines */
+/* the rtc counter holds the seconds since the epoch 1.1.2000 00:00:00, the calendar is calculated from it */
+#define TIMEBASE_EPOCH_WEEKDAY		RTC_WEEKDAY_SATURDAY	// weekday of the epoch
+#define TIMEBASE_SECONDS_PER_DAY	86400U
+
+/* Exported types */
+
+/* Exported constants */
+
+/* Exported macro */
+
+/* Exported functions */
+void init_timebase(void);
+uint32_t timebase_read(void);
+void timebase_write(uint32_t seconds);
+void timebase_second(void);
+uint32_t timebase_now(void);
+void timebase_get_time(uint32_t seconds, RTC_TimeTypeDef *time);
+void timebase_get_date(uint32_t seconds, RTC_DateTypeDef *date);
+void timebase_set_time(RTC_TimeTypeDef *time);
+uint32_t timebase_from_calendar(RTC_DateTypeDef *date, RTC_TimeTypeDef *time);
+uint32_t timebase_next(uint32_t seconds, RTC_TimeTypeDef *time);
+void timebase_set_alarm(uint32_t seconds);
+
+#endif
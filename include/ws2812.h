@@ -4,12 +4,15 @@
 
 /* Includes */
 #include "stm32f1xx.h"
+#include "effect.h"
 
 /* Exported constants */
 /* amount of rows */
 #define ROW 7
 /* amount of columns */
 #define COL 17
+/* amount of hues of the color wheel */
+#define WS2812_HUE_STEPS 765
 
 /* Exported macro */
 
@@ -32,6 +35,7 @@ void DMA_SetConfiguration(DMA_HandleTypeDef *hdma, uint32_t SrcAddress, uint32_t
 void TransferComplete(DMA_HandleTypeDef *DmaHandle);
 void TransferError(DMA_HandleTypeDef *DmaHandle);
 void sendbuf_WS2812(void);
+void WS2812_wait_transmission(void);
 void WS2812_configuration(uint8_t row, uint16_t column);
 void init_gpio(void);
 void init_timer(void);
@@ -40,19 +44,21 @@ void init_font(void);
 Letter char_to_letter(char charistic);
 void WS2812_color_wheel_plus(uint8_t *red, uint8_t *green, uint8_t *blue);
 void WS2812_color_wheel_minus(uint8_t *red, uint8_t *green, uint8_t *blue);
+void WS2812_hue_to_rgb(uint16_t hue, uint8_t *red, uint8_t *green, uint8_t *blue);
+uint16_t WS2812_hue_add(uint16_t hue, uint16_t step);
 void WS2812_led_test(void);
 void WS2812_set_line(int8_t row_start, int16_t column_start, int8_t row_end, int16_t column_end, uint8_t red, uint8_t green, uint8_t blue);
 void WS2812_clear_buffer(void);
 void WS2812_background_matrix(void);
 void WS2812_TIM2_callback(void);
 void WS2812_foreground_colour(uint8_t red, uint8_t green, uint8_t blue);
-uint8_t WS2812_display_flash(uint32_t speed_ms, uint8_t flash_count);
 void draw_letter(char character, int16_t x_offset, int8_t y_offset, uint8_t *red, uint8_t *green, uint8_t *blue, uint16_t *ambient_factor);
 void draw_number(char character, int16_t x_offset, int8_t y_offset, uint8_t *red, uint8_t *green, uint8_t *blue, uint16_t *ambient_factor);
-void draw_string(char *string, int16_t x_offset, int8_t y_offset, uint8_t *red, uint8_t *green, uint8_t *blue, uint16_t *ambient_factor);
+void draw_digit(uint8_t digit, int16_t x_offset, int8_t y_offset, uint8_t *red, uint8_t *green, uint8_t *blue, uint16_t *ambient_factor);
+void draw_string_frame(char *string, int16_t x_offset, int8_t y_offset, uint8_t *red, uint8_t *green, uint8_t *blue, uint16_t *ambient_factor);
+int16_t get_string_scroll_end(char *string);
 Letter char_to_letter(char charistic);
 Number char_to_number(char charistic);
-uint8_t WS2812_display_colorfall(void);
-void WS2812_stop_animation(void);
+void WS2812_colorfall_frame(uint16_t frame);
 
 #endif
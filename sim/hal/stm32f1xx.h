@@ -0,0 +1,148 @@
+/*
+ * Host simulation shim for the STM32F1 device header.
+ */
+#ifndef __STM32F1XX_H
+#define __STM32F1XX_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define SIMULATION
+
+#define __IO	volatile
+#define __I		volatile const
+#define __O		volatile
+
+typedef enum { RESET = 0, SET = !RESET } FlagStatus, ITStatus;
+typedef enum { DISABLE = 0, ENABLE = !DISABLE } FunctionalState;
+typedef enum { SUCCESS = 0U, ERROR = !SUCCESS } ErrorStatus;
+
+typedef enum {
+	NonMaskableInt_IRQn = -14, SysTick_IRQn = -1,
+	RTC_IRQn = 3, EXTI0_IRQn = 6, EXTI1_IRQn = 7, EXTI2_IRQn = 8,
+	DMA1_Channel1_IRQn = 11, DMA1_Channel7_IRQn = 17, ADC1_2_IRQn = 18,
+	TIM1_UP_IRQn = 25, TIM2_IRQn = 28, TIM3_IRQn = 29, TIM4_IRQn = 30,
+	EXTI15_10_IRQn = 40, RTC_Alarm_IRQn = 41
+} IRQn_Type;
+
+typedef struct { __IO uint32_t CRL, CRH, IDR, ODR, BSRR, BRR, LCKR; } GPIO_TypeDef;
+typedef struct { __IO uint32_t CCR, CNDTR, CPAR, CMAR; } DMA_Channel_TypeDef;
+typedef struct { __IO uint32_t ISR, IFCR; } DMA_TypeDef;
+typedef struct { __IO uint32_t CR1, CR2, SMCR, DIER, SR, EGR, CCMR1, CCMR2, CCER, CNT, PSC, ARR, RCR, CCR1, CCR2, CCR3, CCR4, BDTR, DCR, DMAR; } TIM_TypeDef;
+typedef struct { __IO uint32_t CRH, CRL, PRLH, PRLL, DIVH, DIVL, CNTH, CNTL, ALRH, ALRL; } RTC_TypeDef;
+typedef struct { __IO uint32_t SR, CR1, CR2, SMPR1, SMPR2, JOFR[4], HTR, LTR, SQR1, SQR2, SQR3, JSQR, JDR[4], DR; } ADC_TypeDef;
+typedef struct { __IO uint32_t IMR, EMR, RTSR, FTSR, SWIER, PR; } EXTI_TypeDef;
+typedef struct { __IO uint32_t CR, CSR; } PWR_TypeDef;
+typedef struct { __IO uint32_t CTRL, CYCCNT, CPICNT, EXCCNT, SLEEPCNT, LSUCNT, FOLDCNT, PCSR; } DWT_Type;
+typedef struct { __IO uint32_t DHCSR, DCRSR, DCRDR, DEMCR; } CoreDebug_Type;
+typedef union { __O uint8_t u8; __O uint16_t u16; __O uint32_t u32; } ITM_Port_Type;
+typedef struct { ITM_Port_Type PORT[32]; __IO uint32_t TER, TPR, TCR, LAR; } ITM_Type;
+typedef struct { __IO uint32_t CTRL, LOAD, VAL, CALIB; } SysTick_Type;
+typedef struct { __IO uint32_t CPUID, ICSR, VTOR, AIRCR, SCR, CCR; } SCB_Type;
+
+extern GPIO_TypeDef			sim_GPIOA, sim_GPIOB;
+extern DMA_Channel_TypeDef	sim_DMA1_Channel[8];
+extern DMA_TypeDef			sim_DMA1;
+extern TIM_TypeDef			sim_TIM1, sim_TIM2, sim_TIM3, sim_TIM4;
+extern RTC_TypeDef			sim_RTC;
+extern ADC_TypeDef			sim_ADC1;
+extern EXTI_TypeDef			sim_EXTI;
+extern PWR_TypeDef			sim_PWR;
+extern DWT_Type				sim_DWT;
+extern CoreDebug_Type		sim_CoreDebug;
+extern ITM_Type				sim_ITM;
+extern SysTick_Type			sim_SysTick;
+extern SCB_Type				sim_SCB;
+extern uint32_t				sim_BKP[43];
+extern uint32_t				SystemCoreClock;
+uint32_t					sim_host_ns(void);
+
+#define GPIOA				(&sim_GPIOA)
+#define GPIOB				(&sim_GPIOB)
+#define DMA1				(&sim_DMA1)
+#define DMA1_Channel1		(&sim_DMA1_Channel[1])
+#define DMA1_Channel2		(&sim_DMA1_Channel[2])
+#define DMA1_Channel5		(&sim_DMA1_Channel[5])
+#define DMA1_Channel7		(&sim_DMA1_Channel[7])
+#define TIM1				(&sim_TIM1)
+#define TIM2				(&sim_TIM2)
+#define TIM3				(&sim_TIM3)
+#define TIM4				(&sim_TIM4)
+#define RTC					(&sim_RTC)
+#define ADC1				(&sim_ADC1)
+#define EXTI				(&sim_EXTI)
+#define PWR					(&sim_PWR)
+#define DWT					(&sim_DWT)
+#define CoreDebug			(&sim_CoreDebug)
+#define ITM					(&sim_ITM)
+#define ITM_TCR_ITMENA_Msk	(1UL)
+#define SysTick				(&sim_SysTick)
+#define SCB					(&sim_SCB)
+#define BKP_BASE			((uint32_t)(uintptr_t)sim_BKP)
+#define BKP_DR1_D			0x0000FFFFU
+
+/* GPIO pins */
+#define GPIO_PIN_0			((uint16_t)0x0001)
+#define GPIO_PIN_1			((uint16_t)0x0002)
+#define GPIO_PIN_2			((uint16_t)0x0004)
+#define GPIO_PIN_3			((uint16_t)0x0008)
+#define GPIO_PIN_4			((uint16_t)0x0010)
+#define GPIO_PIN_5			((uint16_t)0x0020)
+#define GPIO_PIN_6			((uint16_t)0x0040)
+#define GPIO_PIN_7			((uint16_t)0x0080)
+#define GPIO_PIN_8			((uint16_t)0x0100)
+#define GPIO_PIN_9			((uint16_t)0x0200)
+#define GPIO_PIN_10			((uint16_t)0x0400)
+#define GPIO_PIN_11			((uint16_t)0x0800)
+#define GPIO_PIN_12			((uint16_t)0x1000)
+#define GPIO_PIN_13			((uint16_t)0x2000)
+#define GPIO_PIN_14			((uint16_t)0x4000)
+#define GPIO_PIN_15			((uint16_t)0x8000)
+
+/* register bits */
+#define TIM_CR1_CEN			0x0001U
+#define TIM_CR1_ARPE		0x0080U
+#define TIM_DIER_UIE		0x0001U
+#define DMA_ISR_GIF1		0x0001U
+#define DMA_CCR_EN			0x0001U
+#define RTC_CRL_SECF		0x0001U
+#define RTC_CRL_ALRF		0x0002U
+#define RTC_CRL_OWF			0x0004U
+#define RTC_CRL_RSF			0x0008U
+#define RTC_CRL_CNF			0x0010U
+#define RTC_CRL_RTOFF		0x0020U
+#define RTC_CRH_SECIE		0x0001U
+#define RTC_CRH_ALRIE		0x0002U
+#define RTC_CRH_OWIE		0x0004U
+#define DWT_CTRL_CYCCNTENA_Msk			0x00000001U
+#define CoreDebug_DEMCR_TRCENA_Msk		0x01000000U
+#define SysTick_CTRL_ENABLE_Msk			0x00000001U
+#define SysTick_CTRL_TICKINT_Msk		0x00000002U
+#define SysTick_CTRL_CLKSOURCE_Msk		0x00000004U
+#define SysTick_CTRL_COUNTFLAG_Msk		0x00010000U
+#define SysTick_LOAD_RELOAD_Msk			0x00FFFFFFU
+#define SCB_SCR_SLEEPDEEP_Msk			0x00000004U
+#define SCB_SCR_SLEEPONEXIT_Msk			0x00000002U
+
+/* CMSIS core intrinsics */
+void		__disable_irq(void);
+void		__enable_irq(void);
+uint32_t	__get_PRIMASK(void);
+void		__set_PRIMASK(uint32_t primask);
+void		__WFI(void);
+void		__WFE(void);
+void		__SEV(void);
+void		__DMB(void);
+void		__DSB(void);
+void		__ISB(void);
+void		__NOP(void);
+void		__CLREX(void);
+uint32_t	__LDREXW(volatile uint32_t *addr);
+uint32_t	__STREXW(uint32_t value, volatile uint32_t *addr);
+uint32_t	ITM_SendChar(uint32_t ch);
+void		NVIC_SystemReset(void);
+
+#include "stm32f1xx_hal.h"
+
+#endif
@@ -0,0 +1,294 @@
+/*
+ * Host simulation shim for the STM32F1 HAL. Only the parts used by the
+ * alarmclock firmware are provided.
+ */
+#ifndef __STM32F1XX_HAL_H
+#define __STM32F1XX_HAL_H
+
+#include "stm32f1xx.h"
+
+typedef enum { HAL_OK = 0x00U, HAL_ERROR = 0x01U, HAL_BUSY = 0x02U, HAL_TIMEOUT = 0x03U } HAL_StatusTypeDef;
+typedef enum { HAL_UNLOCKED = 0x00U, HAL_LOCKED = 0x01U } HAL_LockTypeDef;
+typedef enum { GPIO_PIN_RESET = 0U, GPIO_PIN_SET } GPIO_PinState;
+
+extern __IO uint32_t uwTick;
+
+/* GPIO */
+typedef struct { uint32_t Pin, Mode, Pull, Speed; } GPIO_InitTypeDef;
+#define GPIO_MODE_INPUT					0x00000000U
+#define GPIO_MODE_OUTPUT_PP				0x00000001U
+#define GPIO_MODE_ANALOG				0x00000003U
+#define GPIO_MODE_IT_RISING				0x10110000U
+#define GPIO_MODE_IT_FALLING			0x10210000U
+#define GPIO_MODE_IT_RISING_FALLING		0x10310000U
+#define GPIO_NOPULL						0x00000000U
+#define GPIO_PULLUP						0x00000001U
+#define GPIO_SPEED_FREQ_LOW				0x00000002U
+#define GPIO_SPEED_FREQ_MEDIUM			0x00000001U
+#define GPIO_SPEED_FREQ_HIGH			0x00000003U
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin);
+#define __HAL_GPIO_EXTI_GET_IT(__EXTI_LINE__)		(EXTI->PR & (__EXTI_LINE__))
+#define __HAL_GPIO_EXTI_CLEAR_IT(__EXTI_LINE__)		(EXTI->PR &= ~(uint32_t)(__EXTI_LINE__))
+
+/* RCC */
+typedef struct { uint32_t PLLState, PLLSource, PLLMUL; } RCC_PLLInitTypeDef;
+typedef struct { uint32_t OscillatorType, HSEState, HSEPredivValue, LSEState, HSIState, HSICalibrationValue, LSIState; RCC_PLLInitTypeDef PLL; } RCC_OscInitTypeDef;
+typedef struct { uint32_t ClockType, SYSCLKSource, AHBCLKDivider, APB1CLKDivider, APB2CLKDivider; } RCC_ClkInitTypeDef;
+typedef struct { uint32_t PeriphClockSelection, RTCClockSelection, AdcClockSelection; } RCC_PeriphCLKInitTypeDef;
+#define RCC_OSCILLATORTYPE_HSE			0x00000001U
+#define RCC_OSCILLATORTYPE_LSE			0x00000004U
+#define RCC_HSE_ON						0x00010000U
+#define RCC_HSE_PREDIV_DIV1				0x00000000U
+#define RCC_LSE_ON						0x00000001U
+#define RCC_PLL_NONE					0x00000000U
+#define RCC_PLL_ON						0x00000002U
+#define RCC_PLLSOURCE_HSE				0x00010000U
+#define RCC_PLL_MUL9					0x001C0000U
+#define RCC_CLOCKTYPE_SYSCLK			0x00000001U
+#define RCC_CLOCKTYPE_HCLK				0x00000002U
+#define RCC_CLOCKTYPE_PCLK1				0x00000004U
+#define RCC_CLOCKTYPE_PCLK2				0x00000008U
+#define RCC_SYSCLKSOURCE_PLLCLK			0x00000002U
+#define RCC_SYSCLK_DIV1					0x00000000U
+#define RCC_HCLK_DIV1					0x00000000U
+#define RCC_HCLK_DIV2					0x00000400U
+#define RCC_PERIPHCLK_RTC				0x00000001U
+#define RCC_PERIPHCLK_ADC				0x00000002U
+#define RCC_RTCCLKSOURCE_LSE			0x00000100U
+#define RCC_CFGR_ADCPRE_DIV8			0x0000C000U
+#define FLASH_LATENCY_2					0x00000002U
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef *RCC_OscInitStruct);
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef *RCC_ClkInitStruct, uint32_t FLatency);
+HAL_StatusTypeDef HAL_RCCEx_PeriphCLKConfig(RCC_PeriphCLKInitTypeDef *PeriphClkInit);
+uint32_t HAL_RCC_GetHCLKFreq(void);
+#define __HAL_RCC_GPIOA_CLK_ENABLE()	do{}while(0)
+#define __HAL_RCC_GPIOB_CLK_ENABLE()	do{}while(0)
+#define __HAL_RCC_DMA1_CLK_ENABLE()		do{}while(0)
+#define __HAL_RCC_TIM1_CLK_ENABLE()		do{}while(0)
+#define __HAL_RCC_TIM2_CLK_ENABLE()		do{}while(0)
+#define __HAL_RCC_TIM3_CLK_ENABLE()		do{}while(0)
+#define __HAL_RCC_TIM4_CLK_ENABLE()		do{}while(0)
+#define __HAL_RCC_ADC1_CLK_ENABLE()		do{}while(0)
+#define __HAL_RCC_PWR_CLK_ENABLE()		do{}while(0)
+#define __HAL_RCC_BKP_CLK_ENABLE()		do{}while(0)
+#define __HAL_RCC_RTC_ENABLE()			do{}while(0)
+#define __HAL_RCC_CLEAR_RESET_FLAGS()	do{}while(0)
+#define __HAL_RCC_BACKUPRESET_FORCE()	do{}while(0)
+#define __HAL_RCC_BACKUPRESET_RELEASE()	do{}while(0)
+
+/* PWR */
+#define PWR_MAINREGULATOR_ON			0x00000000U
+#define PWR_LOWPOWERREGULATOR_ON		0x00000001U
+#define PWR_SLEEPENTRY_WFI				((uint8_t)0x01)
+#define PWR_STOPENTRY_WFI				((uint8_t)0x01)
+void HAL_PWR_EnableBkUpAccess(void);
+void HAL_PWR_EnterSLEEPMode(uint32_t Regulator, uint8_t SLEEPEntry);
+void HAL_PWR_EnterSTOPMode(uint32_t Regulator, uint8_t STOPEntry);
+
+/* Cortex */
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority);
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn);
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn);
+void HAL_NVIC_ClearPendingIRQ(IRQn_Type IRQn);
+
+/* general */
+HAL_StatusTypeDef HAL_Init(void);
+void HAL_IncTick(void);
+void HAL_Delay(uint32_t Delay);
+uint32_t HAL_GetTick(void);
+void HAL_SetTick(uint32_t tick);
+void HAL_SuspendTick(void);
+void HAL_ResumeTick(void);
+
+/* DMA */
+typedef struct { uint32_t Direction, PeriphInc, MemInc, PeriphDataAlignment, MemDataAlignment, Mode, Priority; } DMA_InitTypeDef;
+typedef enum { HAL_DMA_XFER_CPLT_CB_ID = 0x00U, HAL_DMA_XFER_HALFCPLT_CB_ID, HAL_DMA_XFER_ERROR_CB_ID, HAL_DMA_XFER_ABORT_CB_ID, HAL_DMA_XFER_ALL_CB_ID } HAL_DMA_CallbackIDTypeDef;
+typedef struct __DMA_HandleTypeDef {
+	DMA_Channel_TypeDef		*Instance;
+	DMA_InitTypeDef			Init;
+	HAL_LockTypeDef			Lock;
+	void					*Parent;
+	void					(*XferCpltCallback)(struct __DMA_HandleTypeDef *hdma);
+	void					(*XferHalfCpltCallback)(struct __DMA_HandleTypeDef *hdma);
+	void					(*XferErrorCallback)(struct __DMA_HandleTypeDef *hdma);
+	void					(*XferAbortCallback)(struct __DMA_HandleTypeDef *hdma);
+	__IO uint32_t			ErrorCode;
+	DMA_TypeDef				*DmaBaseAddress;
+	uint32_t				ChannelIndex;
+} DMA_HandleTypeDef;
+#define DMA_MEMORY_TO_PERIPH			0x00000010U
+#define DMA_PERIPH_TO_MEMORY			0x00000000U
+#define DMA_PINC_DISABLE				0x00000000U
+#define DMA_MINC_ENABLE					0x00000080U
+#define DMA_MINC_DISABLE				0x00000000U
+#define DMA_PDATAALIGN_HALFWORD			0x00000100U
+#define DMA_MDATAALIGN_HALFWORD			0x00000400U
+#define DMA_NORMAL						0x00000000U
+#define DMA_CIRCULAR					0x00000020U
+#define DMA_PRIORITY_HIGH				0x00002000U
+#define DMA_IT_TC						0x00000002U
+#define DMA_IT_HT						0x00000004U
+#define DMA_IT_TE						0x00000008U
+#define DMA_FLAG_GL2					0x00000010U
+#define DMA_FLAG_TC2					0x00000020U
+#define DMA_FLAG_HT2					0x00000040U
+#define DMA_FLAG_TE2					0x00000080U
+#define DMA_FLAG_GL5					0x00010000U
+#define DMA_FLAG_TC5					0x00020000U
+#define DMA_FLAG_HT5					0x00040000U
+#define DMA_FLAG_TE5					0x00080000U
+#define DMA_FLAG_GL7					0x01000000U
+#define DMA_FLAG_TC7					0x02000000U
+#define DMA_FLAG_HT7					0x04000000U
+#define DMA_FLAG_TE7					0x08000000U
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *hdma);
+HAL_StatusTypeDef HAL_DMA_DeInit(DMA_HandleTypeDef *hdma);
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef *hdma);
+HAL_StatusTypeDef HAL_DMA_RegisterCallback(DMA_HandleTypeDef *hdma, HAL_DMA_CallbackIDTypeDef CallbackID, void (* pCallback)(DMA_HandleTypeDef *_hdma));
+#define __HAL_DMA_ENABLE(__HANDLE__)					((__HANDLE__)->Instance->CCR |= DMA_CCR_EN)
+#define __HAL_DMA_DISABLE(__HANDLE__)					((__HANDLE__)->Instance->CCR &= ~DMA_CCR_EN)
+#define __HAL_DMA_ENABLE_IT(__HANDLE__, __INTERRUPT__)	((__HANDLE__)->Instance->CCR |= (__INTERRUPT__))
+#define __HAL_DMA_CLEAR_FLAG(__HANDLE__, __FLAG__)		(DMA1->IFCR = (__FLAG__))
+#define __HAL_LINKDMA(__HANDLE__, __PPP_DMA_FIELD__, __DMA_HANDLE__)	do{ (__HANDLE__)->__PPP_DMA_FIELD__ = &(__DMA_HANDLE__); (__DMA_HANDLE__).Parent = (__HANDLE__); }while(0)
+
+/* TIM */
+typedef struct { uint32_t Prescaler, CounterMode, Period, ClockDivision, RepetitionCounter, AutoReloadPreload; } TIM_Base_InitTypeDef;
+typedef struct { uint32_t OCMode, Pulse, OCPolarity, OCNPolarity, OCFastMode, OCIdleState, OCNIdleState; } TIM_OC_InitTypeDef;
+typedef struct { uint32_t ClockSource, ClockPolarity, ClockPrescaler, ClockFilter; } TIM_ClockConfigTypeDef;
+typedef struct { uint32_t MasterOutputTrigger, MasterSlaveMode; } TIM_MasterConfigTypeDef;
+typedef struct { TIM_TypeDef *Instance; TIM_Base_InitTypeDef Init; uint32_t Channel; DMA_HandleTypeDef *hdma[7]; HAL_LockTypeDef Lock; uint32_t State; } TIM_HandleTypeDef;
+#define TIM_COUNTERMODE_UP				0x00000000U
+#define TIM_CLOCKSOURCE_INTERNAL		0x00001000U
+#define TIM_TRGO_UPDATE					0x00000020U
+#define TIM_MASTERSLAVEMODE_DISABLE		0x00000000U
+#define TIM_OCMODE_TIMING				0x00000000U
+#define TIM_OCMODE_PWM1					0x00000060U
+#define TIM_OCPOLARITY_HIGH				0x00000000U
+#define TIM_OCNPOLARITY_HIGH			0x00000000U
+#define TIM_OCIDLESTATE_SET				0x00000100U
+#define TIM_OCFAST_ENABLE				0x00000004U
+#define TIM_CHANNEL_1					0x00000000U
+#define TIM_CHANNEL_2					0x00000004U
+#define TIM_CCx_ENABLE					0x00000001U
+#define TIM_CCx_DISABLE					0x00000000U
+#define TIM_IT_UPDATE					0x00000001U
+#define TIM_FLAG_UPDATE					0x00000001U
+#define TIM_DMA_UPDATE					0x00000100U
+#define TIM_DMA_CC1						0x00000200U
+#define TIM_DMA_CC2						0x00000400U
+HAL_StatusTypeDef HAL_TIM_Base_Init(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Start(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_ConfigClockSource(TIM_HandleTypeDef *htim, TIM_ClockConfigTypeDef *sClockSourceConfig);
+HAL_StatusTypeDef HAL_TIMEx_MasterConfigSynchronization(TIM_HandleTypeDef *htim, TIM_MasterConfigTypeDef *sMasterConfig);
+HAL_StatusTypeDef HAL_TIM_OC_ConfigChannel(TIM_HandleTypeDef *htim, TIM_OC_InitTypeDef *sConfig, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIM_PWM_ConfigChannel(TIM_HandleTypeDef *htim, TIM_OC_InitTypeDef *sConfig, uint32_t Channel);
+void TIM_CCxChannelCmd(TIM_TypeDef *TIMx, uint32_t Channel, uint32_t ChannelState);
+void sim_tim_enabled(TIM_TypeDef *TIMx);
+#define __HAL_TIM_ENABLE(__HANDLE__)					do{ (__HANDLE__)->Instance->CR1 |= TIM_CR1_CEN; sim_tim_enabled((__HANDLE__)->Instance); }while(0)
+#define __HAL_TIM_DISABLE(__HANDLE__)					((__HANDLE__)->Instance->CR1 &= ~TIM_CR1_CEN)
+#define __HAL_TIM_ENABLE_IT(__HANDLE__, __INTERRUPT__)	((__HANDLE__)->Instance->DIER |= (__INTERRUPT__))
+#define __HAL_TIM_DISABLE_IT(__HANDLE__, __INTERRUPT__)	((__HANDLE__)->Instance->DIER &= ~(__INTERRUPT__))
+#define __HAL_TIM_ENABLE_DMA(__HANDLE__, __DMA__)		((__HANDLE__)->Instance->DIER |= (__DMA__))
+#define __HAL_TIM_DISABLE_DMA(__HANDLE__, __DMA__)		((__HANDLE__)->Instance->DIER &= ~(__DMA__))
+#define __HAL_TIM_CLEAR_IT(__HANDLE__, __INTERRUPT__)	((__HANDLE__)->Instance->SR = ~(__INTERRUPT__))
+#define __HAL_TIM_GET_FLAG(__HANDLE__, __FLAG__)		(((__HANDLE__)->Instance->SR & (__FLAG__)) == (__FLAG__))
+#define __HAL_TIM_GET_IT_SOURCE(__HANDLE__, __INTERRUPT__)	((((__HANDLE__)->Instance->DIER & (__INTERRUPT__)) == (__INTERRUPT__)) ? SET : RESET)
+#define __HAL_TIM_SET_COUNTER(__HANDLE__, __COUNTER__)	((__HANDLE__)->Instance->CNT = (__COUNTER__))
+
+/* RTC */
+typedef struct { uint8_t Hours, Minutes, Seconds; } RTC_TimeTypeDef;
+typedef struct { uint8_t WeekDay, Month, Date, Year; } RTC_DateTypeDef;
+typedef struct { RTC_TimeTypeDef AlarmTime; uint32_t Alarm; } RTC_AlarmTypeDef;
+typedef struct { uint32_t AsynchPrediv, OutPut; } RTC_InitTypeDef;
+typedef enum { HAL_RTC_STATE_RESET = 0x00U, HAL_RTC_STATE_READY = 0x01U, HAL_RTC_STATE_BUSY = 0x02U } HAL_RTCStateTypeDef;
+typedef struct { RTC_TypeDef *Instance; RTC_InitTypeDef Init; RTC_DateTypeDef DateToUpdate; HAL_LockTypeDef Lock; __IO HAL_RTCStateTypeDef State; } RTC_HandleTypeDef;
+#define RTC_AUTO_1_SECOND				0xFFFFFFFFU
+#define RTC_FORMAT_BIN					0x000000000U
+#define RTC_FORMAT_BCD					0x000000001U
+#define RTC_ALARM_A						0U
+#define RTC_IT_SEC						RTC_CRH_SECIE
+#define RTC_IT_ALRA						RTC_CRH_ALRIE
+#define RTC_IT_OW						RTC_CRH_OWIE
+#define RTC_FLAG_SEC					RTC_CRL_SECF
+#define RTC_FLAG_ALRAF					RTC_CRL_ALRF
+#define RTC_FLAG_RTOFF					RTC_CRL_RTOFF
+#define RTC_MONTH_JANUARY				((uint8_t)0x01)
+#define RTC_MONTH_FEBRUARY				((uint8_t)0x02)
+#define RTC_WEEKDAY_SUNDAY				((uint8_t)0x00)
+#define RTC_WEEKDAY_MONDAY				((uint8_t)0x01)
+#define RTC_WEEKDAY_TUESDAY				((uint8_t)0x02)
+#define RTC_WEEKDAY_SATURDAY			((uint8_t)0x06)
+#define RTC_BKP_DR1						0x00000001U
+#define RTC_BKP_DR2						0x00000002U
+#define RTC_BKP_DR3						0x00000003U
+#define RTC_BKP_DR4						0x00000004U
+#define RTC_BKP_DR5						0x00000005U
+#define RTC_BKP_DR6						0x00000006U
+#define RTC_BKP_DR7						0x00000007U
+#define RTC_BKP_DR8						0x00000008U
+#define RTC_BKP_DR9						0x00000009U
+#define RTC_BKP_DR10					0x0000000AU
+#define RTC_BKP_DR11					0x0000000BU
+#define RTC_BKP_DR12					0x0000000CU
+#define RTC_BKP_DR13					0x0000000DU
+#define RTC_BKP_DR14					0x0000000EU
+#define RTC_BKP_DR15					0x0000000FU
+#define RTC_BKP_DR16					0x00000010U
+#define RTC_BKP_DR17					0x00000011U
+#define RTC_BKP_DR18					0x00000012U
+#define RTC_BKP_DR19					0x00000013U
+#define RTC_BKP_DR20					0x00000014U
+#define RTC_EXTI_LINE_ALARM_EVENT		((uint32_t)0x00020000U)
+HAL_StatusTypeDef HAL_RTC_Init(RTC_HandleTypeDef *hrtc);
+void HAL_RTC_MspInit(RTC_HandleTypeDef *hrtc);
+HAL_StatusTypeDef HAL_RTC_SetTime(RTC_HandleTypeDef *hrtc, RTC_TimeTypeDef *sTime, uint32_t Format);
+HAL_StatusTypeDef HAL_RTC_GetTime(RTC_HandleTypeDef *hrtc, RTC_TimeTypeDef *sTime, uint32_t Format);
+HAL_StatusTypeDef HAL_RTC_SetDate(RTC_HandleTypeDef *hrtc, RTC_DateTypeDef *sDate, uint32_t Format);
+HAL_StatusTypeDef HAL_RTC_GetDate(RTC_HandleTypeDef *hrtc, RTC_DateTypeDef *sDate, uint32_t Format);
+HAL_StatusTypeDef HAL_RTC_SetAlarm_IT(RTC_HandleTypeDef *hrtc, RTC_AlarmTypeDef *sAlarm, uint32_t Format);
+HAL_StatusTypeDef HAL_RTC_DeactivateAlarm(RTC_HandleTypeDef *hrtc, uint32_t Alarm);
+HAL_StatusTypeDef HAL_RTC_WaitForSynchro(RTC_HandleTypeDef *hrtc);
+HAL_StatusTypeDef HAL_RTCEx_SetSecond_IT(RTC_HandleTypeDef *hrtc);
+HAL_StatusTypeDef HAL_RTCEx_DeactivateSecond(RTC_HandleTypeDef *hrtc);
+void HAL_RTCEx_RTCIRQHandler(RTC_HandleTypeDef *hrtc);
+void HAL_RTCEx_RTCEventCallback(RTC_HandleTypeDef *hrtc);
+uint32_t HAL_RTCEx_BKUPRead(RTC_HandleTypeDef *hrtc, uint32_t BackupRegister);
+void HAL_RTCEx_BKUPWrite(RTC_HandleTypeDef *hrtc, uint32_t BackupRegister, uint32_t Data);
+#define __HAL_RTC_ALARM_GET_IT_SOURCE(__HANDLE__, __INTERRUPT__)	((((__HANDLE__)->Instance->CRH) & (__INTERRUPT__)) != RESET ? SET : RESET)
+#define __HAL_RTC_ALARM_ENABLE_IT(__HANDLE__, __INTERRUPT__)		((__HANDLE__)->Instance->CRH |= (__INTERRUPT__))
+#define __HAL_RTC_ALARM_DISABLE_IT(__HANDLE__, __INTERRUPT__)		((__HANDLE__)->Instance->CRH &= ~(__INTERRUPT__))
+#define __HAL_RTC_ALARM_GET_FLAG(__HANDLE__, __FLAG__)			((((__HANDLE__)->Instance->CRL) & (__FLAG__)) != RESET ? SET : RESET)
+#define __HAL_RTC_ALARM_CLEAR_FLAG(__HANDLE__, __FLAG__)		((__HANDLE__)->Instance->CRL = ~(__FLAG__))
+#define __HAL_RTC_ALARM_EXTI_ENABLE_IT()						(EXTI->IMR |= RTC_EXTI_LINE_ALARM_EVENT)
+#define __HAL_RTC_ALARM_EXTI_ENABLE_RISING_EDGE()				(EXTI->RTSR |= RTC_EXTI_LINE_ALARM_EVENT)
+#define __HAL_RTC_ALARM_EXTI_CLEAR_FLAG()						(EXTI->PR = RTC_EXTI_LINE_ALARM_EVENT)
+#define __HAL_RTC_SECOND_GET_IT_SOURCE(__HANDLE__, __INTERRUPT__)	((((__HANDLE__)->Instance->CRH) & (__INTERRUPT__)) != RESET ? SET : RESET)
+#define __HAL_RTC_SECOND_GET_FLAG(__HANDLE__, __FLAG__)			((((__HANDLE__)->Instance->CRL) & (__FLAG__)) != RESET ? SET : RESET)
+#define __HAL_RTC_SECOND_CLEAR_FLAG(__HANDLE__, __FLAG__)		((__HANDLE__)->Instance->CRL = ~(__FLAG__))
+#define __HAL_RTC_SECOND_ENABLE_IT(__HANDLE__, __INTERRUPT__)	((__HANDLE__)->Instance->CRH |= (__INTERRUPT__))
+#define __HAL_RTC_SECOND_DISABLE_IT(__HANDLE__, __INTERRUPT__)	((__HANDLE__)->Instance->CRH &= ~(__INTERRUPT__))
+
+/* ADC */
+typedef struct { uint32_t DataAlign, ScanConvMode, ContinuousConvMode, NbrOfConversion, DiscontinuousConvMode, NbrOfDiscConversion, ExternalTrigConv; } ADC_InitTypeDef;
+typedef struct { uint32_t Channel, Rank, SamplingTime; } ADC_ChannelConfTypeDef;
+typedef struct { ADC_TypeDef *Instance; ADC_InitTypeDef Init; DMA_HandleTypeDef *DMA_Handle; HAL_LockTypeDef Lock; __IO uint32_t State; __IO uint32_t ErrorCode; } ADC_HandleTypeDef;
+#define ADC_DATAALIGN_RIGHT				0x00000000U
+#define ADC_SCAN_DISABLE				0x00000000U
+#define ADC1_2_3_SWSTART				0x000E0000U
+#define ADC_CHANNEL_7					0x00000007U
+#define ADC_REGULAR_RANK_1				0x00000001U
+#define ADC_SAMPLETIME_28CYCLES_5		0x00000003U
+HAL_StatusTypeDef HAL_ADC_Init(ADC_HandleTypeDef *hadc);
+HAL_StatusTypeDef HAL_ADC_ConfigChannel(ADC_HandleTypeDef *hadc, ADC_ChannelConfTypeDef *sConfig);
+HAL_StatusTypeDef HAL_ADCEx_Calibration_Start(ADC_HandleTypeDef *hadc);
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef *hadc, uint32_t *pData, uint32_t Length);
+HAL_StatusTypeDef HAL_ADC_Stop(ADC_HandleTypeDef *hadc);
+uint32_t HAL_ADC_GetValue(ADC_HandleTypeDef *hadc);
+void HAL_ADC_IRQHandler(ADC_HandleTypeDef *hadc);
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc);
+
+#endif
@@ -0,0 +1,71 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __SIM_H
+#define __SIM_H
+
+/* Includes */
+#include "stm32f1xx_hal.h"
+#include "ws2812.h"
+#include "record.h"
+
+/* Exported defines */
+#define SIM_CORE_CLOCK				72000000U
+#define SIM_CYCLES_PER_MS			(SIM_CORE_CLOCK / 1000U)
+#define SIM_LED_BIT_CYCLES			90U			// 1.25 us per bit of the led data
+#define SIM_ADC_CYCLES				1800U		// 25 us from the start to the end of a conversion
+#define SIM_INPUT_LENGTH			4096		// maximum amount of scripted inputs, a replayed recording needs ~1 per second
+#define SIM_PPM_SCALE				16			// size of a led in the ppm images, in image pixels
+
+/* Exported types */
+/*
+* @brief  one transmitted frame, as the leds show it
+  */
+typedef struct {
+	uint32_t	index;
+	uint32_t	ms;						// simulated time of the transmission
+	uint8_t		rgb[ROW][COL][3];
+}Sim_Frame;
+
+/* Exported functions */
+/* sim_hal.c */
+void sim_reset(void);
+uint64_t sim_get_cycles(void);
+void sim_set_end(uint32_t ms);
+void sim_set_time(uint32_t seconds);
+void sim_set_adc(uint16_t value);
+void sim_set_pin(uint16_t pin, uint8_t level);
+uint8_t sim_input_at(uint32_t ms, uint16_t pin, uint8_t level);
+uint8_t sim_adc_at(uint32_t ms, uint16_t value);
+uint8_t sim_record_at(uint32_t ms, const Record_Entry *record);
+void sim_set_frame_callback(void (*callback)(const Sim_Frame *frame));
+void sim_clear_exclusive(void);
+void sim_set_exclusive_hook(void (*hook)(void));
+
+/* sim_frame.c */
+void sim_frame_set_ppm(const char *directory);
+void sim_frame_set_ansi(uint8_t enable);
+void sim_frame_set_changes_only(uint8_t enable);
+void sim_frame_set_gain(uint8_t gain);
+void sim_frame_output(const Sim_Frame *frame);
+uint32_t sim_frame_get_written(void);
+void sim_frame_report(void);
+
+/* firmware interrupt handlers, stm32f1xx_it.c and ws2812.c */
+void SysTick_Handler(void);
+void EXTI0_IRQHandler(void);
+void EXTI1_IRQHandler(void);
+void EXTI2_IRQHandler(void);
+void EXTI15_10_IRQHandler(void);
+void TIM1_UP_IRQHandler(void);
+void TIM2_IRQHandler(void);
+void TIM3_IRQHandler(void);
+void TIM4_IRQHandler(void);
+void RTC_Alarm_IRQHandler(void);
+void RTC_IRQHandler(void);
+void ADC1_2_IRQHandler(void);
+void DMA1_Channel1_IRQHandler(void);
+void DMA1_Channel7_IRQHandler(void);
+
+/* the firmware main routine, renamed by the makefile */
+int firmware_main(void);
+
+#endif
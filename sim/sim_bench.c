@@ -0,0 +1,93 @@
+/*
+ * Autor: Nico Korn
+ * Date: 19.10.2026
+ * Firmware for a alarmlcock with custom made STM32F103 microcontroller board.
+ *  *
+ * Copyright (c) 2026 Nico Korn
+ *
+ * sim_bench.c this module contents the host run of the render benchmarks
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+
+
+
+// ----------------------------------------------------------------------------
+
+#include "sim.h"
+#include "benchmark.h"
+#include "effect.h"
+#include "particle.h"
+#include "animation.h"
+#include "lightsensor.h"
+#include <stdio.h>
+
+/* private variables */
+static FILE					*results;
+
+/* global variables */
+Alarmclock					alarmclock;					// defined by main.c in the firmware, used by the interrupt handlers
+
+/* private functions */
+static void output(const char *line);
+
+
+
+/**
+  * @brief  initializes the render path as the firmware does it and runs the benchmarks
+  * @note   the results are written to the file of the first argument, else to stdout
+  * @retval exit code
+  */
+int main(int argc, char **argv){
+	results = stdout;
+	if(argc > 1){
+		results = fopen(argv[1], "w");
+		if(results == NULL){
+			perror(argv[1]);
+			return 1;
+		}
+	}
+
+	sim_reset();
+	sim_set_end(60000);
+	HAL_Init();
+	init_ws2812();
+	init_particle();
+	init_lightsensor(&alarmclock);
+	init_animation(alarmclock.ambient_light_factor);
+	init_clock(&alarmclock);
+	init_effect();
+
+	benchmark_run(&alarmclock, output);
+	if(results != stdout){
+		fclose(results);
+	}
+	return 0;
+}
+
+/**
+  * @brief  writes a result line
+  * @note   None
+  * @retval None
+  */
+static void output(const char *line){
+	fprintf(results, "%s\n", line);
+}
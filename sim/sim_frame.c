@@ -0,0 +1,212 @@
+/*
+ * Autor: Nico Korn
+ * Date: 19.10.2026
+ * Firmware for a alarmlcock with custom made STM32F103 microcontroller board.
+ *  *
+ * Copyright (c) 2026 Nico Korn
+ *
+ * sim_frame.c this module contents the output of the simulated frames as ppm images and ansi colors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+
+
+
+// ----------------------------------------------------------------------------
+
+#include "sim.h"
+#include <stdio.h>
+#include <string.h>
+
+/* defines */
+#define SIM_PATH_LENGTH			256
+
+/* private variables */
+static const char				*ppm_directory;
+static uint8_t					ansi_enable;
+static uint8_t					changes_only;
+static uint8_t					gain = 1;
+static uint32_t					frames_written;
+static uint8_t					previous_valid;
+static uint8_t					previous[ROW][COL][3];
+static uint32_t					frames_sent;
+static uint64_t					frame_last;					// cycles of the previous frame
+static uint64_t					interval_min = UINT64_MAX;
+static uint64_t					interval_max;
+static uint64_t					interval_total;
+
+/* private functions */
+static uint8_t apply_gain(uint8_t value);
+static void write_ppm(const Sim_Frame *frame);
+static void write_ansi(const Sim_Frame *frame);
+
+
+
+/**
+  * @brief  writes every frame as ppm image into the directory
+  * @note   the directory has to exist, NULL disables the images
+  * @retval None
+  */
+void sim_frame_set_ppm(const char *directory){
+	ppm_directory = directory;
+}
+
+/**
+  * @brief  prints every frame with ansi 24 bit colors to stdout
+  * @note   None
+  * @retval None
+  */
+void sim_frame_set_ansi(uint8_t enable){
+	ansi_enable = enable;
+}
+
+/**
+  * @brief  skips the frames which are equal to the previous frame
+  * @note   the clock refreshes the display also without a change
+  * @retval None
+  */
+void sim_frame_set_changes_only(uint8_t enable){
+	changes_only = enable;
+}
+
+/**
+  * @brief  multiplies the led values, the dimmed display is hard to see otherwise
+  * @note   None
+  * @retval None
+  */
+void sim_frame_set_gain(uint8_t value){
+	gain = value == 0 ? 1 : value;
+}
+
+/**
+  * @brief  frame callback of the simulation, writes the frame to the enabled outputs
+  * @note   None
+  * @retval None
+  */
+void sim_frame_output(const Sim_Frame *frame){
+	uint64_t now = sim_get_cycles();
+
+	/* interval of the transmitted frames, the changes only filter applies to the outputs */
+	if(frames_sent > 0){
+		if(now - frame_last < interval_min){
+			interval_min = now - frame_last;
+		}
+		if(now - frame_last > interval_max){
+			interval_max = now - frame_last;
+		}
+		interval_total += now - frame_last;
+	}
+	frame_last = now;
+	frames_sent++;
+
+	if(changes_only && previous_valid && memcmp(previous, frame->rgb, sizeof(previous)) == 0){
+		return;
+	}
+	memcpy(previous, frame->rgb, sizeof(previous));
+	previous_valid = 1;
+	if(ppm_directory != NULL){
+		write_ppm(frame);
+	}
+	if(ansi_enable){
+		write_ansi(frame);
+	}
+	frames_written++;
+}
+
+/**
+  * @brief  get the amount of written frames
+  * @note   None
+  * @retval frames
+  */
+uint32_t sim_frame_get_written(void){
+	return frames_written;
+}
+
+/**
+  * @brief  prints the amount of transmitted frames and their intervals to stderr
+  * @note   None
+  * @retval None
+  */
+void sim_frame_report(void){
+	fprintf(stderr, "frames: %u sent, %u written\n", (unsigned)frames_sent, (unsigned)frames_written);
+	if(frames_sent > 1){
+		fprintf(stderr, "frame interval: min %.2f ms, mean %.2f ms, max %.2f ms\n",
+				(double)interval_min / SIM_CYCLES_PER_MS,
+				(double)interval_total / (frames_sent - 1) / SIM_CYCLES_PER_MS,
+				(double)interval_max / SIM_CYCLES_PER_MS);
+	}
+}
+
+/**
+  * @brief  led value with gain, saturated
+  * @note   None
+  * @retval value
+  */
+static uint8_t apply_gain(uint8_t value){
+	uint16_t result = (uint16_t)value * gain;
+	return result > 0xFF ? 0xFF : (uint8_t)result;
+}
+
+/**
+  * @brief  writes the frame as binary ppm, every led is a square of SIM_PPM_SCALE pixels
+  * @note   None
+  * @retval None
+  */
+static void write_ppm(const Sim_Frame *frame){
+	char path[SIM_PATH_LENGTH];
+	uint8_t line[COL * SIM_PPM_SCALE * 3];
+	FILE *file;
+
+	snprintf(path, sizeof(path), "%s/frame_%06u.ppm", ppm_directory, (unsigned)frames_written);
+	file = fopen(path, "wb");
+	if(file == NULL){
+		perror(path);
+		return;
+	}
+	fprintf(file, "P6\n%u %u\n255\n", COL * SIM_PPM_SCALE, ROW * SIM_PPM_SCALE);
+	for(uint8_t row = 0; row < ROW; row++){
+		for(uint16_t x = 0; x < COL * SIM_PPM_SCALE; x++){
+			for(uint8_t color = 0; color < 3; color++){
+				line[x * 3 + color] = apply_gain(frame->rgb[row][x / SIM_PPM_SCALE][color]);
+			}
+		}
+		for(uint8_t y = 0; y < SIM_PPM_SCALE; y++){
+			fwrite(line, sizeof(line), 1, file);
+		}
+	}
+	fclose(file);
+}
+
+/**
+  * @brief  prints the frame with two spaces per led
+  * @note   None
+  * @retval None
+  */
+static void write_ansi(const Sim_Frame *frame){
+	printf("frame %u at %u.%03u s\n", (unsigned)frame->index, (unsigned)(frame->ms / 1000), (unsigned)(frame->ms % 1000));
+	for(uint8_t row = 0; row < ROW; row++){
+		for(uint8_t col = 0; col < COL; col++){
+			printf("\033[48;2;%u;%u;%um  ", apply_gain(frame->rgb[row][col][0]), apply_gain(frame->rgb[row][col][1]), apply_gain(frame->rgb[row][col][2]));
+		}
+		printf("\033[0m\n");
+	}
+	fflush(stdout);
+}
@@ -0,0 +1,1027 @@
+/*
+ * Autor: Nico Korn
+ * Date: 19.10.2026
+ * Firmware for a alarmlcock with custom made STM32F103 microcontroller board.
+ *  *
+ * Copyright (c) 2026 Nico Korn
+ *
+ * sim_hal.c this module contents the simulated peripherals and hal of the host build
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+
+
+
+// ----------------------------------------------------------------------------
+
+#include "sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* defines */
+#define SIM_IRQ_OFFSET			16			// index of an interrupt in the tables is IRQn + 16
+#define SIM_IRQ_COUNT			64
+#define SIM_TIMERS				4
+#define SIM_NEVER				UINT64_MAX
+#define SIM_EXTI_ALARM_LINE		17
+#define SIM_BUTTON_PINS			(GPIO_PIN_0 | GPIO_PIN_1 | GPIO_PIN_2 | GPIO_PIN_12)
+
+/* private types */
+typedef struct {
+	TIM_TypeDef		*instance;
+	IRQn_Type		irq;
+	uint8_t			running;
+	uint64_t		next;				// cycles of the next update event
+}Sim_Timer;
+
+typedef enum {
+	SIM_INPUT_PIN,
+	SIM_INPUT_ADC,
+	SIM_INPUT_RECORD
+}Sim_Input_Type;
+
+typedef struct {
+	uint64_t		cycles;
+	Sim_Input_Type	type;
+	uint16_t		pin;
+	uint8_t			level;
+	Record_Entry	record;				// replayed by the firmware, see record.c
+}Sim_Input;
+
+/* peripheral registers */
+GPIO_TypeDef				sim_GPIOA, sim_GPIOB;
+DMA_Channel_TypeDef			sim_DMA1_Channel[8];
+DMA_TypeDef					sim_DMA1;
+TIM_TypeDef					sim_TIM1, sim_TIM2, sim_TIM3, sim_TIM4;
+RTC_TypeDef					sim_RTC;
+ADC_TypeDef					sim_ADC1;
+EXTI_TypeDef				sim_EXTI;
+PWR_TypeDef					sim_PWR;
+DWT_Type					sim_DWT;
+CoreDebug_Type				sim_CoreDebug;
+ITM_Type					sim_ITM;
+SysTick_Type				sim_SysTick;
+SCB_Type					sim_SCB;
+uint32_t					sim_BKP[43];
+uint32_t					SystemCoreClock = SIM_CORE_CLOCK;
+__IO uint32_t				uwTick;
+
+/* private variables */
+static uint64_t				sim_cycles;
+static volatile uint32_t	*volatile exclusive_addr;	// address of the open exclusive monitor
+static volatile uint32_t	exclusive_value;
+static void					(*exclusive_hook)(void);
+static uint64_t				sim_end = SIM_NEVER;
+static uint32_t				sim_primask;
+static uint32_t				pin_levels;					// levels of port b, idr is read only on the core
+static uint8_t				irq_pending[SIM_IRQ_COUNT];
+static uint8_t				irq_enabled[SIM_IRQ_COUNT];
+static uint8_t				irq_active[SIM_IRQ_COUNT];
+static uint8_t				irq_priority[SIM_IRQ_COUNT];
+static void					(*irq_vectors[SIM_IRQ_COUNT])(void);
+static uint64_t				systick_next = SIM_NEVER;
+static uint32_t				systick_load;
+static uint64_t				rtc_next = SIM_CORE_CLOCK;
+static uint8_t				rtc_time_valid;
+static uint32_t				rtc_time;
+static uint64_t				led_done = SIM_NEVER;
+static uint64_t				adc_done = SIM_NEVER;
+static uint16_t				adc_value = 100;
+static uint32_t				*adc_target;
+static ADC_HandleTypeDef	*adc_handle;
+static Sim_Timer			sim_timers[SIM_TIMERS] = {
+									{&sim_TIM1, TIM1_UP_IRQn},
+									{&sim_TIM2, TIM2_IRQn},
+									{&sim_TIM3, TIM3_IRQn},
+									{&sim_TIM4, TIM4_IRQn}
+									};
+static Sim_Input			sim_inputs[SIM_INPUT_LENGTH];
+static uint16_t				sim_input_count;
+static uint16_t				sim_input_next;
+static Sim_Frame			sim_frame;
+static void					(*sim_frame_callback)(const Sim_Frame *frame);
+
+/* private functions */
+static uint8_t irq_index(IRQn_Type irq);
+static void sim_pend(IRQn_Type irq);
+static uint8_t sim_irq_waiting(void);
+static void sim_dispatch(void);
+static void sim_advance(void);
+static void sim_sync_systick(void);
+static void sim_restart_systick(void);
+static void sim_rtc_second(void);
+static void sim_timer_update(Sim_Timer *timer);
+static uint64_t sim_timer_period(TIM_TypeDef *instance);
+static void sim_led_transfer(void);
+static void sim_adc_complete(void);
+static Sim_Input* sim_input_insert(uint32_t ms);
+static void sim_apply_input(Sim_Input *input);
+static IRQn_Type sim_exti_irq(uint16_t pin);
+static void sim_adc_dma_complete(DMA_HandleTypeDef *hdma);
+
+
+
+/**
+  * @brief  resets the simulated core and peripherals to the state after a power on
+  * @note   the buttons are released and the alarm switch is off
+  * @retval None
+  */
+void sim_reset(void){
+	irq_vectors[irq_index(SysTick_IRQn)] = SysTick_Handler;
+	irq_vectors[irq_index(EXTI0_IRQn)] = EXTI0_IRQHandler;
+	irq_vectors[irq_index(EXTI1_IRQn)] = EXTI1_IRQHandler;
+	irq_vectors[irq_index(EXTI2_IRQn)] = EXTI2_IRQHandler;
+	irq_vectors[irq_index(EXTI15_10_IRQn)] = EXTI15_10_IRQHandler;
+	irq_vectors[irq_index(TIM1_UP_IRQn)] = TIM1_UP_IRQHandler;
+	irq_vectors[irq_index(TIM2_IRQn)] = TIM2_IRQHandler;
+	irq_vectors[irq_index(TIM3_IRQn)] = TIM3_IRQHandler;
+	irq_vectors[irq_index(TIM4_IRQn)] = TIM4_IRQHandler;
+	irq_vectors[irq_index(RTC_Alarm_IRQn)] = RTC_Alarm_IRQHandler;
+	irq_vectors[irq_index(RTC_IRQn)] = RTC_IRQHandler;
+	irq_vectors[irq_index(ADC1_2_IRQn)] = ADC1_2_IRQHandler;
+	irq_vectors[irq_index(DMA1_Channel1_IRQn)] = DMA1_Channel1_IRQHandler;
+	irq_vectors[irq_index(DMA1_Channel7_IRQn)] = DMA1_Channel7_IRQHandler;
+	irq_enabled[irq_index(SysTick_IRQn)] = 1;
+
+	pin_levels = SIM_BUTTON_PINS;
+	sim_GPIOB.IDR = pin_levels;
+	sim_RTC.CRL = RTC_CRL_RTOFF;
+	/* the hal starts the systick with 1 ms */
+	sim_SysTick.LOAD = SIM_CYCLES_PER_MS - 1;
+	sim_SysTick.CTRL = SysTick_CTRL_ENABLE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_CLKSOURCE_Msk;
+}
+
+/**
+  * @brief  get the simulated time
+  * @note   None
+  * @retval core clock cycles since the reset
+  */
+uint64_t sim_get_cycles(void){
+	return sim_cycles;
+}
+
+/**
+  * @brief  sets the simulated time at which the simulation exits
+  * @note   None
+  * @retval None
+  */
+void sim_set_end(uint32_t ms){
+	sim_end = (uint64_t)ms * SIM_CYCLES_PER_MS;
+}
+
+/**
+  * @brief  sets the rtc counter, in seconds since the epoch of the timebase
+  * @note   the counter is written when the firmware sleeps the first time, after the rtc has been initialized
+  * @retval None
+  */
+void sim_set_time(uint32_t seconds){
+	rtc_time = seconds;
+	rtc_time_valid = 1;
+}
+
+/**
+  * @brief  sets the value of the light sensor conversions
+  * @note   None
+  * @retval None
+  */
+void sim_set_adc(uint16_t value){
+	adc_value = value;
+}
+
+/**
+  * @brief  sets the level of an input pin of port b without an interrupt
+  * @note   used for the level of the alarm switch at the start
+  * @retval None
+  */
+void sim_set_pin(uint16_t pin, uint8_t level){
+	if(level){
+		pin_levels |= pin;
+	}else{
+		pin_levels &= ~(uint32_t)pin;
+	}
+	sim_GPIOB.IDR = pin_levels;
+}
+
+/**
+  * @brief  changes the level of an input pin of port b at the simulated time
+  * @note   None
+  * @retval 1 if the change has been added, 0 if the script is full
+  */
+uint8_t sim_input_at(uint32_t ms, uint16_t pin, uint8_t level){
+	Sim_Input *input = sim_input_insert(ms);
+
+	if(input == NULL){
+		return 0;
+	}
+	input->type = SIM_INPUT_PIN;
+	input->pin = pin;
+	input->level = level;
+	return 1;
+}
+
+/**
+  * @brief  changes the value of the light sensor conversions at the simulated time
+  * @note   None
+  * @retval 1 if the change has been added, 0 if the script is full
+  */
+uint8_t sim_adc_at(uint32_t ms, uint16_t value){
+	Sim_Input *input = sim_input_insert(ms);
+
+	if(input == NULL){
+		return 0;
+	}
+	input->type = SIM_INPUT_ADC;
+	input->pin = value;
+	return 1;
+}
+
+/**
+  * @brief  replays a record with record_replay_entry() at the simulated time
+  * @note   called from the sleep of the firmware, like an interrupt
+  * @retval 1 if the record has been added, 0 if the script is full
+  */
+uint8_t sim_record_at(uint32_t ms, const Record_Entry *record){
+	Sim_Input *input = sim_input_insert(ms);
+
+	if(input == NULL){
+		return 0;
+	}
+	input->type = SIM_INPUT_RECORD;
+	input->record = *record;
+	return 1;
+}
+
+/**
+  * @brief  sets the function which is called for every transmitted frame
+  * @note   None
+  * @retval None
+  */
+void sim_set_frame_callback(void (*callback)(const Sim_Frame *frame)){
+	sim_frame_callback = callback;
+}
+
+/**
+  * @brief  called by __HAL_TIM_ENABLE, starts the update events of the timer
+  * @note   the led timer starts a transmission if its dma channels are enabled
+  * @retval None
+  */
+void sim_tim_enabled(TIM_TypeDef *TIMx){
+	for(uint8_t i = 0; i < SIM_TIMERS; i++){
+		if(sim_timers[i].instance == TIMx){
+			sim_timers[i].running = 1;
+			sim_timers[i].next = sim_cycles + sim_timer_period(TIMx);
+		}
+	}
+	if(TIMx == &sim_TIM2 && (sim_DMA1_Channel[5].CCR & DMA_CCR_EN) && (sim_TIM2.DIER & TIM_DMA_CC1)){
+		sim_led_transfer();
+	}
+}
+
+/**
+  * @brief  time of the host, the counter of the host benchmarks
+  * @note   overflows after ~4.3 s
+  * @retval nanoseconds
+  */
+uint32_t sim_host_ns(void){
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint32_t)((uint64_t)now.tv_sec * 1000000000U + now.tv_nsec);
+}
+
+/* ----------------------------------------------------------------------------
+ * core
+ */
+
+void __disable_irq(void){
+	sim_primask = 1;
+	/* the firmware reads the counter of a restarted systick in a critical section, see power_idle */
+	sim_restart_systick();
+}
+
+void __enable_irq(void){
+	sim_primask = 0;
+	sim_dispatch();
+}
+
+uint32_t __get_PRIMASK(void){
+	return sim_primask;
+}
+
+void __set_PRIMASK(uint32_t primask){
+	sim_primask = primask;
+	if(!sim_primask){
+		sim_dispatch();
+	}
+}
+
+/**
+  * @brief  sleeps until the next interrupt
+  * @note   the simulated time jumps to the next event, a masked interrupt wakes the core up but runs
+  * 		when the interrupts are enabled again
+  * @retval None
+  */
+void __WFI(void){
+	sim_GPIOB.IDR = pin_levels;
+	sim_sync_systick();
+	if(!sim_irq_waiting()){
+		sim_advance();
+	}
+	if(!sim_primask){
+		sim_dispatch();
+	}
+}
+
+void __WFE(void){
+	__WFI();
+}
+
+void __SEV(void){}
+void __DMB(void){
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+void __DSB(void){}
+void __ISB(void){}
+void __NOP(void){}
+
+void __CLREX(void){
+	sim_clear_exclusive();
+}
+
+/**
+  * @brief  load exclusive, opens the exclusive monitor on the address
+  * @note   None
+  * @retval value
+  */
+uint32_t __LDREXW(volatile uint32_t *addr){
+	uint32_t value = *addr;
+
+	exclusive_value = value;
+	exclusive_addr = addr;
+	if(exclusive_hook != NULL){
+		exclusive_hook();
+	}
+	return value;
+}
+
+/**
+  * @brief  store exclusive, fails if the monitor has been cleared by an interrupt or __CLREX
+  * @note   the store is a compare and swap with the loaded value, it is atomic also against the signals
+  * 		which preempt the host stress test
+  * @retval 0 if stored, 1 if failed
+  */
+uint32_t __STREXW(uint32_t value, volatile uint32_t *addr){
+	uint32_t expected = exclusive_value;
+
+	if(exclusive_addr != addr){
+		return 1;
+	}
+	exclusive_addr = NULL;
+	return !__atomic_compare_exchange_n(addr, &expected, value, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+/**
+  * @brief  sets a function which is called between the load exclusive and the store exclusive
+  * @note   used by the stress test to preempt the producers of the event queue at the worst moment
+  * @retval None
+  */
+void sim_set_exclusive_hook(void (*hook)(void)){
+	exclusive_hook = hook;
+}
+
+/**
+  * @brief  clears the exclusive monitor, as the exception entry and exit of the core do it
+  * @note   None
+  * @retval None
+  */
+void sim_clear_exclusive(void){
+	exclusive_addr = NULL;
+}
+
+uint32_t ITM_SendChar(uint32_t ch){
+	return ch;
+}
+
+void NVIC_SystemReset(void){
+	exit(0);
+}
+
+/* ----------------------------------------------------------------------------
+ * hal
+ */
+
+HAL_StatusTypeDef HAL_Init(void){
+	return HAL_OK;
+}
+
+void HAL_IncTick(void){
+	uwTick++;
+}
+
+uint32_t HAL_GetTick(void){
+	return uwTick;
+}
+
+void HAL_SetTick(uint32_t tick){
+	uwTick = tick;
+}
+
+void HAL_SuspendTick(void){
+	sim_SysTick.CTRL &= ~SysTick_CTRL_TICKINT_Msk;
+}
+
+void HAL_ResumeTick(void){
+	sim_SysTick.CTRL |= SysTick_CTRL_TICKINT_Msk;
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority){
+	irq_priority[irq_index(IRQn)] = (PreemptPriority << 4) | SubPriority;
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn){
+	irq_enabled[irq_index(IRQn)] = 1;
+}
+
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn){
+	irq_enabled[irq_index(IRQn)] = 0;
+}
+
+void HAL_NVIC_ClearPendingIRQ(IRQn_Type IRQn){
+	irq_pending[irq_index(IRQn)] = 0;
+}
+
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef *RCC_OscInitStruct){
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef *RCC_ClkInitStruct, uint32_t FLatency){
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RCCEx_PeriphCLKConfig(RCC_PeriphCLKInitTypeDef *PeriphClkInit){
+	return HAL_OK;
+}
+
+uint32_t HAL_RCC_GetHCLKFreq(void){
+	return SystemCoreClock;
+}
+
+void HAL_PWR_EnableBkUpAccess(void){}
+
+void HAL_PWR_EnterSLEEPMode(uint32_t Regulator, uint8_t SLEEPEntry){
+	__WFI();
+}
+
+void HAL_PWR_EnterSTOPMode(uint32_t Regulator, uint8_t STOPEntry){
+	__WFI();
+}
+
+/**
+  * @brief  the interrupt modes enable the exti line of the pins
+  * @note   None
+  * @retval None
+  */
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init){
+	if((GPIO_Init->Mode & 0x10000000U) != 0){
+		sim_EXTI.IMR |= GPIO_Init->Pin;
+		if(GPIO_Init->Mode & 0x00100000U){
+			sim_EXTI.RTSR |= GPIO_Init->Pin;
+		}
+		if(GPIO_Init->Mode & 0x00200000U){
+			sim_EXTI.FTSR |= GPIO_Init->Pin;
+		}
+	}
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin){
+	return (GPIOx->IDR & GPIO_Pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+/**
+  * @brief  the real hal computes the base address and the channel index in the init and deinit
+  * @note   None
+  * @retval HAL_OK
+  */
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *hdma){
+	hdma->DmaBaseAddress = &sim_DMA1;
+	hdma->ChannelIndex = (hdma->Instance - &sim_DMA1_Channel[1]) * 4U;
+	hdma->Instance->CCR = hdma->Init.Direction | hdma->Init.MemInc | hdma->Init.Mode;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_DeInit(DMA_HandleTypeDef *hdma){
+	hdma->DmaBaseAddress = &sim_DMA1;
+	hdma->ChannelIndex = (hdma->Instance - &sim_DMA1_Channel[1]) * 4U;
+	hdma->Instance->CCR = 0;
+	return HAL_OK;
+}
+
+/**
+  * @brief  the transfers of the simulation complete at once, the handler calls the complete callback
+  * @note   None
+  * @retval None
+  */
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef *hdma){
+	if(hdma->XferCpltCallback != NULL){
+		hdma->XferCpltCallback(hdma);
+	}
+}
+
+HAL_StatusTypeDef HAL_DMA_RegisterCallback(DMA_HandleTypeDef *hdma, HAL_DMA_CallbackIDTypeDef CallbackID, void (* pCallback)(DMA_HandleTypeDef *_hdma)){
+	switch(CallbackID){
+		case HAL_DMA_XFER_CPLT_CB_ID:		hdma->XferCpltCallback = pCallback;
+		break;
+		case HAL_DMA_XFER_HALFCPLT_CB_ID:	hdma->XferHalfCpltCallback = pCallback;
+		break;
+		case HAL_DMA_XFER_ERROR_CB_ID:		hdma->XferErrorCallback = pCallback;
+		break;
+		case HAL_DMA_XFER_ABORT_CB_ID:		hdma->XferAbortCallback = pCallback;
+		break;
+		default:
+		break;
+	}
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Init(TIM_HandleTypeDef *htim){
+	htim->Instance->PSC = htim->Init.Prescaler;
+	htim->Instance->ARR = htim->Init.Period;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Start(TIM_HandleTypeDef *htim){
+	__HAL_TIM_ENABLE(htim);
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim){
+	__HAL_TIM_ENABLE_IT(htim, TIM_IT_UPDATE);
+	__HAL_TIM_ENABLE(htim);
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef *htim){
+	__HAL_TIM_DISABLE_IT(htim, TIM_IT_UPDATE);
+	__HAL_TIM_DISABLE(htim);
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_ConfigClockSource(TIM_HandleTypeDef *htim, TIM_ClockConfigTypeDef *sClockSourceConfig){
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIMEx_MasterConfigSynchronization(TIM_HandleTypeDef *htim, TIM_MasterConfigTypeDef *sMasterConfig){
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_OC_ConfigChannel(TIM_HandleTypeDef *htim, TIM_OC_InitTypeDef *sConfig, uint32_t Channel){
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_ConfigChannel(TIM_HandleTypeDef *htim, TIM_OC_InitTypeDef *sConfig, uint32_t Channel){
+	return HAL_OK;
+}
+
+void TIM_CCxChannelCmd(TIM_TypeDef *TIMx, uint32_t Channel, uint32_t ChannelState){
+	if(ChannelState == TIM_CCx_ENABLE){
+		TIMx->CCER |= (1U << Channel);
+	}else{
+		TIMx->CCER &= ~(1U << Channel);
+	}
+}
+
+HAL_StatusTypeDef HAL_RTC_Init(RTC_HandleTypeDef *hrtc){
+	hrtc->State = HAL_RTC_STATE_READY;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RTC_DeactivateAlarm(RTC_HandleTypeDef *hrtc, uint32_t Alarm){
+	hrtc->Instance->CRH &= ~RTC_CRH_ALRIE;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RTC_WaitForSynchro(RTC_HandleTypeDef *hrtc){
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RTCEx_SetSecond_IT(RTC_HandleTypeDef *hrtc){
+	hrtc->Instance->CRH |= RTC_CRH_SECIE;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RTCEx_DeactivateSecond(RTC_HandleTypeDef *hrtc){
+	hrtc->Instance->CRH &= ~RTC_CRH_SECIE;
+	return HAL_OK;
+}
+
+uint32_t HAL_RTCEx_BKUPRead(RTC_HandleTypeDef *hrtc, uint32_t BackupRegister){
+	return sim_BKP[BackupRegister] & BKP_DR1_D;
+}
+
+void HAL_RTCEx_BKUPWrite(RTC_HandleTypeDef *hrtc, uint32_t BackupRegister, uint32_t Data){
+	sim_BKP[BackupRegister] = Data & BKP_DR1_D;
+}
+
+HAL_StatusTypeDef HAL_ADC_Init(ADC_HandleTypeDef *hadc){
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_ConfigChannel(ADC_HandleTypeDef *hadc, ADC_ChannelConfTypeDef *sConfig){
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADCEx_Calibration_Start(ADC_HandleTypeDef *hadc){
+	return HAL_OK;
+}
+
+/**
+  * @brief  starts a conversion, the dma writes the simulated value into the buffer at the end
+  * @note   None
+  * @retval HAL_OK
+  */
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef *hadc, uint32_t *pData, uint32_t Length){
+	adc_handle = hadc;
+	adc_target = pData;
+	hadc->DMA_Handle->XferCpltCallback = sim_adc_dma_complete;
+	adc_done = sim_cycles + SIM_ADC_CYCLES;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_Stop(ADC_HandleTypeDef *hadc){
+	adc_done = SIM_NEVER;
+	return HAL_OK;
+}
+
+uint32_t HAL_ADC_GetValue(ADC_HandleTypeDef *hadc){
+	return hadc->Instance->DR;
+}
+
+void HAL_ADC_IRQHandler(ADC_HandleTypeDef *hadc){}
+
+/* ----------------------------------------------------------------------------
+ * simulation engine
+ */
+
+/**
+  * @brief  index of an interrupt in the interrupt tables
+  * @note   None
+  * @retval index
+  */
+static uint8_t irq_index(IRQn_Type irq){
+	return (uint8_t)(irq + SIM_IRQ_OFFSET);
+}
+
+/**
+  * @brief  sets an interrupt pending
+  * @note   None
+  * @retval None
+  */
+static void sim_pend(IRQn_Type irq){
+	irq_pending[irq_index(irq)] = 1;
+}
+
+/**
+  * @brief  checks for an enabled pending interrupt
+  * @note   None
+  * @retval 1 if an interrupt is waiting, else 0
+  */
+static uint8_t sim_irq_waiting(void){
+	for(uint8_t i = 0; i < SIM_IRQ_COUNT; i++){
+		if(irq_pending[i] && irq_enabled[i] && !irq_active[i]){
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/**
+  * @brief  runs the pending interrupts, the lowest priority value first
+  * @note   a running handler is not entered again
+  * @retval None
+  */
+static void sim_dispatch(void){
+	uint8_t next;
+
+	while(!sim_primask){
+		next = SIM_IRQ_COUNT;
+		for(uint8_t i = 0; i < SIM_IRQ_COUNT; i++){
+			if(irq_pending[i] && irq_enabled[i] && !irq_active[i] && irq_vectors[i] != NULL){
+				if(next == SIM_IRQ_COUNT || irq_priority[i] < irq_priority[next]){
+					next = i;
+				}
+			}
+		}
+		if(next == SIM_IRQ_COUNT){
+			return;
+		}
+		irq_pending[next] = 0;
+		irq_active[next] = 1;
+		sim_GPIOB.IDR = pin_levels;
+		sim_clear_exclusive();
+		irq_vectors[next]();
+		sim_clear_exclusive();
+		irq_active[next] = 0;
+	}
+}
+
+/**
+  * @brief  restarts the systick if the firmware has written its reload or counter
+  * @note   a written counter of 0 restarts the period, as on the core. The count flag has been read
+  * 		by the firmware since the last sleep.
+  * @retval None
+  */
+static void sim_sync_systick(void){
+	sim_SysTick.CTRL &= ~SysTick_CTRL_COUNTFLAG_Msk;
+	sim_restart_systick();
+}
+
+/**
+  * @brief  restarts the systick if the firmware has written its reload or counter
+  * @note   no time passes between two sleeps, the counter of a restarted period reads its reload
+  * @retval None
+  */
+static void sim_restart_systick(void){
+	if(!(sim_SysTick.CTRL & SysTick_CTRL_ENABLE_Msk)){
+		systick_next = SIM_NEVER;
+		return;
+	}
+	if(systick_next == SIM_NEVER || sim_SysTick.VAL == 0 || sim_SysTick.LOAD != systick_load){
+		systick_load = sim_SysTick.LOAD;
+		systick_next = sim_cycles + systick_load + 1;
+		sim_SysTick.VAL = systick_load;
+	}
+}
+
+/**
+  * @brief  jumps to the next event and handles all events at that time
+  * @note   exits the simulation at the end time
+  * @retval None
+  */
+static void sim_advance(void){
+	uint64_t next = sim_end;
+
+	if(systick_next < next){
+		next = systick_next;
+	}
+	if(rtc_next < next){
+		next = rtc_next;
+	}
+	if(led_done < next){
+		next = led_done;
+	}
+	if(adc_done < next){
+		next = adc_done;
+	}
+	if(sim_input_next < sim_input_count && sim_inputs[sim_input_next].cycles < next){
+		next = sim_inputs[sim_input_next].cycles;
+	}
+	for(uint8_t i = 0; i < SIM_TIMERS; i++){
+		if(sim_timers[i].running && sim_timers[i].next < next){
+			next = sim_timers[i].next;
+		}
+	}
+	if(next == SIM_NEVER){
+		fprintf(stderr, "sim: the core sleeps without a wakeup source\n");
+		exit(1);
+	}
+	if(next < sim_cycles){
+		next = sim_cycles;
+	}
+	sim_cycles = next;
+	sim_DWT.CYCCNT = (uint32_t)sim_cycles;
+	if(sim_cycles >= sim_end){
+		exit(0);
+	}
+
+	/* the time of the rtc is set after its initialization */
+	if(rtc_time_valid){
+		sim_RTC.CNTH = rtc_time >> 16;
+		sim_RTC.CNTL = rtc_time & 0xFFFF;
+		rtc_time_valid = 0;
+	}
+	if(systick_next == sim_cycles){
+		sim_SysTick.CTRL |= SysTick_CTRL_COUNTFLAG_Msk;
+		if(sim_SysTick.CTRL & SysTick_CTRL_TICKINT_Msk){
+			sim_pend(SysTick_IRQn);
+		}
+		systick_next += (uint64_t)systick_load + 1;
+	}
+	if(systick_next != SIM_NEVER){
+		sim_SysTick.VAL = systick_load - (uint32_t)(sim_cycles - (systick_next - systick_load - 1));
+	}
+	if(rtc_next == sim_cycles){
+		sim_rtc_second();
+		rtc_next += SIM_CORE_CLOCK;
+	}
+	if(led_done == sim_cycles){
+		led_done = SIM_NEVER;
+		sim_DMA1.ISR |= DMA_FLAG_TC7;
+		sim_pend(DMA1_Channel7_IRQn);
+	}
+	if(adc_done == sim_cycles){
+		adc_done = SIM_NEVER;
+		sim_adc_complete();
+	}
+	while(sim_input_next < sim_input_count && sim_inputs[sim_input_next].cycles == sim_cycles){
+		sim_apply_input(&sim_inputs[sim_input_next]);
+		sim_input_next++;
+	}
+	for(uint8_t i = 0; i < SIM_TIMERS; i++){
+		if(sim_timers[i].running && sim_timers[i].next == sim_cycles){
+			sim_timer_update(&sim_timers[i]);
+		}
+	}
+}
+
+/**
+  * @brief  counts the rtc up and raises the second and alarm flags
+  * @note   the alarm reaches the core over exti line 17
+  * @retval None
+  */
+static void sim_rtc_second(void){
+	uint32_t counter = ((sim_RTC.CNTH << 16) | (sim_RTC.CNTL & 0xFFFF)) + 1;
+	uint32_t alarm = (sim_RTC.ALRH << 16) | (sim_RTC.ALRL & 0xFFFF);
+
+	sim_RTC.CNTH = counter >> 16;
+	sim_RTC.CNTL = counter & 0xFFFF;
+	sim_RTC.CRL |= RTC_CRL_SECF | RTC_CRL_RTOFF;
+	if(sim_RTC.CRH & RTC_CRH_SECIE){
+		sim_pend(RTC_IRQn);
+	}
+	if(counter == alarm){
+		sim_RTC.CRL |= RTC_CRL_ALRF;
+		if((sim_RTC.CRH & RTC_CRH_ALRIE) && (sim_EXTI.IMR & (1U << SIM_EXTI_ALARM_LINE))){
+			sim_EXTI.PR |= 1U << SIM_EXTI_ALARM_LINE;
+			sim_pend(RTC_Alarm_IRQn);
+		}
+	}
+}
+
+/**
+  * @brief  update event of a timer, the period is taken from the recent prescaler and reload
+  * @note   the firmware changes the reload of the button timer while it runs
+  * @retval None
+  */
+static void sim_timer_update(Sim_Timer *timer){
+	if(!(timer->instance->CR1 & TIM_CR1_CEN)){
+		timer->running = 0;
+		return;
+	}
+	timer->instance->SR |= TIM_FLAG_UPDATE;
+	if(timer->instance->DIER & TIM_IT_UPDATE){
+		sim_pend(timer->irq);
+	}
+	timer->next = sim_cycles + sim_timer_period(timer->instance);
+}
+
+/**
+  * @brief  period of a timer in core clock cycles
+  * @note   all timers run with 72 MHz
+  * @retval cycles
+  */
+static uint64_t sim_timer_period(TIM_TypeDef *instance){
+	return ((uint64_t)instance->PSC + 1) * ((uint64_t)instance->ARR + 1);
+}
+
+/**
+  * @brief  runs the led transmission of the three dma channels on gpioa odr and samples the data bits
+  * @note   every bit starts high (channel 2), the frame buffer word pulls the 0 bits low early (channel 5),
+  * 		the end of the bit pulls all lines low (channel 7). The transfer complete interrupt follows
+  * 		after the simulated transmission time.
+  * @retval None
+  */
+static void sim_led_transfer(void){
+	const uint16_t *framedata = (const uint16_t *)(uintptr_t)sim_DMA1_Channel[5].CMAR;
+	uint32_t length = sim_DMA1_Channel[5].CNDTR;
+	uint32_t grb[ROW];
+
+	if(length > COL * 24){
+		length = COL * 24;
+	}
+	for(uint32_t bit = 0; bit < length; bit++){
+		sim_GPIOA.ODR = 0xFFFF;
+		sim_GPIOA.ODR = framedata[bit];
+		for(uint8_t row = 0; row < ROW; row++){
+			grb[row] = (grb[row] << 1) | ((sim_GPIOA.ODR >> row) & 0x01);
+		}
+		sim_GPIOA.ODR = 0x0000;
+		if(bit % 24 == 23){
+			for(uint8_t row = 0; row < ROW; row++){
+				sim_frame.rgb[row][bit / 24][0] = (grb[row] >> 8) & 0xFF;
+				sim_frame.rgb[row][bit / 24][1] = (grb[row] >> 16) & 0xFF;
+				sim_frame.rgb[row][bit / 24][2] = grb[row] & 0xFF;
+			}
+		}
+	}
+	sim_frame.ms = (uint32_t)(sim_cycles / SIM_CYCLES_PER_MS);
+	if(sim_frame_callback != NULL){
+		sim_frame_callback(&sim_frame);
+	}
+	sim_frame.index++;
+	led_done = sim_cycles + (uint64_t)length * SIM_LED_BIT_CYCLES;
+}
+
+/**
+  * @brief  end of a light sensor conversion, the dma interrupt calls the conversion complete callback
+  * @note   None
+  * @retval None
+  */
+static void sim_adc_complete(void){
+	sim_ADC1.DR = adc_value;
+	if(adc_target != NULL){
+		*adc_target = adc_value;
+	}
+	sim_pend(DMA1_Channel1_IRQn);
+}
+
+/**
+  * @brief  complete callback of the adc dma, as registered by the hal adc driver
+  * @note   None
+  * @retval None
+  */
+static void sim_adc_dma_complete(DMA_HandleTypeDef *hdma){
+	HAL_ADC_ConvCpltCallback(adc_handle);
+}
+
+/**
+  * @brief  inserts an input into the script, sorted by the time
+  * @note   inputs of the same time keep the order in which they have been added
+  * @retval input, NULL if the script is full
+  */
+static Sim_Input* sim_input_insert(uint32_t ms){
+	uint64_t cycles = (uint64_t)ms * SIM_CYCLES_PER_MS;
+	uint16_t index = sim_input_count;
+
+	if(sim_input_count >= SIM_INPUT_LENGTH){
+		return NULL;
+	}
+	while(index > sim_input_next && sim_inputs[index - 1].cycles > cycles){
+		sim_inputs[index] = sim_inputs[index - 1];
+		index--;
+	}
+	sim_inputs[index].cycles = cycles;
+	sim_input_count++;
+	return &sim_inputs[index];
+}
+
+/**
+  * @brief  applies an input, a pin change raises its exti line on an enabled edge
+  * @note   None
+  * @retval None
+  */
+static void sim_apply_input(Sim_Input *input){
+	uint8_t level = (pin_levels & input->pin) != 0;
+
+	if(input->type == SIM_INPUT_ADC){
+		adc_value = input->pin;
+		return;
+	}
+	if(input->type == SIM_INPUT_RECORD){
+		record_replay_entry(&input->record);
+		return;
+	}
+	if(level == input->level){
+		return;
+	}
+	sim_set_pin(input->pin, input->level);
+	if(!(sim_EXTI.IMR & input->pin)){
+		return;
+	}
+	if((input->level && (sim_EXTI.RTSR & input->pin)) || (!input->level && (sim_EXTI.FTSR & input->pin))){
+		sim_EXTI.PR |= input->pin;
+		sim_pend(sim_exti_irq(input->pin));
+	}
+}
+
+/**
+  * @brief  interrupt of an exti line
+  * @note   None
+  * @retval interrupt
+  */
+static IRQn_Type sim_exti_irq(uint16_t pin){
+	switch(pin){
+		case GPIO_PIN_0:	return EXTI0_IRQn;
+		case GPIO_PIN_1:	return EXTI1_IRQn;
+		case GPIO_PIN_2:	return EXTI2_IRQn;
+		default:			return EXTI15_10_IRQn;
+	}
+}
@@ -0,0 +1,311 @@
+/*
+ * Autor: Nico Korn
+ * Date: 19.10.2026
+ * Firmware for a alarmlcock with custom made STM32F103 microcontroller board.
+ *  *
+ * Copyright (c) 2026 Nico Korn
+ *
+ * sim_main.c this module contents the command line of the host simulation
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+
+
+
+// ----------------------------------------------------------------------------
+
+#include "sim.h"
+#include "button.h"
+#include "latency.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* defines */
+#define SIM_DEFAULT_SECONDS		10
+#define SIM_DEFAULT_HOLD		100		// ms a scripted button is pushed
+#define SIM_LINE_LENGTH			128
+
+/* private variables */
+static const char				*record_type_names[RECORD_TYPE_COUNT] = {"pin", "event", "rtc", "alarm", "adc", "frame"};
+static const char				*latency_event_names[LATENCY_EVENT_COUNT] = {"mode", "plus", "minus", "snooze", "snooze double", "switch"};
+static const char				*event_type_names[EVENT_TYPE_COUNT] = {"none", "press", "long press", "repeat", "double click",
+																		"switch", "beep", "done"};
+static uint32_t					event_dispatched[EVENT_TYPE_COUNT];
+
+/* global variables */
+extern Alarmclock				alarmclock;
+
+/* private functions */
+static void usage(const char *name);
+static uint16_t parse_button(const char *name);
+static uint8_t parse_press(const char *argument);
+static uint8_t parse_switch(const char *argument);
+static uint8_t parse_time(const char *argument, uint32_t *seconds);
+static uint8_t parse_replay(const char *argument);
+static void report(void);
+static void report_event(const Event *event);
+
+
+
+/**
+  * @brief  runs the firmware with the simulated peripherals until the end time
+  * @note   the simulation exits in the sleep of the firmware, see sim_hal.c
+  * @retval exit code
+  */
+int main(int argc, char **argv){
+	uint32_t seconds = SIM_DEFAULT_SECONDS;
+	uint32_t time;
+
+	sim_reset();
+	for(int i = 1; i < argc; i++){
+		if(strcmp(argv[i], "--seconds") == 0 && i + 1 < argc){
+			seconds = strtoul(argv[++i], NULL, 0);
+		}else if(strcmp(argv[i], "--ppm") == 0 && i + 1 < argc){
+			sim_frame_set_ppm(argv[++i]);
+		}else if(strcmp(argv[i], "--ansi") == 0){
+			sim_frame_set_ansi(1);
+		}else if(strcmp(argv[i], "--changes") == 0){
+			sim_frame_set_changes_only(1);
+		}else if(strcmp(argv[i], "--gain") == 0 && i + 1 < argc){
+			sim_frame_set_gain((uint8_t)strtoul(argv[++i], NULL, 0));
+		}else if(strcmp(argv[i], "--adc") == 0 && i + 1 < argc){
+			sim_set_adc((uint16_t)strtoul(argv[++i], NULL, 0));
+		}else if(strcmp(argv[i], "--time") == 0 && i + 1 < argc && parse_time(argv[i + 1], &time)){
+			sim_set_time(time);
+			i++;
+		}else if(strcmp(argv[i], "--press") == 0 && i + 1 < argc && parse_press(argv[i + 1])){
+			i++;
+		}else if(strcmp(argv[i], "--switch") == 0 && i + 1 < argc && parse_switch(argv[i + 1])){
+			i++;
+		}else if(strcmp(argv[i], "--replay") == 0 && i + 1 < argc && parse_replay(argv[i + 1])){
+			i++;
+		}else if(strcmp(argv[i], "--report") == 0){
+			/* subscribed before the firmware, it sees the events first */
+			event_subscribe(EVENT_TYPE_ALL, EVENT_SOURCE_ALL, report_event);
+			atexit(report);
+		}else{
+			usage(argv[0]);
+			return 1;
+		}
+	}
+	sim_set_end(seconds * 1000U);
+	sim_set_frame_callback(sim_frame_output);
+	/* the replayed alarms start the buzzer of the firmware */
+	record_replay_start(NULL, 0, &alarmclock);
+	firmware_main();
+	return 0;
+}
+
+/**
+  * @brief  prints the options
+  * @note   None
+  * @retval None
+  */
+static void usage(const char *name){
+	fprintf(stderr,
+			"usage: %s [options]\n"
+			"  --seconds N                     simulated time, default %u s\n"
+			"  --ppm DIR                       write every frame as DIR/frame_NNNNNN.ppm\n"
+			"  --ansi                          print every frame with ansi colors\n"
+			"  --changes                       skip frames equal to the previous frame\n"
+			"  --gain N                        multiply the led values for the output\n"
+			"  --adc N                         value of the light sensor, 0..4095\n"
+			"  --time HH:MM[:SS]               time of the rtc at the start\n"
+			"  --press BUTTON@MS[:HOLD]        push mode, plus, minus or snooze at MS for HOLD ms\n"
+			"  --switch on|off@MS              change the alarm switch at MS\n"
+			"  --replay FILE[@MS]              replay a recording from tools/record_decode.py, its first record at MS\n"
+			"  --report                        print the frame intervals, the button latencies and the events at the end\n",
+			name, SIM_DEFAULT_SECONDS);
+}
+
+/**
+  * @brief  pin of a button name
+  * @note   None
+  * @retval pin, 0 if the name is unknown
+  */
+static uint16_t parse_button(const char *name){
+	if(strcmp(name, "mode") == 0){
+		return BUTTON_MODE;
+	}else if(strcmp(name, "plus") == 0){
+		return BUTTON_PLUS;
+	}else if(strcmp(name, "minus") == 0){
+		return BUTTON_MINUS;
+	}else if(strcmp(name, "snooze") == 0){
+		return BUTTON_SNOOZE;
+	}
+	return 0;
+}
+
+/**
+  * @brief  adds a button push, the buttons are low active
+  * @note   None
+  * @retval 1 if the argument is valid, else 0
+  */
+static uint8_t parse_press(const char *argument){
+	char name[16];
+	unsigned ms;
+	unsigned hold = SIM_DEFAULT_HOLD;
+	uint16_t pin;
+
+	if(sscanf(argument, "%15[a-z]@%u:%u", name, &ms, &hold) < 2){
+		return 0;
+	}
+	pin = parse_button(name);
+	if(pin == 0){
+		return 0;
+	}
+	return sim_input_at(ms, pin, 0) && sim_input_at(ms + hold, pin, 1);
+}
+
+/**
+  * @brief  adds a change of the alarm switch, the pin is high if the alarm is on
+  * @note   None
+  * @retval 1 if the argument is valid, else 0
+  */
+static uint8_t parse_switch(const char *argument){
+	char state[4];
+	unsigned ms;
+
+	if(sscanf(argument, "%3[a-z]@%u", state, &ms) != 2){
+		return 0;
+	}
+	if(strcmp(state, "on") == 0){
+		return sim_input_at(ms, SWITCH_ALARM, 1);
+	}else if(strcmp(state, "off") == 0){
+		return sim_input_at(ms, SWITCH_ALARM, 0);
+	}
+	return 0;
+}
+
+/**
+  * @brief  parses a time of the day
+  * @note   None
+  * @retval 1 if the argument is valid, else 0
+  */
+static uint8_t parse_time(const char *argument, uint32_t *seconds){
+	unsigned hours, minutes, secs = 0;
+
+	if(sscanf(argument, "%u:%u:%u", &hours, &minutes, &secs) < 2 || hours > 23 || minutes > 59 || secs > 59){
+		return 0;
+	}
+	*seconds = hours * 3600U + minutes * 60U + secs;
+	return 1;
+}
+
+/**
+  * @brief  schedules the records of a recording, one record per line: ms type value
+  * @note   the pin, adc, rtc and alarm records are replayed, the event and frame records are the results
+  * 		of the replay. Lines starting with # are comments.
+  * @retval 1 if the file has been read, else 0
+  */
+static uint8_t parse_replay(const char *argument){
+	char path[SIM_LINE_LENGTH];
+	char line[SIM_LINE_LENGTH];
+	char type[16];
+	unsigned offset = 0;
+	unsigned long ms, value, first = 0;
+	uint8_t have_first = 0;
+	Record_Entry record;
+	FILE *file;
+
+	if(sscanf(argument, "%127[^@]@%u", path, &offset) < 1){
+		return 0;
+	}
+	file = fopen(path, "r");
+	if(file == NULL){
+		perror(path);
+		return 0;
+	}
+	while(fgets(line, sizeof(line), file) != NULL){
+		if(line[0] == '#' || sscanf(line, "%lu %15s %li", &ms, type, (long*)&value) != 3){
+			continue;
+		}
+		if(!have_first){
+			first = ms;
+			have_first = 1;
+		}
+		record.ms = ms - first + offset;
+		record.value = value;
+		for(record.type = 0; record.type < RECORD_TYPE_COUNT; record.type++){
+			if(strcmp(type, record_type_names[record.type]) == 0){
+				break;
+			}
+		}
+		switch(record.type){
+			case RECORD_TYPE_PIN:
+				sim_input_at(record.ms, value & ~RECORD_PIN_LEVEL, (value & RECORD_PIN_LEVEL) != 0);
+			break;
+			case RECORD_TYPE_ADC:
+				sim_adc_at(record.ms, value);
+			break;
+			case RECORD_TYPE_RTC:
+			case RECORD_TYPE_ALARM:
+				sim_record_at(record.ms, &record);
+			break;
+			default:
+			break;
+		}
+	}
+	fclose(file);
+	return 1;
+}
+
+/**
+  * @brief  prints the frame intervals, the button to photon latencies and the event counters of the run to stderr
+  * @note   called at the exit of the simulation
+  * @retval None
+  */
+static void report(void){
+	Latency_Stats *stats;
+	uint32_t total;
+
+	sim_frame_report();
+	for(uint8_t event = 0; event < LATENCY_EVENT_COUNT; event++){
+		stats = latency_get_stats(event);
+		if(stats->count == 0){
+			continue;
+		}
+		total = 0;
+		for(uint8_t stage = 0; stage < LATENCY_STAGE_COUNT; stage++){
+			total += stats->stage_sum[stage];
+		}
+		fprintf(stderr, "latency %s: %u events, mean %u us, max %u us\n", latency_event_names[event],
+				(unsigned)stats->count, (unsigned)(total / stats->count), (unsigned)stats->max);
+	}
+	fprintf(stderr, "latency dropped: %u\n", (unsigned)latency_get_dropped());
+	fprintf(stderr, "events: %u coalesced, %u dropped, high watermark %u\n", (unsigned)event_get_stats()->coalesced,
+			(unsigned)event_get_stats()->dropped, (unsigned)event_get_stats()->high_watermark);
+	for(uint8_t type = 0; type < EVENT_TYPE_COUNT; type++){
+		if(event_dispatched[type] != 0){
+			fprintf(stderr, "events %s: %u dispatched\n", event_type_names[type], (unsigned)event_dispatched[type]);
+		}
+	}
+}
+
+/**
+  * @brief  counts the dispatched events of every type
+  * @note   subscriber of all events
+  * @retval None
+  */
+static void report_event(const Event *event){
+	event_dispatched[event->type]++;
+}
@@ -0,0 +1,238 @@
+/*
+ * Autor: Nico Korn
+ * Date: 19.10.2026
+ * Firmware for a alarmlcock with custom made STM32F103 microcontroller board.
+ *  *
+ * Copyright (c) 2026 Nico Korn
+ *
+ * sim_stress.c this module contents the stress test of the event queue with preempting producers
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+
+
+
+// ----------------------------------------------------------------------------
+
+#include "sim.h"
+#include "event.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <sys/time.h>
+
+/* defines */
+#define STRESS_SECONDS			2
+#define STRESS_PRODUCERS		5
+#define STRESS_COUNTER_MASK		0xFFFF		// the counter of the producer is the payload, the producer is the source
+#define STRESS_TIMER_US			37			// period of the timer signal
+#define STRESS_PROFILE_US		53			// period of the profiling signal, in cpu time
+#define STRESS_HOOK_CHANCE		8			// 1 of n load exclusives is preempted by the hook producer
+#define STRESS_BURST			24			// events of a main loop burst, more than the queue holds
+
+/*
+* @brief  enumeration producers, every producer runs in its own context
+  */
+typedef enum
+{
+	STRESS_PRODUCER_NONE,
+	STRESS_PRODUCER_TIMER,					// SIGALRM, like the button timer interrupt, its repeats are coalesced
+	STRESS_PRODUCER_PROFILE,				// SIGPROF, preempts the timer producer, like the exti interrupt
+	STRESS_PRODUCER_MAIN,					// the main loop, like the ticker and the replay
+	STRESS_PRODUCER_HOOK					// between ldrex and strex of any other producer
+}Stress_Producer;
+
+/* private variables */
+static volatile uint32_t		queued[STRESS_PRODUCERS];
+static volatile uint32_t		full[STRESS_PRODUCERS];
+static uint32_t					consumed[STRESS_PRODUCERS];			// events including the merged ones
+static uint32_t					merged;
+static uint32_t					errors;
+static volatile uint8_t			hook_active;
+static uint32_t					hook_random = 0x12345678;
+
+/* global variables */
+Alarmclock						alarmclock;					// defined by main.c in the firmware, used by the interrupt handlers
+
+/* private functions */
+static void produce(Stress_Producer producer);
+static void consume(void);
+static void timer_handler(int signal);
+static void hook(void);
+static void start_timers(uint8_t enable);
+
+
+
+/**
+  * @brief  queues events from preempting producers and checks that every queued event is unqueued once
+  * 		and in the order of its producer, or has been merged into a later one
+  * @note   the signals preempt at random instructions, the hook preempts between ldrex and strex
+  * @retval 0 if no error has been found, else 1
+  */
+int main(int argc, char **argv){
+	struct sigaction action = {0};
+	struct timeval start, now;
+	uint32_t seconds = argc > 1 ? strtoul(argv[1], NULL, 0) : STRESS_SECONDS;
+	uint32_t total = 0;
+	uint32_t total_full = 0;
+
+	event_coalesce(EVENT_TYPE_REPEAT, EVENT_SOURCE_NONE);
+	init_event_engine();
+	action.sa_handler = timer_handler;
+	sigemptyset(&action.sa_mask);
+	sigaction(SIGALRM, &action, NULL);
+	sigaction(SIGPROF, &action, NULL);
+	sim_set_exclusive_hook(hook);
+	start_timers(1);
+
+	gettimeofday(&start, NULL);
+	do{
+		for(uint8_t i = 0; i < STRESS_BURST; i++){
+			produce(STRESS_PRODUCER_MAIN);
+		}
+		consume();
+		gettimeofday(&now, NULL);
+	}while((uint32_t)(now.tv_sec - start.tv_sec) < seconds);
+
+	start_timers(0);
+	sim_set_exclusive_hook(NULL);
+	consume();
+
+	for(uint8_t producer = STRESS_PRODUCER_TIMER; producer < STRESS_PRODUCERS; producer++){
+		printf("producer %u: %u queued, %u full, %u unqueued\n", producer, (unsigned)queued[producer],
+				(unsigned)full[producer], (unsigned)consumed[producer]);
+		if(queued[producer] != consumed[producer]){
+			errors++;
+		}
+		total += queued[producer];
+		total_full += full[producer];
+	}
+	if(merged != event_get_stats()->coalesced || total_full != event_get_stats()->dropped){
+		printf("counters: %u skipped, %u coalesced, %u full, %u dropped\n", (unsigned)merged,
+				(unsigned)event_get_stats()->coalesced, (unsigned)total_full, (unsigned)event_get_stats()->dropped);
+		errors++;
+	}
+	printf("%u events, %u coalesced, %u dropped, high watermark %u, %u errors\n", (unsigned)total,
+			(unsigned)event_get_stats()->coalesced, (unsigned)event_get_stats()->dropped,
+			(unsigned)event_get_stats()->high_watermark, (unsigned)errors);
+	return errors != 0;
+}
+
+/**
+  * @brief  queues the next event of a producer
+  * @note   the counter of the producer is only counted up if the event has been queued
+  * @retval None
+  */
+static void produce(Stress_Producer producer){
+	Event_Type type = producer == STRESS_PRODUCER_TIMER ? EVENT_TYPE_REPEAT : EVENT_TYPE_PRESS;
+
+	if(queue_event(type, (Event_Source)producer, queued[producer] & STRESS_COUNTER_MASK)){
+		queued[producer]++;
+	}else{
+		full[producer]++;
+	}
+}
+
+/**
+  * @brief  unqueues all events and checks the order of every producer
+  * @note   the events of the timer producer may skip the merged ones
+  * @retval None
+  */
+static void consume(void){
+	Event event;
+	uint8_t producer;
+
+	uint16_t skipped;
+
+	while(unqueue_event(&event)){
+		producer = event.source;
+		if(producer == STRESS_PRODUCER_NONE || producer >= STRESS_PRODUCERS
+				|| event.type != (producer == STRESS_PRODUCER_TIMER ? EVENT_TYPE_REPEAT : EVENT_TYPE_PRESS)){
+			printf("invalid event %u of %u\n", event.type, event.source);
+			errors++;
+			continue;
+		}
+		/* a coalesced event is the latest of the merged ones, the others are skipped */
+		skipped = (event.payload - consumed[producer]) & STRESS_COUNTER_MASK;
+		if((skipped != 0 && producer != STRESS_PRODUCER_TIMER) || skipped > STRESS_COUNTER_MASK / 2){
+			printf("producer %u: event %u instead of %u\n", producer, event.payload,
+					(unsigned)(consumed[producer] & STRESS_COUNTER_MASK));
+			errors++;
+		}else{
+			consumed[producer] += skipped;
+			merged += skipped;
+		}
+		consumed[producer]++;
+	}
+}
+
+/**
+  * @brief  the signals are the interrupts of the test, the exclusive monitor is cleared on entry and exit
+  * @note   a signal is lost while the interrupts are disabled
+  * @retval None
+  */
+static void timer_handler(int signal){
+	if(__get_PRIMASK()){
+		return;
+	}
+	sim_clear_exclusive();
+	produce(signal == SIGALRM ? STRESS_PRODUCER_TIMER : STRESS_PRODUCER_PROFILE);
+	sim_clear_exclusive();
+}
+
+/**
+  * @brief  called between ldrex and strex, preempts the producer with another producer
+  * @note   the hook producer does not preempt itself
+  * @retval None
+  */
+static void hook(void){
+	if(hook_active || __get_PRIMASK()){
+		return;
+	}
+	hook_active = 1;
+	hook_random = hook_random * 1103515245U + 12345U;
+	if((hook_random >> 16) % STRESS_HOOK_CHANCE == 0){
+		sim_clear_exclusive();
+		produce(STRESS_PRODUCER_HOOK);
+		sim_clear_exclusive();
+	}
+	hook_active = 0;
+}
+
+/**
+  * @brief  starts or stops the timer and the profiling signals
+  * @note   None
+  * @retval None
+  */
+static void start_timers(uint8_t enable){
+	struct itimerval timer = {0};
+
+	if(enable){
+		timer.it_interval.tv_usec = STRESS_TIMER_US;
+		timer.it_value.tv_usec = STRESS_TIMER_US;
+	}
+	setitimer(ITIMER_REAL, &timer, NULL);
+	if(enable){
+		timer.it_interval.tv_usec = STRESS_PROFILE_US;
+		timer.it_value.tv_usec = STRESS_PROFILE_US;
+	}
+	setitimer(ITIMER_PROF, &timer, NULL);
+}
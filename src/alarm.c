@@ -0,0 +1,352 @@
+/*
+ * Autor: Nico Korn
+ * Date: 19.10.2026
+ * Firmware for a alarmlcock with custom made STM32F103 microcontroller board.
+ *  *
+ * Copyright (c) 2026 Nico Korn
+ *
+ * alarm.c this module contents the alarm table with weekday rules
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+
+
+
+// ----------------------------------------------------------------------------
+
+#include "alarm.h"
+
+/* defines */
+#define ALARM_NOT_QUEUED			0xFF		// heap position of an alarm which is not scheduled
+#define ALARM_BKP_VALID				0x8000		// marks a stored alarm rule, older firmware stored 0 in BKP_DR8
+
+/* private variables */
+static Alarm				alarm_table[ALARM_COUNT];
+static uint8_t				alarm_heap[ALARM_COUNT];		// indices of the scheduled alarms, min heap on the next ring
+static uint8_t				alarm_position[ALARM_COUNT];	// position of an alarm in the heap
+static uint8_t				alarm_heap_size;
+
+/* global variables */
+extern RTC_HandleTypeDef 	RTC_Handle;
+
+/* private functions */
+static uint32_t alarm_calculate_next(Alarm *alarm, uint32_t now);
+static void alarm_heap_swap(uint8_t a, uint8_t b);
+static void alarm_heap_up(uint8_t position);
+static void alarm_heap_down(uint8_t position);
+static void alarm_heap_insert(uint8_t index);
+static void alarm_heap_remove(uint8_t index);
+static void alarm_save(uint8_t index);
+static void alarm_load(uint8_t index);
+
+
+
+/**
+  * @brief  initializes the alarm table and loads the stored alarm rules
+  * @note   the alarms are scheduled with alarm_set_time() or alarm_schedule()
+  * @retval None
+  */
+void init_alarm(void){
+	alarm_heap_size = 0;
+	for(uint8_t i = 0; i < ALARM_COUNT; i++){
+		alarm_position[i] = ALARM_NOT_QUEUED;
+		alarm_load(i);
+	}
+}
+
+/**
+  * @brief  sets time and rule of an alarm and schedules it
+  * @note   O(log n)
+  * @retval None
+  */
+void alarm_set(uint8_t index, uint8_t hours, uint8_t minutes, uint8_t weekdays, uint8_t flags, uint32_t now){
+	Alarm *alarm = &alarm_table[index];
+
+	alarm_heap_remove(index);
+	alarm->hours = hours;
+	alarm->minutes = minutes;
+	alarm->weekdays = weekdays;
+	alarm->flags = flags;
+	if(alarm->flags & ALARM_FLAG_ENABLED){
+		alarm->next = alarm_calculate_next(alarm, now);
+		alarm_heap_insert(index);
+	}
+	alarm_save(index);
+}
+
+/**
+  * @brief  sets the time of an alarm, the rule is kept
+  * @note   None
+  * @retval None
+  */
+void alarm_set_time(uint8_t index, uint8_t hours, uint8_t minutes, uint32_t now){
+	alarm_set(index, hours, minutes, alarm_table[index].weekdays, alarm_table[index].flags, now);
+}
+
+/**
+  * @brief  disables an alarm
+  * @note   None
+  * @retval None
+  */
+void alarm_disable(uint8_t index){
+	Alarm *alarm = &alarm_table[index];
+
+	alarm_set(index, alarm->hours, alarm->minutes, alarm->weekdays, alarm->flags & ~ALARM_FLAG_ENABLED, 0);
+}
+
+/**
+  * @brief  skips the next ring of an alarm
+  * @note   the alarm stays scheduled, it is silent once and rescheduled afterwards
+  * @retval None
+  */
+void alarm_skip_next(uint8_t index, uint32_t now){
+	Alarm *alarm = &alarm_table[index];
+
+	alarm_set(index, alarm->hours, alarm->minutes, alarm->weekdays, alarm->flags | ALARM_FLAG_SKIP_NEXT, now);
+}
+
+/**
+  * @brief  calculates the next ring of all enabled alarms
+  * @note   used after the time has been set
+  * @retval None
+  */
+void alarm_schedule(uint32_t now){
+	alarm_heap_size = 0;
+	for(uint8_t i = 0; i < ALARM_COUNT; i++){
+		alarm_position[i] = ALARM_NOT_QUEUED;
+		if(alarm_table[i].flags & ALARM_FLAG_ENABLED){
+			alarm_table[i].next = alarm_calculate_next(&alarm_table[i], now);
+			alarm_heap_insert(i);
+		}
+	}
+}
+
+/**
+  * @brief  returns the next ring of all alarms
+  * @note   O(1), the next alarm is on top of the heap
+  * @retval seconds since the epoch or ALARM_NONE
+  */
+uint32_t alarm_next(void){
+	if(alarm_heap_size == 0){
+		return ALARM_NONE;
+	}
+	return alarm_table[alarm_heap[0]].next;
+}
+
+/**
+  * @brief  handles the due alarms, called from the rtc alarm interrupt
+  * @note   repeating alarms are rescheduled, one shot alarms are disabled after they rang
+  * @retval 1 if an alarm shall ring, 0 if all due alarms have been skipped
+  */
+uint8_t alarm_fired(uint32_t now){
+	uint8_t ring = 0;
+	uint8_t index;
+	Alarm *alarm;
+
+	while(alarm_heap_size > 0 && alarm_table[alarm_heap[0]].next <= now){
+		index = alarm_heap[0];
+		alarm = &alarm_table[index];
+		if(alarm->flags & ALARM_FLAG_SKIP_NEXT){
+			alarm->flags &= ~ALARM_FLAG_SKIP_NEXT;
+		}else{
+			ring = 1;
+			if(alarm->flags & ALARM_FLAG_ONESHOT){
+				alarm->flags &= ~ALARM_FLAG_ENABLED;
+			}
+		}
+		alarm_heap_remove(index);
+		if(alarm->flags & ALARM_FLAG_ENABLED){
+			alarm->next = alarm_calculate_next(alarm, now);
+			alarm_heap_insert(index);
+		}
+		alarm_save(index);
+	}
+	return ring;
+}
+
+/**
+  * @brief  returns an alarm of the table
+  * @note   the alarm must be changed with alarm_set()
+  * @retval pointer to the alarm
+  */
+Alarm* alarm_get(uint8_t index){
+	return &alarm_table[index];
+}
+
+/**
+  * @brief  calculates the first ring of an alarm after now
+  * @note   an empty weekday mask rings on any day
+  * @retval seconds since the epoch
+  */
+static uint32_t alarm_calculate_next(Alarm *alarm, uint32_t now){
+	uint32_t day = now / TIMEBASE_SECONDS_PER_DAY;
+	uint32_t next;
+	uint8_t weekdays = alarm->weekdays ? alarm->weekdays : ALARM_EVERY_DAY;
+
+	for(uint8_t i = 0; i < 8; i++){
+		next = (day + i) * TIMEBASE_SECONDS_PER_DAY + alarm->hours * 3600U + alarm->minutes * 60U;
+		if(next > now && (weekdays & (1 << ((day + i + TIMEBASE_EPOCH_WEEKDAY) % 7)))){
+			return next;
+		}
+	}
+	return ALARM_NONE;
+}
+
+/**
+  * @brief  swaps two heap positions
+  * @note   None
+  * @retval None
+  */
+static void alarm_heap_swap(uint8_t a, uint8_t b){
+	uint8_t index = alarm_heap[a];
+
+	alarm_heap[a] = alarm_heap[b];
+	alarm_heap[b] = index;
+	alarm_position[alarm_heap[a]] = a;
+	alarm_position[alarm_heap[b]] = b;
+}
+
+/**
+  * @brief  moves an alarm up in the heap until its parent rings earlier
+  * @note   None
+  * @retval None
+  */
+static void alarm_heap_up(uint8_t position){
+	uint8_t parent;
+
+	while(position > 0){
+		parent = (position - 1) / 2;
+		if(alarm_table[alarm_heap[parent]].next <= alarm_table[alarm_heap[position]].next){
+			break;
+		}
+		alarm_heap_swap(position, parent);
+		position = parent;
+	}
+}
+
+/**
+  * @brief  moves an alarm down in the heap until its children ring later
+  * @note   None
+  * @retval None
+  */
+static void alarm_heap_down(uint8_t position){
+	uint8_t child;
+
+	while((child = 2*position + 1) < alarm_heap_size){
+		if(child + 1 < alarm_heap_size && alarm_table[alarm_heap[child + 1]].next < alarm_table[alarm_heap[child]].next){
+			child++;
+		}
+		if(alarm_table[alarm_heap[position]].next <= alarm_table[alarm_heap[child]].next){
+			break;
+		}
+		alarm_heap_swap(position, child);
+		position = child;
+	}
+}
+
+/**
+  * @brief  inserts an alarm into the heap
+  * @note   O(log n)
+  * @retval None
+  */
+static void alarm_heap_insert(uint8_t index){
+	alarm_heap[alarm_heap_size] = index;
+	alarm_position[index] = alarm_heap_size;
+	alarm_heap_size++;
+	alarm_heap_up(alarm_position[index]);
+}
+
+/**
+  * @brief  removes an alarm from the heap, nothing happens if the alarm is not in the heap
+  * @note   O(log n)
+  * @retval None
+  */
+static void alarm_heap_remove(uint8_t index){
+	uint8_t position = alarm_position[index];
+
+	if(position == ALARM_NOT_QUEUED){
+		return;
+	}
+	alarm_heap_size--;
+	if(position != alarm_heap_size){
+		alarm_heap_swap(position, alarm_heap_size);
+		alarm_heap_down(position);
+		alarm_heap_up(position);
+	}
+	alarm_position[index] = ALARM_NOT_QUEUED;
+}
+
+/**
+  * @brief  stores time and rule of an alarm in the backup registers
+  * @note   None
+  * @retval None
+  */
+static void alarm_save(uint8_t index){
+	Alarm *alarm = &alarm_table[index];
+	uint32_t rule = ALARM_BKP_VALID | (alarm->flags << 8) | alarm->weekdays;
+
+	if(index == 0){
+		HAL_RTCEx_BKUPWrite(&RTC_Handle, RTC_BKP_DR6, alarm->hours);
+		HAL_RTCEx_BKUPWrite(&RTC_Handle, RTC_BKP_DR7, alarm->minutes);
+		HAL_RTCEx_BKUPWrite(&RTC_Handle, RTC_BKP_DR8, rule);
+	}
+	#ifdef ALARM_BKP_EXTENDED
+	else{
+		HAL_RTCEx_BKUPWrite(&RTC_Handle, RTC_BKP_DR11 + 2*(index-1), (alarm->hours << 8) | alarm->minutes);
+		HAL_RTCEx_BKUPWrite(&RTC_Handle, RTC_BKP_DR12 + 2*(index-1), rule);
+	}
+	#endif
+}
+
+/**
+  * @brief  loads time and rule of an alarm from the backup registers
+  * @note   alarm 0 of older firmware rings every day, the other alarms are disabled by default
+  * @retval None
+  */
+static void alarm_load(uint8_t index){
+	Alarm *alarm = &alarm_table[index];
+	uint32_t rule = 0;
+
+	alarm->hours = 0;
+	alarm->minutes = 0;
+	if(index == 0){
+		alarm->hours = HAL_RTCEx_BKUPRead(&RTC_Handle, RTC_BKP_DR6) & 0xFF;
+		alarm->minutes = HAL_RTCEx_BKUPRead(&RTC_Handle, RTC_BKP_DR7) & 0xFF;
+		rule = HAL_RTCEx_BKUPRead(&RTC_Handle, RTC_BKP_DR8);
+		if(!(rule & ALARM_BKP_VALID)){
+			rule = ALARM_BKP_VALID | (ALARM_FLAG_ENABLED << 8) | ALARM_EVERY_DAY;
+		}
+	}
+	#ifdef ALARM_BKP_EXTENDED
+	else{
+		alarm->hours = HAL_RTCEx_BKUPRead(&RTC_Handle, RTC_BKP_DR11 + 2*(index-1)) >> 8;
+		alarm->minutes = HAL_RTCEx_BKUPRead(&RTC_Handle, RTC_BKP_DR11 + 2*(index-1)) & 0xFF;
+		rule = HAL_RTCEx_BKUPRead(&RTC_Handle, RTC_BKP_DR12 + 2*(index-1));
+	}
+	#endif
+	if(rule & ALARM_BKP_VALID){
+		alarm->weekdays = rule & 0x7F;
+		alarm->flags = (rule >> 8) & 0x7F;
+	}else{
+		alarm->weekdays = ALARM_EVERY_DAY;
+		alarm->flags = 0;
+	}
+}
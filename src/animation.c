@@ -0,0 +1,161 @@
+/*
+ * Autor: Nico Korn
+ * Date: 19.10.2026
+ * Firmware for a alarmlcock with custom made STM32F103 microcontroller board.
+ *  *
+ * Copyright (c) 2026 Nico Korn
+ *
+ * animation.c this module contents the streaming decoder for the compressed animation assets in flash.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+
+
+
+// ----------------------------------------------------------------------------
+
+#include "animation.h"
+
+/* private variables */
+static const uint8_t		*animation_position;		// decoder position in the running animation, one animation runs at a time
+static uint16_t				*animation_ambient_factor;
+
+/* private functions */
+static void animation_effect_init(Effect *effect);
+static void animation_effect_step(Effect *effect);
+static uint8_t animation_effect_done(Effect *effect);
+
+/* private effects */
+static Effect				animation_effect_sunrise = {"sunrise", EFFECT_CLASS_ALARM, animation_effect_init, animation_effect_step, animation_effect_done, 0, 0, (void*)animation_sunrise};
+
+/**
+  * @brief  initialization of the animations
+  * @note   registers the animation effects, has to be called before the alarm style is loaded
+  * @param  ambient light factor of the light sensor, the animation effects are scaled with it
+  * @retval None
+  */
+void init_animation(uint16_t *ambient_factor){
+	animation_position = NULL;
+	animation_ambient_factor = ambient_factor;
+	if(!effect_register(&animation_effect_sunrise)){
+		/* the registry is full, increase EFFECT_REGISTRY_LENGTH */
+		while(1){
+			//error
+		}
+	}
+}
+
+/**
+  * @brief  checks the header of an animation asset
+  * @note   None
+  * @retval 1 if the animation can be decoded, else 0
+  */
+uint8_t animation_valid(const uint8_t *animation){
+	return animation[0] == ANIMATION_VERSION && animation[1] > 0 && animation[1] <= 64 && animation[2] > 0 && animation[3] > 0;
+}
+
+/**
+  * @brief  decodes one frame of an animation straight into the frame buffer
+  * @note   delta frames only write the changed pixels, the frame buffer has to contain the previous frame.
+  * 		The palette colors are scaled with the ambient light factor like the numbers, they are shown as
+  * 		they are at ANIMATION_AMBIENT_FULL.
+  * @param  animation asset, position of the frame in the asset which is moved to the next frame, ambient light factor
+  * @retval 0 if the frame is decoded, 1 if the frame is corrupt
+  */
+uint8_t animation_decode_frame(const uint8_t *animation, const uint8_t **position, uint16_t *ambient_factor){
+	const uint8_t *palette = &animation[ANIMATION_HEADER_SIZE];
+	const uint8_t *stream = *position;
+	const uint8_t *color;
+	uint8_t red, green, blue;
+	uint8_t palette_size = animation[1];
+	uint8_t op, color_index, run;
+	uint16_t pixel = 0;
+
+	/* a key frame starts on a dark display */
+	if(*stream++ == ANIMATION_FRAME_KEY){
+		WS2812_clear_buffer();
+	}
+
+	/* walk through the pixels row by row */
+	while((op = *stream++) != ANIMATION_OP_END){
+		if(op < ANIMATION_OP_RUN){
+			/* skip unchanged pixels */
+			pixel += op;
+			continue;
+		}
+		if(op < ANIMATION_OP_PIXEL){
+			run = (op & 0x3F) + 1;
+			color_index = *stream++;
+		}else{
+			run = 1;
+			color_index = op & 0x3F;
+		}
+		if(color_index >= palette_size || pixel + run > ROW*COL){
+			return 1;
+		}
+		color = &palette[color_index*3];
+		red = (color[0] * *ambient_factor) / ANIMATION_AMBIENT_FULL;
+		green = (color[1] * *ambient_factor) / ANIMATION_AMBIENT_FULL;
+		blue = (color[2] * *ambient_factor) / ANIMATION_AMBIENT_FULL;
+		while(run--){
+			WS2812_framedata_setPixel(pixel / COL, pixel % COL, red, green, blue);
+			pixel++;
+		}
+	}
+	*position = stream;
+	return 0;
+}
+
+/**
+  * @brief  starts the decoder at the first frame of the animation
+  * @note   the frame period is taken from the animation header
+  * @retval None
+  */
+static void animation_effect_init(Effect *effect){
+	const uint8_t *animation = effect->data;
+
+	if(!animation_valid(animation)){
+		animation_position = NULL;
+		return;
+	}
+	effect->frame_period = animation[2];
+	animation_position = &animation[ANIMATION_HEADER_SIZE + 3*animation[1]];
+}
+
+/**
+  * @brief  draws the next frame of the animation
+  * @note   a corrupt frame ends the animation
+  * @retval None
+  */
+static void animation_effect_step(Effect *effect){
+	if(animation_decode_frame(effect->data, &animation_position, animation_ambient_factor)){
+		animation_position = NULL;
+	}
+}
+
+/**
+  * @brief  checks if all frames of the animation are shown
+  * @note   None
+  * @retval 1 if the effect is finished, else 0
+  */
+static uint8_t animation_effect_done(Effect *effect){
+	return animation_position == NULL || effect->frame >= ((const uint8_t*)effect->data)[3];
+}
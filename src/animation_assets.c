@@ -0,0 +1,38 @@
+/*
+ * animation_assets.c this module contents the animation assets, generated by tools/anim_encode.py.
+ * Do not edit, change the .anim files in tools/animations and run the encoder again.
+ */
+
+#include "animation.h"
+
+/* sunrise.anim: 24 frames, 442 bytes (8568 bytes uncompressed) */
+const uint8_t animation_sunrise[] = {
+	0x01, 0x08, 0x50, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x08, 0x00, 0x10, 0x20, 0x00, 0x10,
+	0x40, 0x10, 0x00, 0x60, 0x20, 0x00, 0x80, 0x38, 0x00, 0xA0, 0x60, 0x10, 0x01, 0x44, 0xA8, 0x01,
+	0x82, 0x04, 0x86, 0x01, 0x00, 0x00, 0x6C, 0xC4, 0x01, 0xC5, 0x01, 0xC4, 0x00, 0x00, 0x5C, 0x82,
+	0x04, 0x0E, 0xC5, 0x01, 0xC5, 0x00, 0x00, 0xBF, 0x01, 0x83, 0x01, 0x17, 0xC4, 0x03, 0xC4, 0x0B,
+	0xC4, 0x05, 0xC4, 0x00, 0x00, 0x5D, 0xC5, 0x0E, 0xC5, 0x01, 0xC6, 0x01, 0xC5, 0x00, 0x00, 0x4B,
+	0x82, 0x04, 0x07, 0x85, 0x02, 0x01, 0xC5, 0x01, 0xC5, 0x01, 0x8A, 0x02, 0x02, 0xC6, 0x01, 0xC6,
+	0x02, 0x84, 0x02, 0x00, 0x00, 0x44, 0x85, 0x02, 0xC4, 0x03, 0xC4, 0x85, 0x02, 0x05, 0xC4, 0x05,
+	0xC4, 0x00, 0x00, 0x4C, 0xC5, 0x0E, 0xC5, 0x01, 0xC6, 0x01, 0xC5, 0x00, 0x00, 0x33, 0x86, 0x02,
+	0x82, 0x04, 0x86, 0x02, 0x07, 0xC5, 0x01, 0xC5, 0x0E, 0xC6, 0x01, 0xC6, 0x00, 0x00, 0x39, 0xC4,
+	0x03, 0xC4, 0x0B, 0xC4, 0xC5, 0x03, 0xC5, 0xC4, 0x00, 0x00, 0x22, 0x90, 0x02, 0x06, 0x84, 0x05,
+	0x0B, 0xC5, 0x01, 0x82, 0x06, 0x01, 0xC5, 0x0A, 0xC5, 0x05, 0xC5, 0x05, 0x84, 0x03, 0xC5, 0x05,
+	0xC5, 0x84, 0x03, 0x00, 0x00, 0x29, 0x82, 0x05, 0x29, 0x84, 0x03, 0x07, 0x84, 0x03, 0x07, 0xC5,
+	0x01, 0xC5, 0x00, 0x00, 0x28, 0xC5, 0x03, 0xC5, 0x0B, 0xC5, 0x81, 0x06, 0xC7, 0x81, 0x06, 0xC5,
+	0x0B, 0xC6, 0x82, 0x07, 0xC6, 0x0C, 0xC6, 0x82, 0x07, 0xC6, 0x0B, 0xC3, 0x01, 0xC6, 0x01, 0xC6,
+	0x01, 0xC3, 0x00, 0x00, 0x19, 0xC5, 0x0F, 0x82, 0x06, 0x0E, 0xC7, 0x01, 0xC7, 0x30, 0xC5, 0x01,
+	0xC5, 0x00, 0x00, 0x18, 0xC5, 0x01, 0xC5, 0x0C, 0xC5, 0x05, 0xC5, 0x16, 0x84, 0x03, 0x07, 0x84,
+	0x03, 0x07, 0x82, 0x06, 0x0F, 0xC5, 0x00, 0x00, 0x11, 0x85, 0x02, 0xC5, 0x03, 0xC5, 0x85, 0x02,
+	0x06, 0xC6, 0x01, 0xC7, 0x01, 0xC6, 0x2D, 0xC3, 0xC5, 0x03, 0xC5, 0xC3, 0x0B, 0xC3, 0x03, 0xC3,
+	0x00, 0x00, 0x08, 0xC5, 0x0F, 0x82, 0x06, 0x0E, 0xC7, 0x01, 0xC7, 0x1F, 0xC6, 0x01, 0xC6, 0x0E,
+	0xC5, 0x01, 0xC5, 0x07, 0x90, 0x04, 0x00, 0x00, 0x07, 0xC5, 0x01, 0xC5, 0x0C, 0xC5, 0x05, 0xC5,
+	0x16, 0x84, 0x03, 0x07, 0x84, 0x03, 0x06, 0xC5, 0x01, 0xC6, 0x01, 0xC5, 0x0E, 0xC5, 0x00, 0x00,
+	0x06, 0xC5, 0x03, 0xC5, 0x0C, 0xC6, 0x01, 0xC7, 0x01, 0xC6, 0x2D, 0xC3, 0x05, 0xC3, 0x0B, 0xC3,
+	0x03, 0xC3, 0x00, 0x00, 0x07, 0x82, 0x06, 0x0E, 0xC7, 0x01, 0xC7, 0x1F, 0xC6, 0x01, 0xC6, 0x0E,
+	0xC5, 0x01, 0xC5, 0x07, 0x90, 0x04, 0x00, 0x00, 0x05, 0xC5, 0x05, 0xC5, 0x2D, 0xC5, 0x01, 0xC6,
+	0x01, 0xC5, 0x0E, 0xC5, 0x00, 0x00, 0x06, 0xC6, 0x01, 0xC7, 0x01, 0xC6, 0x2D, 0xC3, 0x05, 0xC3,
+	0x0B, 0xC3, 0x03, 0xC3, 0x00, 0x00, 0x07, 0xC7, 0x01, 0xC7, 0x18, 0x84, 0x03, 0x02, 0xC6, 0x01,
+	0xC6, 0x02, 0x84, 0x03, 0x07, 0xC5, 0x01, 0xC5, 0x07, 0x90, 0x04, 0x00, 0x00, 0x28, 0xC5, 0x01,
+	0xC6, 0x01, 0xC5, 0x0C, 0xC3, 0x01, 0xC5, 0x01, 0xC3, 0x00,
+};
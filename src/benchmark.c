@@ -0,0 +1,306 @@
+/*
+ * Autor: Nico Korn
+ * Date: 19.10.2026
+ * Firmware for a alarmlcock with custom made STM32F103 microcontroller board.
+ *  *
+ * Copyright (c) 2026 Nico Korn
+ *
+ * benchmark.c this module contents the fixed render workloads and their measurement
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+
+
+
+// ----------------------------------------------------------------------------
+
+#include "benchmark.h"
+#include "ws2812.h"
+#include "effect.h"
+#include "cyclecounter.h"
+#include <stdio.h>
+
+/* defines */
+#define BENCHMARK_HEADER		"benchmark,iterations,min,mean,max,hz"
+
+/* private variables */
+static Alarmclock			benchmark_clock;			// copy of the clock, the workloads change its time
+static uint8_t				benchmark_red = 0xFF;
+static uint8_t				benchmark_green = 0x80;
+static uint8_t				benchmark_blue = 0x40;
+static uint16_t				benchmark_ambient = 100;
+static Effect				*benchmark_effect;
+static uint32_t				benchmark_overhead;
+
+/* private functions */
+static void measure(char *name, void (*run)(uint32_t iteration), void (*output)(const char *line));
+static void effect_restart(Effect *effect);
+static void run_empty(uint32_t iteration);
+static void run_setpixel(uint32_t iteration);
+static void run_setpixel_frame(uint32_t iteration);
+static void run_clear_buffer(uint32_t iteration);
+static void run_draw_letter(uint32_t iteration);
+static void run_draw_number(uint32_t iteration);
+static void run_string(char *string, uint32_t iteration);
+static void run_string_1(uint32_t iteration);
+static void run_string_4(uint32_t iteration);
+static void run_string_8(uint32_t iteration);
+static void run_string_16(uint32_t iteration);
+static void run_string_32(uint32_t iteration);
+static void run_time(uint8_t hours, uint8_t minutes, uint32_t iteration);
+static void run_time_steady(uint32_t iteration);
+static void run_time_minute(uint32_t iteration);
+static void run_time_hour(uint32_t iteration);
+static void run_time_day(uint32_t iteration);
+static void run_line_horizontal(uint32_t iteration);
+static void run_line_vertical(uint32_t iteration);
+static void run_line_diagonal(uint32_t iteration);
+static void run_effect(uint32_t iteration);
+
+/* private benchmarks */
+static const Benchmark		benchmarks[] = {
+									{"setpixel",				run_setpixel},
+									{"setpixel_frame",			run_setpixel_frame},
+									{"clear_buffer",			run_clear_buffer},
+									{"draw_letter",				run_draw_letter},
+									{"draw_number",				run_draw_number},
+									{"draw_string_1",			run_string_1},
+									{"draw_string_4",			run_string_4},
+									{"draw_string_8",			run_string_8},
+									{"draw_string_16",			run_string_16},
+									{"draw_string_32",			run_string_32},
+									{"draw_time_steady",		run_time_steady},
+									{"draw_time_minute",		run_time_minute},
+									{"draw_time_hour",			run_time_hour},
+									{"draw_time_day",			run_time_day},
+									{"set_line_horizontal",		run_line_horizontal},
+									{"set_line_vertical",		run_line_vertical},
+									{"set_line_diagonal",		run_line_diagonal}
+									};
+
+
+
+/**
+  * @brief  runs all workloads and every registered effect step BENCHMARK_ITERATIONS times
+  * @note   blocks and overwrites the frame buffer, the caller has to redraw the display. The output is called
+  * 		with the header and one line per workload.
+  * @retval None
+  */
+void benchmark_run(Alarmclock *alarmclock_param, void (*output)(const char *line)){
+	char name[BENCHMARK_LINE_LENGTH];
+	Effect *effect;
+
+	benchmark_clock = *alarmclock_param;
+	/* the overhead of the measurement is the fastest empty call */
+	benchmark_overhead = 0;
+	output(BENCHMARK_HEADER);
+	measure("overhead", run_empty, output);
+	for(uint8_t i = 0; i < sizeof(benchmarks)/sizeof(Benchmark); i++){
+		measure(benchmarks[i].name, benchmarks[i].run, output);
+	}
+
+	/* per frame step of the effects, a finished effect is started again outside of the measurement */
+	effect_stop();
+	for(uint8_t effect_class = EFFECT_CLASS_SYSTEM; effect_class <= EFFECT_CLASS_ALARM; effect_class++){
+		for(uint8_t i = 0; i < effect_count(effect_class); i++){
+			effect = effect_get(effect_class, i);
+			snprintf(name, sizeof(name), "effect_%s", effect->name);
+			for(char *c = name; *c != 0; c++){
+				if(*c == ' ' || *c == ','){
+					*c = '_';
+				}
+			}
+			benchmark_effect = effect;
+			effect_restart(effect);
+			measure(name, run_effect, output);
+		}
+	}
+	WS2812_clear_buffer();
+}
+
+/**
+  * @brief  sends a result line over ITM port 0
+  * @note   the characters are dropped if the debugger has not enabled the port
+  * @retval None
+  */
+void benchmark_itm_output(const char *line){
+	while(*line != 0){
+		ITM_SendChar(*line++);
+	}
+	ITM_SendChar('\n');
+}
+
+/**
+  * @brief  measures every call of the workload and outputs min, mean and max
+  * @note   None
+  * @retval None
+  */
+static void measure(char *name, void (*run)(uint32_t iteration), void (*output)(const char *line)){
+	char line[BENCHMARK_LINE_LENGTH];
+	uint32_t min = UINT32_MAX;
+	uint32_t max = 0;
+	uint32_t total = 0;
+	uint32_t start, ticks;
+
+	for(uint32_t i = 0; i < BENCHMARK_ITERATIONS; i++){
+		if(run == run_effect && benchmark_effect->done(benchmark_effect)){
+			effect_restart(benchmark_effect);
+		}
+		start = BENCHMARK_COUNTER();
+		run(i);
+		ticks = BENCHMARK_COUNTER() - start;
+		ticks = ticks > benchmark_overhead ? ticks - benchmark_overhead : 0;
+		if(ticks < min){
+			min = ticks;
+		}
+		if(ticks > max){
+			max = ticks;
+		}
+		total += ticks;
+	}
+	if(run == run_empty){
+		benchmark_overhead = min;
+	}
+	snprintf(line, sizeof(line), "%s,%u,%lu,%lu,%lu,%lu", name, BENCHMARK_ITERATIONS, (unsigned long)min,
+			(unsigned long)(total / BENCHMARK_ITERATIONS), (unsigned long)max, (unsigned long)BENCHMARK_COUNTER_HZ);
+	output(line);
+}
+
+/**
+  * @brief  starts an effect at its first frame, as the effect player does it
+  * @note   None
+  * @retval None
+  */
+static void effect_restart(Effect *effect){
+	effect->frame = 0;
+	if(effect->init != NULL){
+		effect->init(effect);
+	}
+}
+
+/**
+  * @brief  workloads, the iteration varies the position or the content
+  * @note   None
+  * @retval None
+  */
+static void run_empty(uint32_t iteration){
+	__NOP();
+}
+
+static void run_setpixel(uint32_t iteration){
+	WS2812_framedata_setPixel(iteration % ROW, iteration % COL, benchmark_red, benchmark_green, benchmark_blue);
+}
+
+static void run_setpixel_frame(uint32_t iteration){
+	for(uint8_t row = 0; row < ROW; row++){
+		for(uint16_t col = 0; col < COL; col++){
+			WS2812_framedata_setPixel(row, col, benchmark_red, benchmark_green, (uint8_t)iteration);
+		}
+	}
+}
+
+static void run_clear_buffer(uint32_t iteration){
+	WS2812_clear_buffer();
+}
+
+static void run_draw_letter(uint32_t iteration){
+	draw_letter('a' + iteration % 26, iteration % COL, 0, &benchmark_red, &benchmark_green, &benchmark_blue, &benchmark_ambient);
+}
+
+static void run_draw_number(uint32_t iteration){
+	draw_number('0' + iteration % 10, iteration % COL, 0, &benchmark_red, &benchmark_green, &benchmark_blue, &benchmark_ambient);
+}
+
+/* a string longer than the display is scrolled with the iteration, as the ticker does it */
+static void run_string(char *string, uint32_t iteration){
+	int16_t scroll_end = get_string_scroll_end(string);
+	int16_t x_offset = scroll_end < 0 ? -(int16_t)(iteration % (1 - scroll_end)) : 0;
+
+	draw_string_frame(string, x_offset, 0, &benchmark_red, &benchmark_green, &benchmark_blue, &benchmark_ambient);
+}
+
+static void run_string_1(uint32_t iteration){
+	run_string("a", iteration);
+}
+
+static void run_string_4(uint32_t iteration){
+	run_string("wake", iteration);
+}
+
+static void run_string_8(uint32_t iteration){
+	run_string("good day", iteration);
+}
+
+static void run_string_16(uint32_t iteration){
+	run_string("alarm at seven o", iteration);
+}
+
+static void run_string_32(uint32_t iteration){
+	run_string("the quick brown fox jumps over t", iteration);
+}
+
+/* the odd iterations show the next minute, every call starts the transitions of the changed digits */
+static void run_time(uint8_t hours, uint8_t minutes, uint32_t iteration){
+	if(iteration & 0x01){
+		minutes++;
+		if(minutes == 60){
+			minutes = 0;
+			hours = (hours + 1) % 24;
+		}
+	}
+	benchmark_clock.timestructure.Hours = hours;
+	benchmark_clock.timestructure.Minutes = minutes;
+	benchmark_clock.timestructure.Seconds = iteration % 60;
+	draw_time(&benchmark_clock);
+}
+
+static void run_time_steady(uint32_t iteration){
+	run_time(12, 34, 0);
+}
+
+static void run_time_minute(uint32_t iteration){
+	run_time(12, 34, iteration);
+}
+
+static void run_time_hour(uint32_t iteration){
+	run_time(12, 59, iteration);
+}
+
+static void run_time_day(uint32_t iteration){
+	run_time(23, 59, iteration);
+}
+
+static void run_line_horizontal(uint32_t iteration){
+	WS2812_set_line(iteration % ROW, 0, iteration % ROW, COL - 1, benchmark_red, benchmark_green, benchmark_blue);
+}
+
+static void run_line_vertical(uint32_t iteration){
+	WS2812_set_line(0, iteration % COL, ROW - 1, iteration % COL, benchmark_red, benchmark_green, benchmark_blue);
+}
+
+static void run_line_diagonal(uint32_t iteration){
+	WS2812_set_line(0, 0, ROW - 1, COL - 1, benchmark_red, benchmark_green, benchmark_blue);
+}
+
+static void run_effect(uint32_t iteration){
+	benchmark_effect->step(benchmark_effect);
+	benchmark_effect->frame++;
+}
@@ -29,6 +29,8 @@
 // ----------------------------------------------------------------------------
 
 #include "button.h"
+#include "latency.h"
+#include "record.h"
 
 /* global variables */
 TIM_HandleTypeDef	TIM1_Handle;
@@ -39,6 +41,10 @@ static uint16_t 				button_pin, button_pin_temp;
 static uint16_t 				wait_for_double_click = 0;
 static uint32_t 				low_or_high_active_button;
 
+/* private functions */
+static Event_Source button_source(uint16_t GPIO_Pin);
+static void button_queue(Event_Type type);
+
 /**
   * @brief  initialization of touch and switch buttons
   * @note   None
@@ -138,10 +144,13 @@ void set_button_irq(FunctionalState button_irq){
  * @retval None
  */
 void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin){
+	/* start the latency measurement of the button */
+	latency_stamp_event(LATENCY_STAGE_EXTI, EVENT_TYPE_PRESS, button_source(GPIO_Pin));
+	RECORD_INPUT(RECORD_TYPE_PIN, GPIO_Pin | ((GPIOB->IDR & GPIO_Pin) ? RECORD_PIN_LEVEL : 0));
 	button_pin_temp = GPIO_Pin;
 
 	/* stop any display animations for quick reaction */
-	WS2812_stop_animation();
+	effect_stop();
 
 	/* check if tim1 is still running, to identify a double click
 	 * if not, then start a new pushed button process */
@@ -151,8 +160,7 @@ void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin){
 		/* put GPIO_Pin into a variable with module wide scope */
 		button_pin = GPIO_Pin;
 		/* queue event */
-		queue_event(button_pin);
-		/*fgwefwwf*/
+		button_queue(EVENT_TYPE_PRESS);
 		wait_for_double_click = 1;
 		/* start timer for button keep pushed event, except it is a switch */
 		if(button_pin != SWITCH_ALARM){
@@ -160,12 +168,10 @@ void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin){
 		}
 	}else{
 		/* If the snooze button has been pushed a second time during the timer window
-		 * load it as negation of BUTTON_SNOOZE into the queue. The negation classifies
-		 * a double click action */
+		 * queue it as double click */
 		if(button_pin == BUTTON_SNOOZE){	//snooze button has double click action
-			button_pin = ~button_pin;			//negation to identify the button event as double click
 			/* queue event */
-			queue_event(button_pin);
+			button_queue(EVENT_TYPE_DOUBLE_CLICK);
 			/* stop the timer */
 			button_TIM1_stop();
 			/* reset double click */
@@ -176,7 +182,7 @@ void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin){
 			/* put GPIO_Pin into a variable with module wide scope */
 			button_pin = GPIO_Pin;
 			/* queue event */
-			queue_event(button_pin);
+			button_queue(EVENT_TYPE_PRESS);
 			/* stop the timer */
 			button_TIM1_stop();
 			/* start timer for button keep pushed event */
@@ -209,13 +215,14 @@ void BUTTON_TIM1_Callback(void){
 		/* Set the auto-reload value */
 		///(&TIM1_Handle)->Instance->ARR = 500; //250ms
 		if(wait_for_double_click == 1){
+			RECORD_INPUT(RECORD_TYPE_PIN, button_pin | ((GPIOB->IDR & button_pin) ? RECORD_PIN_LEVEL : 0));
 			button_TIM1_stop();
 			clear_event_queue();
 			wait_for_double_click = 0;
 		}
 	}else{
-		/* put button event into queue */
-		queue_event(button_pin);
+		/* put button event into queue, the first one is the long press, then it repeats */
+		button_queue(push_event_count == 0 ? EVENT_TYPE_LONG_PRESS : EVENT_TYPE_REPEAT);
 		/* in function to the push event count change the period */
 		if(push_event_count >= 0 && push_event_count < 6){	//start with 500 ms periods for 6 push_event_counts
 			/* Set the auto-reload value */
@@ -262,3 +269,33 @@ void button_TIM1_stop(void){
 	/* set counter register to 0 */
 	(&TIM1_Handle)->Instance->CNT = 0;
 }
+
+/**
+  * @brief  maps a button pin to the source of its events
+  * @param  GPIO_Pin: pin of the button
+  * @retval event source, EVENT_SOURCE_NONE if the pin is not a button
+  */
+static Event_Source button_source(uint16_t GPIO_Pin){
+	switch(GPIO_Pin){
+		case BUTTON_MODE:			return EVENT_SOURCE_MODE;
+		case BUTTON_PLUS:			return EVENT_SOURCE_PLUS;
+		case BUTTON_MINUS:			return EVENT_SOURCE_MINUS;
+		case BUTTON_SNOOZE:			return EVENT_SOURCE_SNOOZE;
+		case SWITCH_ALARM:			return EVENT_SOURCE_SWITCH_ALARM;
+		default:					return EVENT_SOURCE_NONE;
+	}
+}
+
+/**
+  * @brief  queues an event of the recent button
+  * @param  type of the button event, the switch always queues EVENT_TYPE_SWITCH
+  * @note   the payload of a repeat is the repeat count, the payload of the switch is 1 if the switch is on
+  * @retval None
+  */
+static void button_queue(Event_Type type){
+	if(button_pin == SWITCH_ALARM){
+		queue_event(EVENT_TYPE_SWITCH, EVENT_SOURCE_SWITCH_ALARM, (GPIOB->IDR & SWITCH_ALARM) ? 0 : 1);
+	}else{
+		queue_event(type, button_source(button_pin), push_event_count);
+	}
+}
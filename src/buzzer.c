@@ -156,7 +156,7 @@ void BUZZER_TIM4_callback(Alarmclock *alarmclock_param){
 		GPIOB->ODR ^= BUZZER_PIN;
 		beep_rounds++;
 		/* queue  buzzer event */
-		queue_event(BUZZER_PIN);
+		queue_event(EVENT_TYPE_BEEP, EVENT_SOURCE_BUZZER, (GPIOB->ODR & BUZZER_PIN) ? 1 : 0);
 	}else{
 		/* stop buzzer time */
 		HAL_TIM_Base_Stop_IT(&TIM4_Handle);
@@ -186,7 +186,7 @@ void buzzer_start(Alarmclock *alarmclock_param){
 	/* set buzzer state */
 	alarmclock_param->buzzer_state = BUZZER_SET;
 	/* queue  buzzer event */
-	queue_event(BUZZER_PIN);
+	queue_event(EVENT_TYPE_BEEP, EVENT_SOURCE_BUZZER, 1);
 }
 
 /**
@@ -29,32 +29,75 @@
 // ----------------------------------------------------------------------------
 
 #include "clock.h"
+#include "profile.h"
+#include "record.h"
 
 /* defines */
 #define SETUP_CLOCK_BLINKING_PERIOD	1000 // in ms
+#define SETUP_CLOCK_BLINKING_VISIBLE	501	 // the number is visible from this point of the period on
+#define CLOCK_INTRO_FRAMES			440	// amount of frames of the intro
+#define CLOCK_INTRO_FRAME_PERIOD	5	// in ms
+#define CLOCK_DIGIT_TRANSITION		DIGIT_TRANSITION_ROLL	// transition of the numbers on the clock face
+#define CLOCK_DIGITS				4	// amount of digits on the display
+#define CLOCK_DOUBLEPOINT_X_OFFSET	7	// column of the double point between hours and minutes
+#define CLOCK_BKP_MAGIC				0x32F3	// BKP_DR1 value of a configured rtc, the counter holds the seconds since the epoch
+#define CLOCK_BKP_MAGIC_LEGACY		0x32F2	// BKP_DR1 value of a configured rtc, the counter holds the hal calendar
+#define SETUP_SCROLL_HOLD			500		// in ms, the text of a setup mode stands still at the start and the end of its scroll
+#define ALARM_RULE_COUNT			5		// amount of rules in the alarm rule setup
 /* uncomment this to use the development mode to have modes like displayed ambient light measurement */
 //#define DEV_MODE
+/* uncomment this to let particles run behind the clock */
+//#define CLOCK_BACKGROUND			PARTICLE_STYLE_SNOW
 
 
 /* private variables */
 static uint8_t				mode_count;
-static uint8_t	 			h0, h1, m0, m1;
-static uint8_t	 			h0_old, h1_old, m0_old, m1_old, init;
-static uint8_t	 			h0_time_change_flag, h1_time_change_flag, m0_time_change_flag, m1_time_change_flag;
-static int16_t 				h0_x_offset, h1_x_offset, m0_x_offset, m1_x_offset, x_offset;
-static int8_t 				h0_y_offset, h1_y_offset, m0_y_offset, m1_y_offset, y_offset;
+static uint8_t	 			hh_mm[CLOCK_DIGITS];		// h0h1:m0m1 of the setup modes
+static const int16_t		clock_layout[CLOCK_DIGITS] = {0, 4, 10, 14};	// x offsets of h0, h1, m0, m1
+static const int16_t		lux_layout[CLOCK_DIGITS] = {14, 10, 6, 2};		// x offsets of the ones, tens, hundreds, thousands
+static Digit_Slot			clock_digits[CLOCK_DIGITS];	// hh:mm on the clock face
+static volatile uint8_t		clock_second_pending;		// set by the rtc second interrupt
+static volatile uint8_t		clock_redraw_pending;		// set if the clock face changed without a new second
+static uint8_t				clock_fade_active;			// set while the color fades to the color of the color index
+static int16_t				setup_scroll_offset;		// x offset of the text of the setup modes
+static uint32_t				setup_scroll_tick;			// hal tick of the last scroll step of the text
+static uint8_t				alarm_setup_index;			// alarm of the alarm table in the alarm setup
+static uint8_t				alarm_setup_rule;			// index of the rule in the alarm rule setup
+static char					alarm_setup_text[] = "alarm 1 skip";
+static const Alarm_Rule		alarm_rules[ALARM_RULE_COUNT] = {
+									{"daily",	ALARM_EVERY_DAY,	ALARM_FLAG_ENABLED},
+									{"mo-fr",	0x3E,				ALARM_FLAG_ENABLED},
+									{"sa-su",	0x41,				ALARM_FLAG_ENABLED},
+									{"once",	ALARM_EVERY_DAY,	ALARM_FLAG_ENABLED | ALARM_FLAG_ONESHOT},
+									{"off",		ALARM_EVERY_DAY,	0}
+									};
 static uint8_t 				color_pattern[4][3] = {
 									{0x09, 0x09, 0x09},	//white
 									{0x09, 0x00, 0x00},	//red
 									{0x00, 0x09, 0x00},	//green
 									{0x00, 0x00, 0x09}	//blue
 									};
-static uint32_t				hal_tick_temp;
+static uint32_t				setup_blink_start;			// hal tick at the start of the blinking period
+static char					color_toast[] = "color 0";
+static uint16_t				intro_ambient = 10;
+
+/* private functions */
+static void clock_intro_step(Effect *effect);
+static uint8_t clock_intro_done(Effect *effect);
+static void draw_digits(const uint8_t *digits, const int16_t *layout, uint8_t count, Alarmclock *alarmclock_param);
+static void render_clock_display(Alarmclock *alarmclock_param);
+static uint8_t clock_animating(void);
+static void program_next_alarm(Alarmclock *alarmclock_param);
+static void clock_fade_step(Alarmclock *alarmclock_param);
+static void draw_setup_text(char *text, Alarmclock *alarmclock_param);
+
+/* private effects */
+static Effect				clock_intro_effect = {"intro", EFFECT_CLASS_SYSTEM, NULL, clock_intro_step, clock_intro_done, CLOCK_INTRO_FRAME_PERIOD, 0, NULL};
 
 
 
 /* global variables */
-extern uint8_t 				WS2812_TC;					// led transmission flag
+extern volatile uint8_t 		WS2812_TC;					// led transmission flag
 RTC_HandleTypeDef 			RTC_Handle;
 
 /**
@@ -75,109 +118,75 @@ void init_RTC( Alarmclock *alarmclock_param){
 	}
 
 	/* Read the Back Up Register 1 Data */
-	if (HAL_RTCEx_BKUPRead(&RTC_Handle, RTC_BKP_DR1) != 0x32F2){
-	    /* configure RTC calendar */
-	    RTC_CalendarConfig(alarmclock_param);
-	}else{
+	if (HAL_RTCEx_BKUPRead(&RTC_Handle, RTC_BKP_DR1) == CLOCK_BKP_MAGIC){
 		/* Clear source Reset Flag */
 	    __HAL_RCC_CLEAR_RESET_FLAGS();
+	}else if(HAL_RTCEx_BKUPRead(&RTC_Handle, RTC_BKP_DR1) == CLOCK_BKP_MAGIC_LEGACY){
+		/* the hal calendar kept the time of the day in the counter and lost the date with every reset,
+		 * the counter is taken over as it is: the time is kept and the date starts at the epoch */
+		HAL_RTCEx_BKUPWrite(&RTC_Handle, RTC_BKP_DR1, CLOCK_BKP_MAGIC);
+	    __HAL_RCC_CLEAR_RESET_FLAGS();
+	}else{
+	    /* configure RTC calendar */
+	    RTC_CalendarConfig(alarmclock_param);
 	}
+	init_timebase();
 
-	/* set time changing effect flags */
-	h0_time_change_flag = 0;
-	h1_time_change_flag = 0;
-	m0_time_change_flag = 0;
-	m1_time_change_flag = 0;
-
-	/* initiation flag for clock number startup effect */
-	init = 1;
+	/* number positions of the clock face, the numbers roll in at startup */
+	for(uint8_t i = 0; i < CLOCK_DIGITS; i++){
+		init_digit_slot(&clock_digits[i], clock_layout[i], 0, CLOCK_DIGIT_TRANSITION);
+	}
 
 	/* set mode count for mode increment function */
-	mode_count = 6;
+	mode_count = MODE_TIME_SET_ALARM_STYLE;
 	#ifdef DEV_MODE
-	mode_count = 7;
+	mode_count = MODE_TIME_LUX;
 	#endif
 
 }
 
 /**
   * @brief  shows alarmclock intro during startup
-  * @note   None
+  * @note   the intro runs on the effect player, a pushed button stops it
   * @retval None
   */
 void clock_intro(){
-	uint8_t redtest = 0xff;
-	uint8_t greentest = 0x00;
-	uint8_t bluetest = 0x00;
-	int8_t running_text_offset = -30;
-	uint16_t ambient = 10;
-	uint8_t	clock_background_framebuffer[ROW*COL*3];	//7 rows * 17 cols * 3 (RGB) = 363 --- separate frame buffer for background fx --- 1 array entry contents a color component information in 8 bit. 3 entries together = 1 RGB Information
-	/* disable button irq */
-	set_button_irq(DISABLE);
-	for(uint16_t i = 0; i<440; i++){
-		while(!WS2812_TC);
-		/* fill the complete buffer at first round */
-		if(i == 0){
-			for(uint8_t y = 0; y<ROW; y++){
-				/* set the color with the color wheel function */
-				for(uint8_t s=0; s<20; s++){
-					WS2812_color_wheel_plus(&redtest, &greentest, &bluetest);
-				}
-				for(uint16_t x = 0; x<COL; x++){
-					/* fill buffer for first frame */
-					clock_background_framebuffer[(y*COL*3)+(x*3)] = redtest;
-					clock_background_framebuffer[(y*COL*3)+(x*3)+1] = greentest;
-					clock_background_framebuffer[(y*COL*3)+(x*3)+2] = bluetest;
-				}
-			}
-		}else{
-			/* set the color with the color wheel function */
-			for(uint8_t s=0; s<15; s++){
-				WS2812_color_wheel_plus(&redtest, &greentest, &bluetest);
-			}
-			/* shift 1 row up */
-			for(uint16_t j=0; j<ROW-1; j++){
-				for(uint16_t s=0; s<3*COL; s++){
-					clock_background_framebuffer[j*COL*3+s] = clock_background_framebuffer[(j+1)*COL*3+s];
-				}
-			}
-			/* write new color in bottom row */
-			for(uint16_t j=0; j<COL; j++){
-				clock_background_framebuffer[((ROW-1)*COL*3)+(j*3)] = redtest;
-				clock_background_framebuffer[((ROW-1)*COL*3)+(j*3)+1] = greentest;
-				clock_background_framebuffer[((ROW-1)*COL*3)+(j*3)+2] = bluetest;
-			}
-		}
-		/* write buffer into buffer... lol */
-		for(uint8_t y = 0; y<ROW; y++){
-			for(uint16_t x = 0; x<COL; x++){
-				WS2812_framedata_setPixel(y, x, (uint8_t)clock_background_framebuffer[(y*COL*3)+(x*3)], (uint8_t)clock_background_framebuffer[(y*COL*3)+(x*3)+1], (uint8_t)clock_background_framebuffer[(y*COL*3)+(x*3)+2]);
-			}
-		}
+	effect_play(&clock_intro_effect);
+}
 
-		/* write text */
-		draw_letter('p', -1-running_text_offset, 0, 0x00, 0x00, 0x00, &ambient);
-		draw_letter('i', 3-running_text_offset, 0, 0x00, 0x00, 0x00, &ambient);
-		draw_letter('x', 7-running_text_offset, 0, 0x00, 0x00, 0x00, &ambient);
-		draw_letter('e', 11-running_text_offset, 0, 0x00, 0x00, 0x00, &ambient);
-		draw_letter('l', 15-running_text_offset, 0, 0x00, 0x00, 0x00, &ambient);
-
-		draw_letter('c', 22-running_text_offset, 0, 0x00, 0x00, 0x00, &ambient);
-		draw_letter('l', 26-running_text_offset, 0, 0x00, 0x00, 0x00, &ambient);
-		draw_letter('o', 30-running_text_offset, 0, 0x00, 0x00, 0x00, &ambient);
-		draw_letter('c', 34-running_text_offset, 0, 0x00, 0x00, 0x00, &ambient);
-		draw_letter('k', 38-running_text_offset, 0, 0x00, 0x00, 0x00, &ambient);
-
-		/* refresh letter positions to create a running text */
-		if(i%5 == 0){
-			running_text_offset++;
-		}
+/**
+  * @brief  draws one frame of the intro, a running text over the colorfall
+  * @note   None
+  * @retval None
+  */
+static void clock_intro_step(Effect *effect){
+	int8_t running_text_offset = -30 + (effect->frame+4)/5;	// the text moves 1 column every 5 frames
+	uint8_t black = 0x00;
+
+	/* draw background */
+	WS2812_colorfall_frame(effect->frame);
+
+	/* write text */
+	draw_letter('p', -1-running_text_offset, 0, &black, &black, &black, &intro_ambient);
+	draw_letter('i', 3-running_text_offset, 0, &black, &black, &black, &intro_ambient);
+	draw_letter('x', 7-running_text_offset, 0, &black, &black, &black, &intro_ambient);
+	draw_letter('e', 11-running_text_offset, 0, &black, &black, &black, &intro_ambient);
+	draw_letter('l', 15-running_text_offset, 0, &black, &black, &black, &intro_ambient);
+
+	draw_letter('c', 22-running_text_offset, 0, &black, &black, &black, &intro_ambient);
+	draw_letter('l', 26-running_text_offset, 0, &black, &black, &black, &intro_ambient);
+	draw_letter('o', 30-running_text_offset, 0, &black, &black, &black, &intro_ambient);
+	draw_letter('c', 34-running_text_offset, 0, &black, &black, &black, &intro_ambient);
+	draw_letter('k', 38-running_text_offset, 0, &black, &black, &black, &intro_ambient);
+}
 
-		sendbuf_WS2812();
-		HAL_Delay(5);
-	}
-	/* enable button irq */
-	set_button_irq(ENABLE);
+/**
+  * @brief  checks if the intro has been shown completely
+  * @note   None
+  * @retval 1 if the intro is finished, else 0
+  */
+static uint8_t clock_intro_done(Effect *effect){
+	return effect->frame >= CLOCK_INTRO_FRAMES;
 }
 
 /**
@@ -188,48 +197,41 @@ void clock_intro(){
 void draw_mode(Alarmclock *alarmclock_param){
 	switch(alarmclock_param->mode){
 		case MODE_TIME_SET_CLOCK_h:
-									/* disable button irq */
-									set_button_irq(DISABLE);
 									/* write time setup on the display */
-									draw_string("time setup", 0, 0, &alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-									/* enable button irq */
-									set_button_irq(ENABLE);
+									notification_post("time setup", NOTIFICATION_PRIORITY_INFO, NOTIFICATION_KEY_MODE, NOTIFICATION_TIMEOUT_SHORT);
 		break;
-		case MODE_TIME_SET_ALARM_h:
-									/* disable button irq */
-									set_button_irq(DISABLE);
+		case MODE_TIME_SET_ALARM_SELECT:
 									/* write alarm setup on the display */
-									draw_string("alarm setup", 0, 0, &alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-									/* enable button irq */
-									set_button_irq(ENABLE);
+									notification_post("alarm setup", NOTIFICATION_PRIORITY_INFO, NOTIFICATION_KEY_MODE, NOTIFICATION_TIMEOUT_SHORT);
 		break;
 		case MODE_TIME_SET_ALARM_STYLE:
-									/* disable button irq */
-									set_button_irq(DISABLE);
 									/* write alarm setup on the display */
-									draw_string("choose alarm fx", 0, 0, &alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-									/* enable button irq */
-									set_button_irq(ENABLE);
+									notification_post("choose alarm fx", NOTIFICATION_PRIORITY_INFO, NOTIFICATION_KEY_MODE, NOTIFICATION_TIMEOUT_SHORT);
 		break;
 		case MODE_TIME_SET_SNOOZE:
-									/* disable button irq */
-									set_button_irq(DISABLE);
 									/* write alarm setup on the display */
-									draw_string("snooze setup", 0, 0, &alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-									/* enable button irq */
-									set_button_irq(ENABLE);
+									notification_post("snooze setup", NOTIFICATION_PRIORITY_INFO, NOTIFICATION_KEY_MODE, NOTIFICATION_TIMEOUT_SHORT);
 		break;
 		case MODE_TIME_LUX:
-									/* disable button irq */
-									set_button_irq(DISABLE);
 									/* write alarm setup on the display */
-									draw_string("lux mode", 0, 0, &alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-									/* enable button irq */
-									set_button_irq(ENABLE);
+									notification_post("lux mode", NOTIFICATION_PRIORITY_INFO, NOTIFICATION_KEY_MODE, NOTIFICATION_TIMEOUT_SHORT);
+		break;
+		default:
 		break;
 	}
 }
 
+/**
+  * @brief  draws digits into the frame buffer, digit i is drawn at the x offset layout[i]
+  * @note   the glyph is looked up by the digit value, values above 9 are not drawn
+  * @retval None
+  */
+static void draw_digits(const uint8_t *digits, const int16_t *layout, uint8_t count, Alarmclock *alarmclock_param){
+	for(uint8_t i = 0; i < count; i++){
+		draw_digit(digits[i], layout[i], 0, &alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
+	}
+}
+
 /**
   * @brief  draws hour or minutes according last read time from rtc/alarm with incremented/decremented hours or minutes from the setup mode
   * @note   None
@@ -239,103 +241,28 @@ void draw_hh_mm(Time_Setup time, Alarmclock *alarmclock_param){
 	/* depending on mode, last refreshed time data is load into h0h1:m0m1 or the alarm data into h0h1:m0m1 */
 	if(alarmclock_param->mode == MODE_TIME_SET_CLOCK_h || alarmclock_param->mode == MODE_TIME_SET_CLOCK_min){
 		/* process hours */
-		h0 = alarmclock_param->timestructure.Hours / 10;
-		h1 = alarmclock_param->timestructure.Hours % 10;
+		hh_mm[0] = alarmclock_param->timestructure.Hours / 10;
+		hh_mm[1] = alarmclock_param->timestructure.Hours % 10;
 		/* process minutes */
-		m0 = alarmclock_param->timestructure.Minutes / 10;
-		m1 = alarmclock_param->timestructure.Minutes % 10;
+		hh_mm[2] = alarmclock_param->timestructure.Minutes / 10;
+		hh_mm[3] = alarmclock_param->timestructure.Minutes % 10;
 	}else if(alarmclock_param->mode == MODE_TIME_SET_ALARM_h || alarmclock_param->mode == MODE_TIME_SET_ALARM_min){
 		/* process hours */
-		h0 = alarmclock_param->alarmstructure.AlarmTime.Hours / 10;
-		h1 = alarmclock_param->alarmstructure.AlarmTime.Hours % 10;
+		hh_mm[0] = alarmclock_param->alarmstructure.AlarmTime.Hours / 10;
+		hh_mm[1] = alarmclock_param->alarmstructure.AlarmTime.Hours % 10;
 		/* process minutes */
-		m0 = alarmclock_param->alarmstructure.AlarmTime.Minutes / 10;
-		m1 = alarmclock_param->alarmstructure.AlarmTime.Minutes % 10;
+		hh_mm[2] = alarmclock_param->alarmstructure.AlarmTime.Minutes / 10;
+		hh_mm[3] = alarmclock_param->alarmstructure.AlarmTime.Minutes % 10;
 	}
 
 	/* draw double point */
-	draw_number(':', (uint16_t)7, (uint8_t)0, &alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
+	draw_number(':', CLOCK_DOUBLEPOINT_X_OFFSET, 0, &alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
 	if(time == HOURS){
-		/* draw numbers into display buffer */
-		/* number position h0 */
-		h0_x_offset = 0;
-		h0_y_offset = 0;
-		switch(h0){
-			case 0:	draw_number('0', h0_x_offset, h0_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 1:	draw_number('1', h0_x_offset, h0_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 2:	draw_number('2', h0_x_offset, h0_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-		}
-		/* number position h1 */
-		h1_x_offset = 4;
-		h1_y_offset = 0;
-		switch(h1){
-			case 0:	draw_number('0', h1_x_offset, h1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 1:	draw_number('1', h1_x_offset, h1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 2:	draw_number('2', h1_x_offset, h1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 3:	draw_number('3', h1_x_offset, h1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 4:	draw_number('4', h1_x_offset, h1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 5:	draw_number('5', h1_x_offset, h1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 6:	draw_number('6', h1_x_offset, h1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 7:	draw_number('7', h1_x_offset, h1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 8:	draw_number('8', h1_x_offset, h1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 9:	draw_number('9', h1_x_offset, h1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-		}
+		/* draw numbers into display buffer at position h0h1 */
+		draw_digits(&hh_mm[0], &clock_layout[0], 2, alarmclock_param);
 	}else if(time == MINUTES){
-		/* number position m0 */
-		m0_x_offset = 10;
-		m0_y_offset = 0;
-		switch(m0){
-			case 0:	draw_number('0', m0_x_offset, m0_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 1:	draw_number('1', m0_x_offset, m0_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 2:	draw_number('2', m0_x_offset, m0_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 3:	draw_number('3', m0_x_offset, m0_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 4:	draw_number('4', m0_x_offset, m0_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 5:	draw_number('5', m0_x_offset, m0_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-		}
-		/* number position m1 */
-		m1_x_offset = 14;
-		m1_y_offset = 0;
-		switch(m1){
-			case 0:	draw_number('0', m1_x_offset, m1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 1:	draw_number('1', m1_x_offset, m1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 2:	draw_number('2', m1_x_offset, m1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 3:	draw_number('3', m1_x_offset, m1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 4:	draw_number('4', m1_x_offset, m1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 5:	draw_number('5', m1_x_offset, m1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 6:	draw_number('6', m1_x_offset, m1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 7:	draw_number('7', m1_x_offset, m1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 8:	draw_number('8', m1_x_offset, m1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 9:	draw_number('9', m1_x_offset, m1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-		}
+		/* draw numbers into display buffer at position m0m1 */
+		draw_digits(&hh_mm[2], &clock_layout[2], 2, alarmclock_param);
 	}else{
 		while(1){
 			//error
@@ -344,250 +271,27 @@ void draw_hh_mm(Time_Setup time, Alarmclock *alarmclock_param){
 }
 
 /**
-  * @brief  reads time from rtc and draws it into the frame buffer
-  * @note   None
+  * @brief  draws the last read time into the frame buffer
+  * @note   the time is read from the rtc by refresh_clock_display()
   * @retval None
   */
 void draw_time(Alarmclock *alarmclock_param){
-	HAL_RTC_GetTime(&RTC_Handle, &alarmclock_param->timestructure, RTC_FORMAT_BIN);
-	HAL_RTC_GetDate(&RTC_Handle, &alarmclock_param->datestructure, RTC_FORMAT_BIN);
-
-	/* hours and minutes local places: hh:mm = h0h1:m0m2 */
-	/* process hours */
-	h0 = alarmclock_param->timestructure.Hours / 10;
-	h1 = alarmclock_param->timestructure.Hours % 10;
-
-	/* process minutes */
-	m0 = alarmclock_param->timestructure.Minutes / 10;
-	m1 = alarmclock_param->timestructure.Minutes % 10;
+	PROFILE_BEGIN(PROFILE_SCOPE_DRAW_TIME);
+	/* hours and minutes local places: hh:mm = h0h1:m0m2, a changed number starts its transition */
+	digit_slot_set(&clock_digits[0], '0' + alarmclock_param->timestructure.Hours / 10);
+	digit_slot_set(&clock_digits[1], '0' + alarmclock_param->timestructure.Hours % 10);
+	digit_slot_set(&clock_digits[2], '0' + alarmclock_param->timestructure.Minutes / 10);
+	digit_slot_set(&clock_digits[3], '0' + alarmclock_param->timestructure.Minutes % 10);
 
 	/* draw numbers into display buffer */
-	/* number position h0 */
-	if(h0 != h0_old || init){
-		h0_time_change_flag = 1;
-		h0_x_offset = 0;
-		h0_y_offset = -8;
-	}else if(h0 == h0_old && h0_time_change_flag == 1){
-		if(h0_y_offset != 0){
-			h0_y_offset++;
-		}else if(h0_y_offset == 0){
-			h0_time_change_flag = 0;
-		}
-	}else if(h0 == h0_old && h0_time_change_flag == 0){
-		h0_x_offset = 0;
-		h0_y_offset = 0;
-	}
-	switch(h0){
-		case 0:	if(h0_y_offset < 0){	//old number during time change effect shall running out of the screen
-					draw_number('2', h0_x_offset, h0_y_offset+8,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-				}
-				draw_number('0', h0_x_offset, h0_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-		break;
-		case 1:	if(h0_y_offset < 0){	//old number during time change effect shall running out of the screen
-					draw_number('0', h0_x_offset, h0_y_offset+8,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-				}
-				draw_number('1', h0_x_offset, h0_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-		break;
-		case 2:	if(h0_y_offset < 0){	//old number during time change effect shall running out of the screen
-					draw_number('1', h0_x_offset, h0_y_offset+8,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-				}
-				draw_number('2', h0_x_offset, h0_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-		break;
-	}
-	/* number position h1 */
-	/* if a new time starts, start time change effect */
-	if(h1 != h1_old || init){
-		h1_time_change_flag = 1;
-		h1_x_offset = 4;
-		h1_y_offset = -8;
-	}else if(h1 == h1_old && h1_time_change_flag == 1){
-		if(h1_y_offset != 0){
-			h1_y_offset++;
-		}else if(h1_y_offset == 0){
-			h1_time_change_flag = 0;
-		}
-	}else if(h1 == h1_old && h1_time_change_flag == 0){
-		h1_x_offset = 4;
-		h1_y_offset = 0;
-	}
-	switch(h1){
-		case 0:	if(h1_y_offset < 0){	//old number during time change effect shall running out of the screen
-					draw_number('9', h1_x_offset, h1_y_offset+8,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-				}
-				draw_number('0', h1_x_offset, h1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-		break;
-		case 1:	if(h1_y_offset < 0){	//old number during time change effect shall running out of the screen
-					draw_number('0', h1_x_offset, h1_y_offset+8,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-				}
-				draw_number('1', h1_x_offset, h1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-		break;
-		case 2:	if(h1_y_offset < 0){	//old number during time change effect shall running out of the screen
-					draw_number('1', h1_x_offset, h1_y_offset+8,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-				}
-				draw_number('2', h1_x_offset, h1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-		break;
-		case 3:	if(h1_y_offset < 0){	//old number during time change effect shall running out of the screen
-					draw_number('2', h1_x_offset, h1_y_offset+8,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-				}
-				draw_number('3', h1_x_offset, h1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-		break;
-		case 4:	if(h1_y_offset < 0){	//old number during time change effect shall running out of the screen
-					draw_number('3', h1_x_offset, h1_y_offset+8,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-				}
-				draw_number('4', h1_x_offset, h1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-		break;
-		case 5:	if(h1_y_offset < 0){	//old number during time change effect shall running out of the screen
-					draw_number('4', h1_x_offset, h1_y_offset+8,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-				}
-				draw_number('5', h1_x_offset, h1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-		break;
-		case 6:	if(h1_y_offset < 0){	//old number during time change effect shall running out of the screen
-					draw_number('5', h1_x_offset, h1_y_offset+8,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-				}
-				draw_number('6', h1_x_offset, h1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-		break;
-		case 7:	if(h1_y_offset < 0){	//old number during time change effect shall running out of the screen
-					draw_number('6', h1_x_offset, h1_y_offset+8,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-				}
-				draw_number('7', h1_x_offset, h1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-		break;
-		case 8:	if(h1_y_offset < 0){	//old number during time change effect shall running out of the screen
-					draw_number('7', h1_x_offset, h1_y_offset+8,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-				}
-				draw_number('8', h1_x_offset, h1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-		break;
-		case 9:	if(h1_y_offset < 0){	//old number during time change effect shall running out of the screen
-					draw_number('8', h1_x_offset, h1_y_offset+8,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-				}
-				draw_number('9', h1_x_offset, h1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-		break;
+	for(uint8_t i = 0; i < CLOCK_DIGITS; i++){
+		digit_slot_draw(&clock_digits[i], &alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
 	}
 	/* second double point */
-	x_offset = 7;
-	y_offset = 0;
 	if(alarmclock_param->timestructure.Seconds%2){
-		draw_number(':', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-	}
-	/* number position m0 */
-	if(m0 != m0_old || init){
-		m0_time_change_flag = 1;
-		m0_x_offset = 10;
-		m0_y_offset = -8;
-	}else if(m0 == m0_old && m0_time_change_flag == 1){
-		if(m0_y_offset != 0){
-			m0_y_offset++;
-		}else if(m0_y_offset == 0){
-			m0_time_change_flag = 0;
-		}
-	}else if(m0 == m0_old && m0_time_change_flag == 0){
-		m0_x_offset = 10;
-		m0_y_offset = 0;
-	}
-	switch(m0){
-	case 0:	if(m0_y_offset < 0){	//old number during time change effect shall running out of the screen
-				draw_number('5', m0_x_offset, m0_y_offset+8,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			}
-			draw_number('0', m0_x_offset, m0_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-	break;
-	case 1:	if(m0_y_offset < 0){	//old number during time change effect shall running out of the screen
-				draw_number('0', m0_x_offset, m0_y_offset+8,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			}
-			draw_number('1', m0_x_offset, m0_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-	break;
-	case 2:	if(m0_y_offset < 0){	//old number during time change effect shall running out of the screen
-				draw_number('1', m0_x_offset, m0_y_offset+8,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			}
-			draw_number('2', m0_x_offset, m0_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-	break;
-	case 3:	if(m0_y_offset < 0){	//old number during time change effect shall running out of the screen
-				draw_number('2', m0_x_offset, m0_y_offset+8,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			}
-			draw_number('3', m0_x_offset, m0_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-	break;
-	case 4:	if(m0_y_offset < 0){	//old number during time change effect shall running out of the screen
-				draw_number('3', m0_x_offset, m0_y_offset+8,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			}
-			draw_number('4', m0_x_offset, m0_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-	break;
-	case 5:	if(m0_y_offset < 0){	//old number during time change effect shall running out of the screen
-				draw_number('4', m0_x_offset, m0_y_offset+8,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			}
-			draw_number('5', m0_x_offset, m0_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-	break;
-	}
-	/* number position m1 */
-	if(m1 != m1_old || init){
-		m1_time_change_flag = 1;
-		m1_x_offset = 14;
-		m1_y_offset = -8;
-	}else if(m1 == m1_old && m1_time_change_flag == 1){
-		if(m1_y_offset != 0){
-			m1_y_offset++;
-		}else if(m1_y_offset == 0){
-			m1_time_change_flag = 0;
-		}
-	}else if(m1 == m1_old && m1_time_change_flag == 0){
-		m1_x_offset = 14;
-		m1_y_offset = 0;
+		draw_number(':', CLOCK_DOUBLEPOINT_X_OFFSET, 0,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
 	}
-	switch(m1){
-	case 0:	if(m1_y_offset < 0){	//old number during time change effect shall running out of the screen
-				draw_number('9', m1_x_offset, m1_y_offset+8,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			}
-			draw_number('0', m1_x_offset, m1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-	break;
-	case 1:	if(m1_y_offset < 0){	//old number during time change effect shall running out of the screen
-				draw_number('0', m1_x_offset, m1_y_offset+8,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			}
-			draw_number('1', m1_x_offset, m1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-	break;
-	case 2:	if(m1_y_offset < 0){	//old number during time change effect shall running out of the screen
-				draw_number('1', m1_x_offset, m1_y_offset+8,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			}
-			draw_number('2', m1_x_offset, m1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-	break;
-	case 3:	if(m1_y_offset < 0){	//old number during time change effect shall running out of the screen
-				draw_number('2', m1_x_offset, m1_y_offset+8,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			}
-			draw_number('3', m1_x_offset, m1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-	break;
-	case 4:	if(m1_y_offset < 0){	//old number during time change effect shall running out of the screen
-				draw_number('3', m1_x_offset, m1_y_offset+8,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			}
-			draw_number('4', m1_x_offset, m1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-	break;
-	case 5:	if(m1_y_offset < 0){	//old number during time change effect shall running out of the screen
-				draw_number('4', m1_x_offset, m1_y_offset+8,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			}
-			draw_number('5', m1_x_offset, m1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-	break;
-	case 6:	if(m1_y_offset < 0){	//old number during time change effect shall running out of the screen
-				draw_number('5', m1_x_offset, m1_y_offset+8,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			}
-			draw_number('6', m1_x_offset, m1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-	break;
-	case 7:	if(m1_y_offset < 0){	//old number during time change effect shall running out of the screen
-				draw_number('6', m1_x_offset, m1_y_offset+8,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			}
-			draw_number('7', m1_x_offset, m1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-	break;
-	case 8:	if(m1_y_offset < 0){	//old number during time change effect shall running out of the screen
-				draw_number('7', m1_x_offset, m1_y_offset+8,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			}
-			draw_number('8', m1_x_offset, m1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-	break;
-	case 9:	if(m1_y_offset < 0){	//old number during time change effect shall running out of the screen
-				draw_number('8', m1_x_offset, m1_y_offset+8,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			}
-			draw_number('9', m1_x_offset, m1_y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-	break;
-	}
-	/* save values for time changing effects */
-	h0_old = h0;
-	h1_old = h1;
-	m0_old = m0;
-	m1_old = m1;
-	init = 0;
+	PROFILE_END(PROFILE_SCOPE_DRAW_TIME);
 }
 
 /**
@@ -596,15 +300,15 @@ void draw_time(Alarmclock *alarmclock_param){
   * @retval None
   */
 void led_clock_hour_plus(Alarmclock *alarmclock_param){
-	/* reset tick counter, for clean setup blinking of the numbers */
-	HAL_SetTick(501);
+	/* show the changed number at once, for clean setup blinking of the numbers */
+	restart_setup_blinking(SETUP_CLOCK_BLINKING_VISIBLE);
 	/* read time and date from rtc registers and save it into time and datestructureget */
 	if(alarmclock_param->timestructure.Hours - 0x01 > 0x00){
 		alarmclock_param->timestructure.Hours -= 0x01;
 	}else{
 		alarmclock_param->timestructure.Hours = 0x17;
 	}
-	HAL_RTC_SetTime(&RTC_Handle, &alarmclock_param->timestructure, RTC_FORMAT_BIN);
+	timebase_set_time(&alarmclock_param->timestructure);
 }
 
 /**
@@ -613,16 +317,16 @@ void led_clock_hour_plus(Alarmclock *alarmclock_param){
   * @retval None
   */
 void led_clock_hour_minus(Alarmclock *alarmclock_param){
-	/* reset tick counter, for clean setup blinking of the numbers */
-	HAL_SetTick(501);
+	/* show the changed number at once, for clean setup blinking of the numbers */
+	restart_setup_blinking(SETUP_CLOCK_BLINKING_VISIBLE);
 	/* increment 1 hour and save it on the struct */
 	if(alarmclock_param->timestructure.Hours + 0x01 < 0x18){
 		alarmclock_param->timestructure.Hours += 0x01;
 	}else{
 		alarmclock_param->timestructure.Hours = 0x00;
 	}
-	/* set new time in the rtc registers with the structs */
-	HAL_RTC_SetTime(&RTC_Handle, &alarmclock_param->timestructure, RTC_FORMAT_BIN);
+	/* set new time in the rtc counter with the structs */
+	timebase_set_time(&alarmclock_param->timestructure);
 }
 
 /**
@@ -631,14 +335,14 @@ void led_clock_hour_minus(Alarmclock *alarmclock_param){
   * @retval None
   */
 void led_clock_minute_plus(Alarmclock *alarmclock_param){
-	/* reset tick counter, for clean setup blinking of the numbers */
-	HAL_SetTick(501);
+	/* show the changed number at once, for clean setup blinking of the numbers */
+	restart_setup_blinking(SETUP_CLOCK_BLINKING_VISIBLE);
 	if(alarmclock_param->timestructure.Minutes - 0x01 > 0x00){
 		alarmclock_param->timestructure.Minutes -= 0x01;
 	}else{
 		alarmclock_param->timestructure.Minutes = 0x3b;
 	}
-	HAL_RTC_SetTime(&RTC_Handle, &alarmclock_param->timestructure, RTC_FORMAT_BIN);
+	timebase_set_time(&alarmclock_param->timestructure);
 }
 
 /**
@@ -647,14 +351,14 @@ void led_clock_minute_plus(Alarmclock *alarmclock_param){
   * @retval None
   */
 void led_clock_minute_minus(Alarmclock *alarmclock_param){
-	/* reset tick counter, for clean setup blinking of the numbers */
-	HAL_SetTick(501);
+	/* show the changed number at once, for clean setup blinking of the numbers */
+	restart_setup_blinking(SETUP_CLOCK_BLINKING_VISIBLE);
 	if(alarmclock_param->timestructure.Minutes + 0x01 < 0x3c){
 		alarmclock_param->timestructure.Minutes += 0x01;
 	}else{
 		alarmclock_param->timestructure.Minutes = 0x00;
 	}
-	HAL_RTC_SetTime(&RTC_Handle, &alarmclock_param->timestructure, RTC_FORMAT_BIN);
+	timebase_set_time(&alarmclock_param->timestructure);
 }
 
 /**
@@ -663,8 +367,8 @@ void led_clock_minute_minus(Alarmclock *alarmclock_param){
   * @retval None
   */
 void led_alarm_hour_plus(Alarmclock *alarmclock_param){
-	/* reset tick counter, for clean setup blinking of the numbers */
-	HAL_SetTick(501);
+	/* show the changed number at once, for clean setup blinking of the numbers */
+	restart_setup_blinking(SETUP_CLOCK_BLINKING_VISIBLE);
 	if(alarmclock_param->alarmstructure.AlarmTime.Hours - 0x01 > 0x00){
 		alarmclock_param->alarmstructure.AlarmTime.Hours -= 0x01;
 	}else{
@@ -679,8 +383,8 @@ void led_alarm_hour_plus(Alarmclock *alarmclock_param){
   * @retval None
   */
 void led_alarm_hour_minus(Alarmclock *alarmclock_param){
-	/* reset tick counter, for clean setup blinking of the numbers */
-	HAL_SetTick(501);
+	/* show the changed number at once, for clean setup blinking of the numbers */
+	restart_setup_blinking(SETUP_CLOCK_BLINKING_VISIBLE);
 	if(alarmclock_param->alarmstructure.AlarmTime.Hours + 0x01 < 0x18){
 		alarmclock_param->alarmstructure.AlarmTime.Hours += 0x01;
 	}else{
@@ -695,8 +399,8 @@ void led_alarm_hour_minus(Alarmclock *alarmclock_param){
   * @retval None
   */
 void led_alarm_minute_plus(Alarmclock *alarmclock_param){
-	/* reset tick counter, for clean setup blinking of the numbers */
-	HAL_SetTick(501);
+	/* show the changed number at once, for clean setup blinking of the numbers */
+	restart_setup_blinking(SETUP_CLOCK_BLINKING_VISIBLE);
 	if(alarmclock_param->alarmstructure.AlarmTime.Minutes - 0x01 > 0x00){
 		alarmclock_param->alarmstructure.AlarmTime.Minutes -= 0x01;
 	}else{
@@ -711,8 +415,8 @@ void led_alarm_minute_plus(Alarmclock *alarmclock_param){
   * @retval None
   */
 void led_alarm_minute_minus(Alarmclock *alarmclock_param){
-	/* reset tick counter, for clean setup blinking of the numbers */
-	HAL_SetTick(501);
+	/* show the changed number at once, for clean setup blinking of the numbers */
+	restart_setup_blinking(SETUP_CLOCK_BLINKING_VISIBLE);
 	if(alarmclock_param->alarmstructure.AlarmTime.Minutes + 0x01 < 0x3c){
 		alarmclock_param->alarmstructure.AlarmTime.Minutes += 0x01;
 	}else{
@@ -723,24 +427,24 @@ void led_alarm_minute_minus(Alarmclock *alarmclock_param){
 
 /**
   * @brief  sets next alarm style
-  * @note   None
+  * @note   the alarm styles are the alarm effects in the effect registry
   * @retval None
   */
 void alarm_style_plus(Alarmclock *alarmclock_param){
 	if(alarmclock_param->alarm_style > 0 ){
 		alarmclock_param->alarm_style--;
 	}else{
-		alarmclock_param->alarm_style = 1;
+		alarmclock_param->alarm_style = effect_count(EFFECT_CLASS_ALARM)-1;
 	}
 }
 
 /**
   * @brief  sets alarm style before
-  * @note   None
+  * @note   the alarm styles are the alarm effects in the effect registry
   * @retval None
   */
 void alarm_style_minus(Alarmclock *alarmclock_param){
-	if(alarmclock_param->alarm_style < 1 ){
+	if(alarmclock_param->alarm_style < effect_count(EFFECT_CLASS_ALARM)-1 ){
 		alarmclock_param->alarm_style++;
 	}else{
 		alarmclock_param->alarm_style = 0;
@@ -748,17 +452,12 @@ void alarm_style_minus(Alarmclock *alarmclock_param){
 }
 
 /**
-  * @brief  sets alarm style before
-  * @note   None
+  * @brief  starts the effect of the alarm style on the display
+  * @note   a running effect of the same style is not restarted
   * @retval None
   */
 void show_alarm_style(Alarmclock *alarmclock_param){
-	switch(alarmclock_param->alarm_style){
-		case FLASHING:	WS2812_display_flash(50, 3);
-		break;
-		case COLORFALL:	WS2812_display_colorfall();
-		break;
-	}
+	effect_play(effect_get(EFFECT_CLASS_ALARM, alarmclock_param->alarm_style));
 }
 
 /**
@@ -789,26 +488,195 @@ void snooze_minus(Alarmclock *alarmclock_param){
 
 /**
   * @brief  show recent snooze
-  * @note   None
+  * @note   called every render period
   * @retval None
   */
 void draw_snooze(Alarmclock *alarmclock_param){
+	char *text;
+
 	switch(alarmclock_param->snooze_duration){
-		case 0:		draw_string("no snooze", 0, 0, &alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
+		case 0:		text = "no snooze";
 		break;
-		case 5:		draw_string(" 5 m", 0, 0, &alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
+		case 5:		text = " 5 m";
 		break;
-		case 10:	draw_string("10 m", 0, 0, &alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
+		case 10:	text = "10 m";
 		break;
-		case 15:	draw_string("15 m", 0, 0, &alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
+		case 15:	text = "15 m";
 		break;
-		case 20:	draw_string("20 m", 0, 0, &alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
+		case 20:	text = "20 m";
 		break;
-		case 25:	draw_string("25 m", 0, 0, &alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
+		case 25:	text = "25 m";
 		break;
-		case 30:	draw_string("30 m", 0, 0, &alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
+		case 30:	text = "30 m";
 		break;
+		default:	return;
+	}
+
+	draw_setup_text(text, alarmclock_param);
+}
+
+/**
+  * @brief  selects the next alarm of the alarm table in the alarm setup
+  * @note   None
+  * @retval None
+  */
+void alarm_select_plus(Alarmclock *alarmclock_param){
+	if(alarm_setup_index < ALARM_COUNT-1){
+		alarm_setup_index++;
+	}else{
+		alarm_setup_index = 0;
+	}
+}
+
+/**
+  * @brief  selects the alarm before in the alarm setup
+  * @note   None
+  * @retval None
+  */
+void alarm_select_minus(Alarmclock *alarmclock_param){
+	if(alarm_setup_index > 0){
+		alarm_setup_index--;
+	}else{
+		alarm_setup_index = ALARM_COUNT-1;
+	}
+}
+
+/**
+  * @brief  skips the next ring of the selected alarm, or rings it again if it is skipped already
+  * @note   action of the snooze button in the alarm setup, the alarm interrupt is disabled in the setup modes
+  * @retval None
+  */
+void alarm_select_skip(Alarmclock *alarmclock_param){
+	Alarm *alarm = alarm_get(alarm_setup_index);
+
+	if(!(alarm->flags & ALARM_FLAG_ENABLED)){
+		return;
+	}
+	if(alarm->flags & ALARM_FLAG_SKIP_NEXT){
+		alarm_set(alarm_setup_index, alarm->hours, alarm->minutes, alarm->weekdays, alarm->flags & ~ALARM_FLAG_SKIP_NEXT, timebase_read());
+		notification_post("skip off", NOTIFICATION_PRIORITY_INFO, NOTIFICATION_KEY_ALARM_SWITCH, NOTIFICATION_TIMEOUT_SHORT);
+	}else{
+		alarm_skip_next(alarm_setup_index, timebase_read());
+		notification_post("skip next", NOTIFICATION_PRIORITY_INFO, NOTIFICATION_KEY_ALARM_SWITCH, NOTIFICATION_TIMEOUT_SHORT);
+	}
+}
+
+/**
+  * @brief  shows the selected alarm of the alarm setup, a skipped alarm is shown with skip
+  * @note   called every render period
+  * @retval None
+  */
+void draw_alarm_select(Alarmclock *alarmclock_param){
+	alarm_setup_text[6] = '1' + alarm_setup_index;
+	alarm_setup_text[7] = (alarm_get(alarm_setup_index)->flags & ALARM_FLAG_SKIP_NEXT) ? ' ' : '\0';
+	draw_setup_text(alarm_setup_text, alarmclock_param);
+}
+
+/**
+  * @brief  loads time and rule of the selected alarm into the alarm setup
+  * @note   the alarm time setup changes the alarm structure, the alarm table is changed by store_alarm_setup()
+  * @retval None
+  */
+void load_alarm_setup(Alarmclock *alarmclock_param){
+	Alarm *alarm = alarm_get(alarm_setup_index);
+
+	alarmclock_param->alarmstructure.AlarmTime.Hours = alarm->hours;
+	alarmclock_param->alarmstructure.AlarmTime.Minutes = alarm->minutes;
+	alarmclock_param->alarmstructure.AlarmTime.Seconds = 0x00;
+	/* a rule which is not in the rule setup is shown as the first rule */
+	alarm_setup_rule = 0;
+	for(uint8_t i = 0; i < ALARM_RULE_COUNT; i++){
+		if(alarm_rules[i].weekdays == alarm->weekdays
+				&& alarm_rules[i].flags == (alarm->flags & (ALARM_FLAG_ENABLED | ALARM_FLAG_ONESHOT))){
+			alarm_setup_rule = i;
+			break;
+		}
+	}
+}
+
+/**
+  * @brief  writes time and rule of the alarm setup into the alarm table
+  * @note   the alarm table keeps the alarms in the backup registers, a skipped ring stays skipped
+  * @retval None
+  */
+void store_alarm_setup(Alarmclock *alarmclock_param){
+	uint8_t flags = alarm_rules[alarm_setup_rule].flags;
+
+	if(flags & ALARM_FLAG_ENABLED){
+		flags |= alarm_get(alarm_setup_index)->flags & ALARM_FLAG_SKIP_NEXT;
+	}
+	alarm_set(alarm_setup_index, alarmclock_param->alarmstructure.AlarmTime.Hours, alarmclock_param->alarmstructure.AlarmTime.Minutes,
+			alarm_rules[alarm_setup_rule].weekdays, flags, timebase_read());
+}
+
+/**
+  * @brief  sets next alarm rule
+  * @note   None
+  * @retval None
+  */
+void alarm_rule_plus(Alarmclock *alarmclock_param){
+	if(alarm_setup_rule < ALARM_RULE_COUNT-1){
+		alarm_setup_rule++;
+	}else{
+		alarm_setup_rule = 0;
+	}
+}
+
+/**
+  * @brief  sets alarm rule before
+  * @note   None
+  * @retval None
+  */
+void alarm_rule_minus(Alarmclock *alarmclock_param){
+	if(alarm_setup_rule > 0){
+		alarm_setup_rule--;
+	}else{
+		alarm_setup_rule = ALARM_RULE_COUNT-1;
+	}
+}
+
+/**
+  * @brief  shows the rule of the alarm setup
+  * @note   called every render period
+  * @retval None
+  */
+void draw_alarm_rule(Alarmclock *alarmclock_param){
+	draw_setup_text(alarm_rules[alarm_setup_rule].text, alarmclock_param);
+}
+
+/**
+  * @brief  draws the text of a setup mode and sends the frame to the leds
+  * @note   called every render period, a text which is wider than the display scrolls one column per
+  * 		call and stands still for SETUP_SCROLL_HOLD at its start and its end
+  * @retval None
+  */
+static void draw_setup_text(char *text, Alarmclock *alarmclock_param){
+	int16_t scroll_end;
+
+	/* scroll position of the text */
+	scroll_end = get_string_scroll_end(text);
+	if(setup_scroll_offset > 0 || setup_scroll_offset < scroll_end){
+		/* the text changed */
+		setup_scroll_offset = 0;
+		setup_scroll_tick = HAL_GetTick();
+	}else if(setup_scroll_offset == 0 || setup_scroll_offset == scroll_end){
+		if(scroll_end < 0 && HAL_GetTick() - setup_scroll_tick >= SETUP_SCROLL_HOLD){
+			setup_scroll_offset = setup_scroll_offset == 0 ? -1 : 0;
+			setup_scroll_tick = HAL_GetTick();
+		}
+	}else{
+		setup_scroll_offset--;
+		setup_scroll_tick = HAL_GetTick();
 	}
+
+	/* erase frame buffer */
+	WS2812_clear_buffer();
+	/* write the text into the frame buffer */
+	draw_string_frame(text, setup_scroll_offset, 0, &alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
+	/* wait for the data transmission to the led's to be ready */
+	WS2812_wait_transmission();
+	/* send frame buffer to the leds */
+	sendbuf_WS2812();
 }
 
 /**
@@ -819,29 +687,22 @@ void draw_snooze(Alarmclock *alarmclock_param){
 void RTC_CalendarConfig(Alarmclock *alarmclock_param){
 	/* Configure the Date */
 	/* Set Date: Tuesday February 18th 2014 */
-	alarmclock_param->datestructure.Year 		= 0x14;
+	alarmclock_param->datestructure.Year 		= 14;
 	alarmclock_param->datestructure.Month 		= RTC_MONTH_FEBRUARY;
-	alarmclock_param->datestructure.Date 		= 0x18;
+	alarmclock_param->datestructure.Date 		= 18;
 	alarmclock_param->datestructure.WeekDay 	= RTC_WEEKDAY_TUESDAY;
 
-	if(HAL_RTC_SetDate(&RTC_Handle,&alarmclock_param->datestructure,RTC_FORMAT_BCD) != HAL_OK){
-		/* Initialization Error */
-		//Error_Handler();
-	}
-
 	/* Configure the Time */
 	/* Set Time: 02:00:00 */
-	alarmclock_param->timestructure.Hours 		= 0x02;
-	alarmclock_param->timestructure.Minutes 	= 0x00;
-	alarmclock_param->timestructure.Seconds 	= 0x00;
+	alarmclock_param->timestructure.Hours 		= 2;
+	alarmclock_param->timestructure.Minutes 	= 0;
+	alarmclock_param->timestructure.Seconds 	= 0;
 
-	if (HAL_RTC_SetTime(&RTC_Handle,&alarmclock_param->timestructure,RTC_FORMAT_BCD) != HAL_OK){
-		/* Initialization Error */
-		//Error_Handler();
-	}
+	/* the rtc counter holds the seconds since the epoch */
+	timebase_write(timebase_from_calendar(&alarmclock_param->datestructure, &alarmclock_param->timestructure));
 
 	/* Writes a data in a RTC Backup data Register1 */
-	HAL_RTCEx_BKUPWrite(&RTC_Handle, RTC_BKP_DR1, 0x32F2);
+	HAL_RTCEx_BKUPWrite(&RTC_Handle, RTC_BKP_DR1, CLOCK_BKP_MAGIC);
 }
 
 /**
@@ -850,75 +711,175 @@ void RTC_CalendarConfig(Alarmclock *alarmclock_param){
   * @retval None
   */
 void RTC_AlarmEventCallback(Alarmclock *alarmclock_param){
-		buzzer_start(alarmclock_param);
+		/* due alarms are rescheduled, a skipped alarm stays silent */
+		if(alarm_fired(timebase_read())){
+			RECORD_INPUT(RECORD_TYPE_ALARM, timebase_read());
+			buzzer_start(alarmclock_param);
+		}
+		/* the next due alarm of the table is programmed into the rtc */
+		program_next_alarm(alarmclock_param);
 }
 
 /**
-  * @brief  this function increments the recent mode
-  * @param  None
-  * @retval None
+  * @brief  this function returns the mode which follows the recent mode
+  * @note   the mode button steps through the modes, the lux mode is only reachable with DEV_MODE
+  * @retval next mode
   */
-void increment_mode(Alarmclock *alarmclock_param){
-	/* reset tick counter, for clean setup blinking of the numbers */
-	HAL_SetTick(1);
+Wordclock_Mode get_next_mode(Alarmclock *alarmclock_param){
 	if(alarmclock_param->mode < mode_count){
-		alarmclock_param->mode++;
-	}else{
-		alarmclock_param->mode = 0;
-	}
-	/* only in the clock mode, the alarm shall work */
-	if(alarmclock_param->mode != MODE_TIME_CLOCK){
-		/* disable the alarm interrupt */
-		set_alarm_irq(DISABLE, alarmclock_param);
-	}else{
-		set_alarm_irq(ENABLE, alarmclock_param);
+		return alarmclock_param->mode + 1;
 	}
-	/* draw mode change on the clock display */
-	set_button_irq(DISABLE);
-	draw_mode(alarmclock_param);
-	set_button_irq(ENABLE);
+	return MODE_TIME_CLOCK;
 }
 
 /**
-  * @brief  this function is used to refresh time and background of the wordclock
-  * @param  None
+  * @brief  this function restarts the blinking period of the setup modes
+  * @param  phase in ms where the blinking period continues
+  * @note   the hal tick is never reset, the scheduler and the effects run on it
   * @retval None
   */
-void refresh_clock_display(Alarmclock *alarmclock_param){
+void restart_setup_blinking(uint32_t phase){
+	setup_blink_start = HAL_GetTick() - phase;
+}
+
+/**
+  * @brief  draws time and background of the clock face and sends the frame to the leds
+  * @note   the time is not read from the rtc
+  * @retval None
+  */
+static void render_clock_display(Alarmclock *alarmclock_param){
 	/* erase frame buffer */
 	WS2812_clear_buffer();
+	#ifdef CLOCK_BACKGROUND
+	/* draw particles behind the time */
+	if(particle_get_style() != CLOCK_BACKGROUND){
+		particle_start(CLOCK_BACKGROUND);
+	}
+	particle_tick();
+	particle_draw();
+	#endif
 	/* write time into frame buffer */
 	draw_time(alarmclock_param);
 	/* wait for the data transmission to the led's to be ready */
-	while(!WS2812_TC);
+	WS2812_wait_transmission();
 	/* send frame buffer to the leds */
 	sendbuf_WS2812();
 }
 
+/**
+  * @brief  checks if the clock face needs a frame without a new second
+  * @retval 1 while a number transition or the background is running, else 0
+  */
+static uint8_t clock_animating(void){
+	#ifdef CLOCK_BACKGROUND
+	return 1;
+	#else
+	for(uint8_t i = 0; i < CLOCK_DIGITS; i++){
+		if(digit_slot_animating(&clock_digits[i])){
+			return 1;
+		}
+	}
+	return 0;
+	#endif
+}
+
+/**
+  * @brief  this function is used to refresh time and background of the wordclock
+  * @note   takes the time of the last counter read and redraws the clock face unconditionally
+  * @retval None
+  */
+void refresh_clock_display(Alarmclock *alarmclock_param){
+	timebase_get_time(timebase_now(), &alarmclock_param->timestructure);
+	timebase_get_date(timebase_now(), &alarmclock_param->datestructure);
+	render_clock_display(alarmclock_param);
+}
+
+/**
+  * @brief  redraws the clock face if something changed
+  * @note   the rtc is read only after a second interrupt, number transitions, color fades and the
+  * 		background are rendered without reading the rtc. Without a trigger nothing is read or rendered.
+  * @retval 1 if a frame was sent to the leds, else 0
+  */
+uint8_t clock_tick(Alarmclock *alarmclock_param){
+	if(clock_fade_active){
+		clock_fade_step(alarmclock_param);
+		clock_redraw_pending = 1;
+	}
+	if(clock_second_pending){
+		clock_second_pending = 0;
+		clock_redraw_pending = 0;
+		refresh_clock_display(alarmclock_param);
+		return 1;
+	}
+	if(clock_redraw_pending || clock_animating()){
+		clock_redraw_pending = 0;
+		render_clock_display(alarmclock_param);
+		return 1;
+	}
+	return 0;
+}
+
+/**
+  * @brief  requests a redraw of the clock face with the next clock_tick()
+  * @note   can be called from interrupts, e.g. if the ambient light changed
+  * @retval None
+  */
+void clock_request_redraw(void){
+	clock_redraw_pending = 1;
+}
+
+/**
+  * @brief  rtc second callback, called from the rtc interrupt
+  * @note   the time on the display only changes once a second
+  * @retval None
+  */
+void RTC_SecondEventCallback(void){
+	timebase_second();
+	RECORD_INPUT(RECORD_TYPE_RTC, timebase_read());
+	clock_second_pending = 1;
+}
+
+/**
+  * @brief  shows the time immediately without the number change effect
+  * @note   used for the first frame after reset
+  * @retval None
+  */
+void show_time(Alarmclock *alarmclock_param){
+	timebase_get_time(timebase_now(), &alarmclock_param->timestructure);
+	/* the numbers are shown without transition */
+	digit_slot_show(&clock_digits[0], '0' + alarmclock_param->timestructure.Hours / 10);
+	digit_slot_show(&clock_digits[1], '0' + alarmclock_param->timestructure.Hours % 10);
+	digit_slot_show(&clock_digits[2], '0' + alarmclock_param->timestructure.Minutes / 10);
+	digit_slot_show(&clock_digits[3], '0' + alarmclock_param->timestructure.Minutes % 10);
+	refresh_clock_display(alarmclock_param);
+}
+
 /**
   * @brief  this function lets hours or minutes blinking on the display
   * @param  None
   * @retval None
   */
 void setup_clock_blinking(Alarmclock *alarmclock_param){
+	uint32_t phase;
+
 	/* erase frame buffer */
 	WS2812_clear_buffer();
-	/* get recent hal tick value for blinking the numbers */
-	hal_tick_temp = HAL_GetTick();
+	/* get the position in the blinking period */
+	phase = (HAL_GetTick() - setup_blink_start) % SETUP_CLOCK_BLINKING_PERIOD;
 	/* write setup time into frame buffer */
 	if(alarmclock_param->mode == MODE_TIME_SET_CLOCK_h || alarmclock_param->mode == MODE_TIME_SET_ALARM_h){
 		draw_hh_mm(MINUTES, alarmclock_param);
-		if(hal_tick_temp % SETUP_CLOCK_BLINKING_PERIOD > 500 && hal_tick_temp % SETUP_CLOCK_BLINKING_PERIOD < 1000){
+		if(phase >= SETUP_CLOCK_BLINKING_VISIBLE){
 			draw_hh_mm(HOURS, alarmclock_param);
 		}
 	}else if(alarmclock_param->mode == MODE_TIME_SET_CLOCK_min || alarmclock_param->mode == MODE_TIME_SET_ALARM_min){
 		draw_hh_mm(HOURS, alarmclock_param);
-		if(hal_tick_temp % SETUP_CLOCK_BLINKING_PERIOD > 500 && hal_tick_temp % SETUP_CLOCK_BLINKING_PERIOD < 1000){
+		if(phase >= SETUP_CLOCK_BLINKING_VISIBLE){
 			draw_hh_mm(MINUTES, alarmclock_param);
 		}
 	}
 	/* wait for the data transmission to the led's to be ready */
-	while(!WS2812_TC);
+	WS2812_wait_transmission();
 	/* send frame buffer to the leds */
 	sendbuf_WS2812();
 }
@@ -951,17 +912,16 @@ void get_clock_preferences(Alarmclock *alarmclock_param){
 	  backupregister += (1 * 4U);
 	  backupregister_value = (*(__IO uint32_t *)(backupregister)) & BKP_DR1_D;
 
-	  /* if variable = 0x32F2, BKP registers have saved preferences, otherwise use default values */
-	  if(backupregister_value != 0x32F2){
+	  /* if variable = CLOCK_BKP_MAGIC (or the legacy value), BKP registers have saved preferences, otherwise use default values */
+	  if(backupregister_value != CLOCK_BKP_MAGIC && backupregister_value != CLOCK_BKP_MAGIC_LEGACY){
 			/* init default color */
 			alarmclock_param->color_index = 0;
 		  	alarmclock_param->red =  color_pattern[alarmclock_param->color_index][0];
 		  	alarmclock_param->green =  color_pattern[alarmclock_param->color_index][1];
 		  	alarmclock_param->blue =  color_pattern[alarmclock_param->color_index][2];
-		  	/* init default alarm time */
-		  	alarmclock_param->alarmstructure.AlarmTime.Hours 	= 0x06;
-		  	alarmclock_param->alarmstructure.AlarmTime.Minutes 	= 0x00;
-		  	alarmclock_param->alarmstructure.AlarmTime.Seconds 	= 0x00;
+		  	/* init default alarm time, it is loaded into alarm 0 by init_alarm() */
+		  	HAL_RTCEx_BKUPWrite(&RTC_Handle, RTC_BKP_DR6, 0x06);
+		  	HAL_RTCEx_BKUPWrite(&RTC_Handle, RTC_BKP_DR7, 0x00);
 		  	/* init default snooze duration */
 		  	alarmclock_param->snooze_duration = 5;
 		  	/* init default alarm style */
@@ -997,29 +957,7 @@ void get_clock_preferences(Alarmclock *alarmclock_param){
 		  alarmclock_param->color_index = (*(__IO uint32_t *)(backupregister)) & (uint32_t)backup_register_mask;
 		  backupregister = 0U;
 
-		  /* get alarm time: hours */
-		  backupregister = (uint32_t)BKP_BASE;
-		  backupregister += (6 * 4U);
-
-		  alarmclock_param->alarmstructure.AlarmTime.Hours = (*(__IO uint32_t *)(backupregister)) & (uint32_t)backup_register_mask;
-		  backupregister = 0U;
-
-		  /* get alarm time: minutes */
-		  backupregister = (uint32_t)BKP_BASE;
-		  backupregister += (7 * 4U);
-
-		  alarmclock_param->alarmstructure.AlarmTime.Minutes = (*(__IO uint32_t *)(backupregister)) & (uint32_t)backup_register_mask;
-		  backupregister = 0U;
-
-		  /* get alarm time: seconds */
-		  backupregister = (uint32_t)BKP_BASE;
-		  backupregister += (8 * 4U);
-
-		  alarmclock_param->alarmstructure.AlarmTime.Seconds = (*(__IO uint32_t *)(backupregister)) & (uint32_t)backup_register_mask;
-		  backupregister = 0U;
-
-		  /* Enable and set RTC interrupt for alarm function */
-		  alarmclock_param->alarmstructure.AlarmTime.Seconds = 0x00;
+		  /* BKP_DR6..8 hold time and rule of alarm 0, they are loaded by init_alarm() (see alarm.h) */
 
 		  /* get alarm style */
 		  backupregister = (uint32_t)BKP_BASE;
@@ -1046,25 +984,25 @@ void set_clock_preferences(Alarmclock *alarmclock_param){
 	  uint32_t tmp = 0U;
 	  uint32_t backup_register_mask = 0x000000FF;
 
-	  /* set red color */
+	  /* set red color, a running fade is stored with its end color */
 	  tmp = (uint32_t)BKP_BASE;
 	  tmp += (2 * 4U);
 
-	  *(__IO uint32_t *) tmp = alarmclock_param->red & backup_register_mask;
+	  *(__IO uint32_t *) tmp = (clock_fade_active ? color_pattern[alarmclock_param->color_index][0] : alarmclock_param->red) & backup_register_mask;
 	  tmp = 0U;
 
 	  /* set green color */
 	  tmp = (uint32_t)BKP_BASE;
 	  tmp += (3 * 4U);
 
-	  *(__IO uint32_t *) tmp =  alarmclock_param->green & backup_register_mask;
+	  *(__IO uint32_t *) tmp =  (clock_fade_active ? color_pattern[alarmclock_param->color_index][1] : alarmclock_param->green) & backup_register_mask;
 	  tmp = 0U;
 
 	  /* set blue color */
 	  tmp = (uint32_t)BKP_BASE;
 	  tmp += (4 * 4U);
 
-	  *(__IO uint32_t *) tmp = alarmclock_param->blue & backup_register_mask;
+	  *(__IO uint32_t *) tmp = (clock_fade_active ? color_pattern[alarmclock_param->color_index][2] : alarmclock_param->blue) & backup_register_mask;
 	  tmp = 0U;
 	  
 	  /* set color index */
@@ -1074,26 +1012,7 @@ void set_clock_preferences(Alarmclock *alarmclock_param){
 	  *(__IO uint32_t *) tmp = alarmclock_param->color_index & backup_register_mask;
 	  tmp = 0U;
 
-	  /* set alarm: hours */
-	  tmp = (uint32_t)BKP_BASE;
-	  tmp += (6 * 4U);
-
-	  *(__IO uint32_t *) tmp = alarmclock_param->alarmstructure.AlarmTime.Hours & backup_register_mask;
-	  tmp = 0U;
-
-	  /* set alarm: minutes */
-	  tmp = (uint32_t)BKP_BASE;
-	  tmp += (7 * 4U);
-
-	  *(__IO uint32_t *) tmp = alarmclock_param->alarmstructure.AlarmTime.Minutes & backup_register_mask;
-	  tmp = 0U;
-
-	  /* set alarm: seconds */
-	  tmp = (uint32_t)BKP_BASE;
-	  tmp += (8 * 4U);
-
-	  *(__IO uint32_t *) tmp = alarmclock_param->alarmstructure.AlarmTime.Seconds & backup_register_mask;
-	  tmp = 0U;
+	  /* BKP_DR6..8 hold time and rule of alarm 0, they are written by the alarm table (see alarm.h) */
 
 	  /* set alarm style */
 	  tmp = (uint32_t)BKP_BASE;
@@ -1112,94 +1031,59 @@ void set_clock_preferences(Alarmclock *alarmclock_param){
 
 /**
   * @brief  this function increments the color
-  * @param  None
+  * @note   the color fades to the new color with the following clock ticks
   * @retval None
   */
 void increment_clock_color(Alarmclock *alarmclock_param){
-	/* variables for the next color */
-	uint8_t new_red, new_green, new_blue;
-
 	/* get the new color with the incremented color index */
 	if(alarmclock_param->color_index < 3){
 		alarmclock_param->color_index++;
 	}else{
 		alarmclock_param->color_index = 0;
 	}
-
-	/* the new colors */
-	new_red = color_pattern[alarmclock_param->color_index][0];
-	new_green = color_pattern[alarmclock_param->color_index][1];
-	new_blue = color_pattern[alarmclock_param->color_index][2];
-
-	/* color loop effect */
-	while(alarmclock_param->red != new_red || alarmclock_param->green != new_green || alarmclock_param->blue != new_blue){
-		/* red */
-		if(alarmclock_param->red < new_red){
-			alarmclock_param->red++;
-		}else if(alarmclock_param->red > new_red){
-			alarmclock_param->red--;
-		}
-		/* green */
-		if(alarmclock_param->green < new_green){
-			alarmclock_param->green++;
-		}else if(alarmclock_param->green > new_green){
-			alarmclock_param->green--;
-		}
-		/* blue */
-		if(alarmclock_param->blue < new_blue){
-			alarmclock_param->blue++;
-		}else if(alarmclock_param->blue > new_blue){
-			alarmclock_param->blue--;
-		}
-		/* refresh clock display */
-		refresh_clock_display(alarmclock_param);
-		HAL_Delay(50);
-	}
+	clock_fade_active = 1;
+	/* the toast of the previous color would hide the fade */
+	notification_cancel(NOTIFICATION_KEY_COLOR);
 }
 
 /**
-  * @brief  this function increments the color
-  * @param  None
+  * @brief  this function decrements the color
+  * @note   the color fades to the new color with the following clock ticks
   * @retval None
   */
 void decrement_clock_color(Alarmclock *alarmclock_param){
-	/* variables for the next color */
-	uint8_t new_red, new_green, new_blue;
-
 	if(alarmclock_param->color_index > 0){
 		alarmclock_param->color_index--;
 	}else{
 		alarmclock_param->color_index = 3;
 	}
+	clock_fade_active = 1;
+	/* the toast of the previous color would hide the fade */
+	notification_cancel(NOTIFICATION_KEY_COLOR);
+}
 
-	/* the new colors */
-	new_red = color_pattern[alarmclock_param->color_index][0];
-	new_green = color_pattern[alarmclock_param->color_index][1];
-	new_blue = color_pattern[alarmclock_param->color_index][2];
-
-	/* color loop effect */
-	while(alarmclock_param->red != new_red || alarmclock_param->green != new_green || alarmclock_param->blue != new_blue){
-		/* red */
-		if(alarmclock_param->red < new_red){
-			alarmclock_param->red++;
-		}else if(alarmclock_param->red > new_red){
-			alarmclock_param->red--;
-		}
-		/* green */
-		if(alarmclock_param->green < new_green){
-			alarmclock_param->green++;
-		}else if(alarmclock_param->green > new_green){
-			alarmclock_param->green--;
-		}
-		/* blue */
-		if(alarmclock_param->blue < new_blue){
-			alarmclock_param->blue++;
-		}else if(alarmclock_param->blue > new_blue){
-			alarmclock_param->blue--;
+/**
+  * @brief  steps the color one value closer to the color of the color index
+  * @note   called by clock_tick every render period, the toast with the color index is shown at the end
+  * @retval None
+  */
+static void clock_fade_step(Alarmclock *alarmclock_param){
+	uint8_t *color[3] = {&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue};
+
+	for(uint8_t i = 0; i < 3; i++){
+		if(*color[i] < color_pattern[alarmclock_param->color_index][i]){
+			(*color[i])++;
+		}else if(*color[i] > color_pattern[alarmclock_param->color_index][i]){
+			(*color[i])--;
 		}
-		/* refresh clock display */
-		refresh_clock_display(alarmclock_param);
-		HAL_Delay(50);
+	}
+	if(alarmclock_param->red == color_pattern[alarmclock_param->color_index][0]
+			&& alarmclock_param->green == color_pattern[alarmclock_param->color_index][1]
+			&& alarmclock_param->blue == color_pattern[alarmclock_param->color_index][2]){
+		clock_fade_active = 0;
+		/* show the new color index as toast */
+		color_toast[sizeof(color_toast)-2] = '1' + alarmclock_param->color_index;
+		notification_post(color_toast, NOTIFICATION_PRIORITY_TOAST, NOTIFICATION_KEY_COLOR, NOTIFICATION_TIMEOUT_SHORT);
 	}
 }
 
@@ -1211,14 +1095,42 @@ void decrement_clock_color(Alarmclock *alarmclock_param){
 void init_clock(Alarmclock *alarmclock_param){
 	/* load preferences from the BKP register, time is loadet with init_RTc() on the bottom of this function */
 	get_clock_preferences(alarmclock_param);
+	/* register the intro and fall back to the first alarm style if the stored one is not registered */
+	if(!effect_register(&clock_intro_effect)){
+		/* the registry is full, increase EFFECT_REGISTRY_LENGTH */
+		while(1){
+			//error
+		}
+	}
+	if(alarmclock_param->alarm_style >= effect_count(EFFECT_CLASS_ALARM)){
+		alarmclock_param->alarm_style = FLASHING;
+	}
 	/* set system mode */
 	alarmclock_param->mode = MODE_TIME_CLOCK;
 	/* initialize RTC (also load time information from BKP register) */
 	init_RTC(alarmclock_param);
-	/* set alarm interrupt */
-	HAL_RTC_SetAlarm_IT(&RTC_Handle, &alarmclock_param->alarmstructure, RTC_FORMAT_BIN);
-	HAL_NVIC_SetPriority(RTC_Alarm_IRQn, 1, 0);
-	HAL_NVIC_EnableIRQ(RTC_Alarm_IRQn);
+	/* load the alarm table and set alarm interrupt */
+	init_alarm();
+	set_alarm_irq(ENABLE, alarmclock_param);
+	/* set second interrupt, it triggers the redraw of the clock face */
+	HAL_RTCEx_SetSecond_IT(&RTC_Handle);
+	HAL_NVIC_SetPriority(RTC_IRQn, 2, 0);
+	HAL_NVIC_EnableIRQ(RTC_IRQn);
+}
+
+/**
+  * @brief  programs the next due alarm of the alarm table into the rtc
+  * @note   the rtc has a single alarm, the other alarms wait in the table
+  * @retval None
+  */
+static void program_next_alarm(Alarmclock *alarmclock_param){
+	if(alarm_next() != ALARM_NONE){
+		timebase_set_alarm(alarm_next());
+		HAL_NVIC_SetPriority(RTC_Alarm_IRQn, 1, 0);
+		HAL_NVIC_EnableIRQ(RTC_Alarm_IRQn);
+	}else if(__HAL_RTC_ALARM_GET_IT_SOURCE(&RTC_Handle, RTC_IT_ALRA)){
+		HAL_RTC_DeactivateAlarm(&RTC_Handle, alarmclock_param->alarmstructure.Alarm);
+	}
 }
 
 /**
@@ -1230,10 +1142,9 @@ void set_alarm_irq(FunctionalState alarm_irq, Alarmclock *alarmclock_param){
 	if(alarm_irq != DISABLE){
 		/* enable the alarm if it is still disabled */
 		if(!__HAL_RTC_ALARM_GET_IT_SOURCE(&RTC_Handle, RTC_IT_ALRA)){
-			/* rtc interrupt */
-			HAL_RTC_SetAlarm_IT(&RTC_Handle, &alarmclock_param->alarmstructure, RTC_FORMAT_BIN);
-			HAL_NVIC_SetPriority(RTC_Alarm_IRQn, 1, 0);
-			HAL_NVIC_EnableIRQ(RTC_Alarm_IRQn);
+			/* the time could have been changed in the setup */
+			alarm_schedule(timebase_read());
+			program_next_alarm(alarmclock_param);
 		}
 	}else{
 		/* disable the alarm interrupt if alarm is still enabled*/
@@ -1299,121 +1210,24 @@ void HAL_RTC_MspInit(RTC_HandleTypeDef *hrtc){
   * @retval None
   */
 void draw_lux(Alarmclock *alarmclock_param){
-		uint32_t adc0,adc1,adc2,adc3,x_offset,y_offset;
+		uint8_t adc[CLOCK_DIGITS];
 		uint16_t adc_avr;
 
 		adc_avr = get_avr_lux();
 
-		/* process hours */
-		adc0 = adc_avr % 10;
-		adc1 = adc_avr / 10;
-		adc1 = adc1 % 10;
-		adc2 = adc_avr /100;
-		adc2 = adc2 % 10;
-		adc3 = adc_avr /1000;
-		adc3 = adc3 % 10;
+		/* process the local places, ones first */
+		for(uint8_t i = 0; i < CLOCK_DIGITS; i++){
+			adc[i] = adc_avr % 10;
+			adc_avr = adc_avr / 10;
+		}
 
 		/* erase frame buffer */
 		WS2812_clear_buffer();
 
-		x_offset = 14;
-		y_offset = 0;
-		switch(adc0){
-			case 0:	draw_number('0', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 1:	draw_number('1', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 2:	draw_number('2', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 3:	draw_number('3', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 4:	draw_number('4', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 5:	draw_number('5', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 6:	draw_number('6', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 7:	draw_number('7', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 8:	draw_number('8', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 9:	draw_number('9', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-		}
-		x_offset = 10;
-		y_offset = 0;
-		switch(adc1){
-			case 0:	draw_number('0', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 1:	draw_number('1', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 2:	draw_number('2', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 3:	draw_number('3', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 4:	draw_number('4', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 5:	draw_number('5', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 6:	draw_number('6', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 7:	draw_number('7', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 8:	draw_number('8', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 9:	draw_number('9', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-		}
-		x_offset = 6;
-		y_offset = 0;
-		switch(adc2){
-			case 0:	draw_number('0', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 1:	draw_number('1', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 2:	draw_number('2', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 3:	draw_number('3', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 4:	draw_number('4', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 5:	draw_number('5', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 6:	draw_number('6', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 7:	draw_number('7', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 8:	draw_number('8', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 9:	draw_number('9', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-		}
-		x_offset = 2;
-		y_offset = 0;
-		switch(adc3){
-			case 0:	draw_number('0', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 1:	draw_number('1', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 2:	draw_number('2', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 3:	draw_number('3', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 4:	draw_number('4', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 5:	draw_number('5', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 6:	draw_number('6', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 7:	draw_number('7', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 8:	draw_number('8', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-			case 9:	draw_number('9', x_offset, y_offset,&alarmclock_param->red, &alarmclock_param->green, &alarmclock_param->blue, alarmclock_param->ambient_light_factor);
-			break;
-		}
+		draw_digits(adc, lux_layout, CLOCK_DIGITS, alarmclock_param);
+
 		/* wait for the data transmission to the led's to be ready */
-		while(!WS2812_TC);
+		WS2812_wait_transmission();
 		/* send frame buffer to the leds */
 		sendbuf_WS2812();
 }
@@ -0,0 +1,66 @@
+/*
+ * Autor: Nico Korn
+ * Date: 19.10.2026
+ * Firmware for a alarmlcock with custom made STM32F103 microcontroller board.
+ *  *
+ * Copyright (c) 2026 Nico Korn
+ *
+ * cyclecounter.c this module contents the cycle counter of the cortex-m3 debug unit for time measurements.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+
+
+
+// ----------------------------------------------------------------------------
+
+#include "cyclecounter.h"
+
+/**
+  * @brief  initialization of the cycle counter
+  * @note   the counter runs with the core clock and overflows after ~59 s at 72 MHz
+  * @retval None
+  */
+void init_cyclecounter(void){
+	/* enable the trace and debug blocks */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	/* reset and start the counter */
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+  * @brief  get the cycle counter value
+  * @note   differences of two values are valid over an overflow of the counter
+  * @retval cycles since the counter has been started
+  */
+uint32_t get_cyclecount(void){
+	return DWT->CYCCNT;
+}
+
+/**
+  * @brief  converts cycles into microseconds with the recent core clock
+  * @note   None
+  * @retval microseconds
+  */
+uint32_t cycles_to_us(uint32_t cycles){
+	return cycles / (SystemCoreClock / 1000000U);
+}
@@ -0,0 +1,232 @@
+/*
+ * Autor: Nico Korn
+ * Date: 19.10.2026
+ * Firmware for a alarmlcock with custom made STM32F103 microcontroller board.
+ *  *
+ * Copyright (c) 2026 Nico Korn
+ *
+ * digit.c this module contents digit slots with transitions between their values.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+
+
+
+// ----------------------------------------------------------------------------
+
+#include "digit.h"
+
+/* defines */
+#define DIGIT_WIDTH				3		// a number has a resolution of 7*3 pixels
+#define DIGIT_HEIGHT			7
+#define DIGIT_ROLL_STEPS		8		// the new number rolls in from above by 1 row per step
+#define DIGIT_FADE_STEPS		8
+#define DIGIT_DISSOLVE_STEPS	8
+
+/* private types */
+typedef struct {
+	uint8_t		steps;
+	void		(*draw)(Digit_Slot *slot, uint8_t red, uint8_t green, uint8_t blue);
+}Digit_Transition_Entry;
+
+/* private functions */
+static void digit_draw_roll(Digit_Slot *slot, uint8_t red, uint8_t green, uint8_t blue);
+static void digit_draw_fade(Digit_Slot *slot, uint8_t red, uint8_t green, uint8_t blue);
+static void digit_draw_dissolve(Digit_Slot *slot, uint8_t red, uint8_t green, uint8_t blue);
+static void digit_draw_number(char value, int16_t x_offset, int8_t y_offset, uint8_t red, uint8_t green, uint8_t blue);
+static uint8_t digit_pixel(Number *number, char value, uint8_t x, uint8_t y);
+
+/* private variables */
+static const Digit_Transition_Entry	digit_transitions[] = {
+	{0,						NULL},					// none
+	{DIGIT_ROLL_STEPS,		digit_draw_roll},		// roll
+	{DIGIT_FADE_STEPS,		digit_draw_fade},		// fade
+	{DIGIT_DISSOLVE_STEPS,	digit_draw_dissolve}	// dissolve
+};
+/* step in which a pixel changes from the old to the new number during the dissolve, the steps of a column are
+ * distinct, so a column changes at most one pixel per step */
+static const uint8_t		digit_dissolve_order[DIGIT_WIDTH][DIGIT_HEIGHT] = {
+	{3, 6, 0, 5, 2, 7, 4},
+	{7, 1, 4, 2, 6, 0, 5},
+	{2, 5, 7, 1, 3, 4, 6}
+};
+
+/**
+  * @brief  initialization of a digit slot
+  * @note   the slot is blank, the first value rolls in with the transition
+  * @retval None
+  */
+void init_digit_slot(Digit_Slot *slot, int16_t x_offset, int8_t y_offset, Digit_Transition transition){
+	slot->x_offset = x_offset;
+	slot->y_offset = y_offset;
+	slot->value = DIGIT_BLANK;
+	slot->previous = DIGIT_BLANK;
+	slot->transition = transition;
+	slot->step = 0;
+	slot->animating = 0;
+}
+
+/**
+  * @brief  sets the value of a slot, a changed value starts the transition
+  * @note   a change during a running transition restarts it from the shown value
+  * @retval None
+  */
+void digit_slot_set(Digit_Slot *slot, char value){
+	if(value == slot->value){
+		return;
+	}
+	slot->previous = slot->value;
+	slot->value = value;
+	slot->step = 0;
+	slot->animating = digit_transitions[slot->transition].steps > 0;
+}
+
+/**
+  * @brief  sets the value of a slot without transition
+  * @note   None
+  * @retval None
+  */
+void digit_slot_show(Digit_Slot *slot, char value){
+	slot->previous = value;
+	slot->value = value;
+	slot->animating = 0;
+}
+
+/**
+  * @brief  checks if the transition of a slot is running
+  * @note   None
+  * @retval 1 if the transition is running, else 0
+  */
+uint8_t digit_slot_animating(Digit_Slot *slot){
+	return slot->animating;
+}
+
+/**
+  * @brief  draws the slot into the frame buffer and advances a running transition by one step
+  * @note   a slot without running transition costs a single number draw
+  * @retval None
+  */
+void digit_slot_draw(Digit_Slot *slot, uint8_t *red, uint8_t *green, uint8_t *blue, uint16_t *ambient_factor){
+	uint8_t r = *red * *ambient_factor;
+	uint8_t g = *green * *ambient_factor;
+	uint8_t b = *blue * *ambient_factor;
+
+	if(!slot->animating){
+		digit_draw_number(slot->value, slot->x_offset, slot->y_offset, r, g, b);
+		return;
+	}
+	digit_transitions[slot->transition].draw(slot, r, g, b);
+	slot->step++;
+	if(slot->step >= digit_transitions[slot->transition].steps){
+		slot->animating = 0;
+	}
+}
+
+/**
+  * @brief  roll transition, the old number runs out of the display at the bottom while the new one comes in from above
+  * @note   None
+  * @retval None
+  */
+static void digit_draw_roll(Digit_Slot *slot, uint8_t red, uint8_t green, uint8_t blue){
+	digit_draw_number(slot->previous, slot->x_offset, slot->y_offset + slot->step, red, green, blue);
+	digit_draw_number(slot->value, slot->x_offset, slot->y_offset + slot->step - DIGIT_ROLL_STEPS, red, green, blue);
+}
+
+/**
+  * @brief  fade transition, the brightness moves from the old to the new number
+  * @note   a pixel of only the old number fades out, a pixel of only the new number fades in, a pixel of
+  * 		both numbers keeps the full brightness
+  * @retval None
+  */
+static void digit_draw_fade(Digit_Slot *slot, uint8_t red, uint8_t green, uint8_t blue){
+	Number previous = char_to_number(slot->previous);
+	Number value = char_to_number(slot->value);
+	uint8_t weight;
+
+	for(uint8_t x = 0; x < DIGIT_WIDTH; x++){
+		for(uint8_t y = 0; y < DIGIT_HEIGHT; y++){
+			weight = 0;
+			if(digit_pixel(&previous, slot->previous, x, y)){
+				weight += DIGIT_FADE_STEPS - slot->step;
+			}
+			if(digit_pixel(&value, slot->value, x, y)){
+				weight += slot->step;
+			}
+			if(weight && slot->y_offset+y >= 0 && slot->y_offset+y < ROW && slot->x_offset+x >= 0 && slot->x_offset+x < COL){
+				WS2812_framedata_setPixel(slot->y_offset+y, slot->x_offset+x, (red*weight)/DIGIT_FADE_STEPS, (green*weight)/DIGIT_FADE_STEPS, (blue*weight)/DIGIT_FADE_STEPS);
+			}
+		}
+	}
+}
+
+/**
+  * @brief  dissolve transition, the pixels change from the old to the new number in a scattered order
+  * @note   None
+  * @retval None
+  */
+static void digit_draw_dissolve(Digit_Slot *slot, uint8_t red, uint8_t green, uint8_t blue){
+	Number previous = char_to_number(slot->previous);
+	Number value = char_to_number(slot->value);
+	uint8_t on;
+
+	for(uint8_t x = 0; x < DIGIT_WIDTH; x++){
+		for(uint8_t y = 0; y < DIGIT_HEIGHT; y++){
+			if(slot->step >= digit_dissolve_order[x][y]){
+				on = digit_pixel(&value, slot->value, x, y);
+			}else{
+				on = digit_pixel(&previous, slot->previous, x, y);
+			}
+			if(on && slot->y_offset+y >= 0 && slot->y_offset+y < ROW && slot->x_offset+x >= 0 && slot->x_offset+x < COL){
+				WS2812_framedata_setPixel(slot->y_offset+y, slot->x_offset+x, red, green, blue);
+			}
+		}
+	}
+}
+
+/**
+  * @brief  draws a number with a precalculated color
+  * @note   nothing is drawn for a blank value
+  * @retval None
+  */
+static void digit_draw_number(char value, int16_t x_offset, int8_t y_offset, uint8_t red, uint8_t green, uint8_t blue){
+	Number number;
+
+	if(value == DIGIT_BLANK){
+		return;
+	}
+	number = char_to_number(value);
+	for(uint8_t x = 0; x < DIGIT_WIDTH; x++){
+		for(uint8_t y = 0; y < DIGIT_HEIGHT; y++){
+			if(number.number_construction[x][y] != 0 && (y_offset+y >= 0) && (y_offset+y < ROW) && (x_offset+x >= 0) && (x_offset+x < COL)){
+				WS2812_framedata_setPixel(y_offset+y, x_offset+x, red, green, blue);
+			}
+		}
+	}
+}
+
+/**
+  * @brief  reads a pixel of a number
+  * @note   a blank value has no pixels
+  * @retval 1 if the pixel is on, else 0
+  */
+static uint8_t digit_pixel(Number *number, char value, uint8_t x, uint8_t y){
+	return value != DIGIT_BLANK && number->number_construction[x][y] != 0;
+}
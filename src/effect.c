@@ -0,0 +1,186 @@
+/*
+ * Autor: Nico Korn
+ * Date: 19.10.2026
+ * Firmware for a alarmlcock with custom made STM32F103 microcontroller board.
+ *  *
+ * Copyright (c) 2026 Nico Korn
+ *
+ * effect.c this module contents the effect registry and the frame by frame effect player.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+
+
+
+// ----------------------------------------------------------------------------
+
+#include "effect.h"
+#include "ws2812.h"
+
+/* private variables */
+static Effect				*effect_registry[EFFECT_REGISTRY_LENGTH];
+static uint8_t				effect_registry_count;
+static Effect				*effect_current;			// effect which is running on the display
+static uint32_t				effect_frame_tick;
+static volatile uint8_t		effect_stop_request;		// set in interrupt context, handled on the next display tick
+
+/* global variables */
+extern volatile uint8_t 		WS2812_TC;					// led transmission flag
+
+/**
+  * @brief  initialization of the effect player
+  * @note   the registry is not cleared, effects may be registered before the player is initialized
+  * @retval None
+  */
+void init_effect(void){
+	effect_current = NULL;
+	effect_stop_request = 0;
+}
+
+/**
+  * @brief  adds an effect to the registry
+  * @note   effects of a class are indexed in the order they are registered
+  * @retval 1 if the effect is registered, 0 if the registry is full
+  */
+uint8_t effect_register(Effect *effect){
+	if(effect_registry_count >= EFFECT_REGISTRY_LENGTH){
+		return 0;
+	}
+	effect_registry[effect_registry_count++] = effect;
+	return 1;
+}
+
+/**
+  * @brief  counts the registered effects of a class
+  * @note   None
+  * @retval amount of effects
+  */
+uint8_t effect_count(Effect_Class effect_class){
+	uint8_t count = 0;
+	for(uint8_t i = 0; i < effect_registry_count; i++){
+		if(effect_registry[i]->effect_class == effect_class){
+			count++;
+		}
+	}
+	return count;
+}
+
+/**
+  * @brief  gets a registered effect of a class by its index
+  * @note   None
+  * @retval pointer to the effect, NULL if there is no such effect
+  */
+Effect* effect_get(Effect_Class effect_class, uint8_t index){
+	for(uint8_t i = 0; i < effect_registry_count; i++){
+		if(effect_registry[i]->effect_class == effect_class){
+			if(index == 0){
+				return effect_registry[i];
+			}
+			index--;
+		}
+	}
+	return NULL;
+}
+
+/**
+  * @brief  starts an effect, a running effect is replaced
+  * @note   starting the effect which is already running has no effect
+  * @retval None
+  */
+void effect_play(Effect *effect){
+	if(effect == NULL || (effect == effect_current && !effect_stop_request)){
+		return;
+	}
+	effect_stop_request = 0;
+	effect->frame = 0;
+	if(effect->init != NULL){
+		effect->init(effect);
+	}
+	/* the first frame is drawn on the next display tick */
+	effect_frame_tick = HAL_GetTick() - effect->frame_period;
+	effect_current = effect;
+}
+
+/**
+  * @brief  stops the running effect
+  * @note   may be called from interrupt context
+  * @retval None
+  */
+void effect_stop(void){
+	effect_stop_request = 1;
+}
+
+/**
+  * @brief  checks if an effect is running
+  * @note   None
+  * @retval 1 if an effect is running, else 0
+  */
+uint8_t effect_running(void){
+	return effect_current != NULL && !effect_stop_request;
+}
+
+/**
+  * @brief  gets the frame period of the running effect
+  * @note   None
+  * @retval frame period in ms, 0 if no effect is running
+  */
+uint16_t effect_get_frame_period(void){
+	if(effect_current == NULL){
+		return 0;
+	}
+	return effect_current->frame_period;
+}
+
+/**
+  * @brief  draws the next frame of the running effect if its frame period has elapsed, has to be called every display tick
+  * @note   None
+  * @retval 1 if the effect owns the display, else 0
+  */
+uint8_t effect_tick(void){
+	/* handle a stop request */
+	if(effect_stop_request){
+		effect_stop_request = 0;
+		effect_current = NULL;
+	}
+	if(effect_current == NULL){
+		return 0;
+	}
+
+	/* end of the effect */
+	if(effect_current->done(effect_current)){
+		effect_current = NULL;
+		return 0;
+	}
+
+	/* keep the last frame on the display until the frame period has elapsed */
+	if(HAL_GetTick() - effect_frame_tick < effect_current->frame_period){
+		return 1;
+	}
+	effect_frame_tick = HAL_GetTick();
+
+	/* wait for the data transmission to the led's to be ready */
+	WS2812_wait_transmission();
+	/* draw the frame and send it to the leds */
+	effect_current->step(effect_current);
+	effect_current->frame++;
+	sendbuf_WS2812();
+	return 1;
+}
@@ -32,86 +32,384 @@
 #include "buzzer.h"
 #include "button.h"
 #include "ws2812.h"
+#include "latency.h"
+#include "record.h"
 #include "stm32f1xx.h"
 
 /* defines */
-#define EVENT_QUEUE_LENGTH		11 		// length of event buffer
-#define END_OF_QUEUE			((uint16_t)0x1010)
+#define EVENT_QUEUE_LENGTH		16 		// length of event buffer, has to be a power of two
+#define EVENT_QUEUE_MASK		(EVENT_QUEUE_LENGTH - 1)
+#define EVENT_RULE_NONE			0xFF	// the slot holds its event, else the index of the rule which holds it
+
+/* private types */
+/* a slot is free for the producer of position p if sequence == p, it holds the event of position p
+ * for the consumer if sequence == p + 1 */
+typedef struct {
+	volatile uint32_t		sequence;
+	Event					event;
+	uint8_t					rule;
+}Event_Slot;
+
+/* a coalescing rule holds the event of its pending position until the consumer takes it, a following
+ * event of the rule and of the same source overwrites it as long as the position is the last one */
+typedef struct {
+	Event_Type				type;
+	Event_Source			source;					// EVENT_SOURCE_NONE for all sources
+	uint8_t					pending;				// 1 while the event of the position is queued
+	uint32_t				position;
+	Event					event;
+}Event_Rule;
 
 /* variables */
-static uint16_t					event_queue[EVENT_QUEUE_LENGTH];
+static Event_Slot				event_queue[EVENT_QUEUE_LENGTH];
+static volatile uint32_t		event_head;					// next position of the producers
+static uint32_t					event_tail;					// next position of the consumer
+static volatile uint32_t		event_clear;				// the consumer drops the positions before
+static void						(*event_notify)(void);		// called after an event has been queued
+static Event_Rule				event_rules[EVENT_COALESCE_RULES];
+static uint8_t					event_rule_count;
+static Event_Stats				event_stats;				// read it with the debugger or event_get_stats()
+/* subscription table, bit n of an entry is set if subscriber n handles the type or the source */
+static uint8_t					event_type_subscribers[EVENT_TYPE_COUNT];
+static uint8_t					event_source_subscribers[EVENT_SOURCE_COUNT];
+static void						(*event_handlers[EVENT_SUBSCRIBERS])(const Event *event);
+static uint8_t					event_subscriber_count;
+
+/* private functions */
+static uint8_t event_reserve(uint32_t *position);
+static void event_publish(uint32_t position, const Event *event, uint8_t rule);
+static uint8_t event_coalesce_rule(Event_Type type, Event_Source source);
+static uint8_t event_merge(const Event *event, uint8_t rule_index);
+static void event_count(uint32_t *counter);
+
+
 
 /**
   * @brief  this function initiates the queue
-  * @param  None
+  * @note   the coalescing rules and the subscriptions are kept
   * @retval None
   */
 void init_event_engine(){
-	event_queue[0] = END_OF_QUEUE;
+	for(uint32_t i = 0; i < EVENT_QUEUE_LENGTH; i++){
+		event_queue[i].sequence = i;
+	}
+	for(uint8_t i = 0; i < event_rule_count; i++){
+		event_rules[i].pending = 0;
+	}
+	event_head = 0;
+	event_tail = 0;
+	event_clear = 0;
+	event_reset_stats();
 }
 
 /**
   * @brief  this function queues a new event
-  * @param  GPIO_Pin
-  * @retval event
+  * @note   lock free, called from the interrupts of any priority and from the main loop. The events of
+  * 		a coalescing rule are queued with disabled interrupts, as the producers share the event
+  * 		of the rule.
+  * @param  type of the event
+  * @param  source of the event
+  * @param  payload of the event, depends on the type
+  * @retval 1 if the event has been queued or merged, 0 if the queue is full
+  */
+uint8_t queue_event(Event_Type type, Event_Source source, uint16_t payload){
+	Event event = {type, source, payload, HAL_GetTick()};
+	uint8_t rule = event_coalesce_rule(type, source);
+	uint32_t position;
+	uint32_t primask;
+	uint8_t queued;
+
+	if(rule == EVENT_RULE_NONE){
+		queued = event_reserve(&position);
+		if(queued){
+			event_publish(position, &event, EVENT_RULE_NONE);
+		}
+	}else{
+		primask = __get_PRIMASK();
+		__disable_irq();
+		queued = event_merge(&event, rule);
+		__set_PRIMASK(primask);
+	}
+	if(!queued){
+		event_count(&event_stats.dropped);
+		return 0;
+	}
+
+	latency_stamp_event(LATENCY_STAGE_QUEUED, type, source);
+	RECORD_INPUT(RECORD_TYPE_EVENT, EVENT_RECORD(type, source, payload));
+	/* wake up the consumer of the queue */
+	if(event_notify != NULL){
+		event_notify();
+	}
+	return 1;
+}
+
+/**
+  * @brief  sets the function which is called after an event has been queued
+  * @note   the function is called from the interrupt which queued the event
+  * @retval None
+  */
+void event_set_notify(void (*notify)(void)){
+	event_notify = notify;
+}
+
+/**
+  * @brief  adds a coalescing rule, consecutive events of the rule are merged into the queued one,
+  * 		the consumer gets the latest of them
+  * @param  type of the merged events
+  * @param  source of the merged events, EVENT_SOURCE_NONE merges the consecutive events of every source
+  * @note   called before the interrupts queue events
+  * @retval 1 if the rule has been added, 0 if all rules are used
   */
-void queue_event(uint16_t GPIO_Pin){
-	uint16_t index = 0;
-	uint16_t run_flag = 1;
-
-	/* save button event into event queue */
-	while(index < EVENT_QUEUE_LENGTH && run_flag == 1){
-		if(event_queue[EVENT_QUEUE_LENGTH-1] == END_OF_QUEUE){	//check if queue is full
-			/* stop here because the queue is already full */
-			run_flag = 0;
-		}else if(event_queue[index] == END_OF_QUEUE){	//safe new event into queue
-			event_queue[index] = GPIO_Pin;
-			event_queue[index+1] = END_OF_QUEUE;
-			run_flag = 0;
+uint8_t event_coalesce(Event_Type type, Event_Source source){
+	if(event_rule_count >= EVENT_COALESCE_RULES){
+		return 0;
+	}
+	event_rules[event_rule_count].type = type;
+	event_rules[event_rule_count].source = source;
+	event_rules[event_rule_count].pending = 0;
+	event_rule_count++;
+	return 1;
+}
+
+/**
+  * @brief  subscribes a handler to events, the handler is called for the events with a type of the type
+  * 		mask and a source of the source mask
+  * @param  type_mask, EVENT_TYPE_BIT of the types or EVENT_TYPE_ALL
+  * @param  source_mask, EVENT_SOURCE_BIT of the sources or EVENT_SOURCE_ALL
+  * @param  handler, called by event_dispatch in the main loop
+  * @note   the subscribers are called in the order of their subscription
+  * @retval 1 if the handler has been subscribed, 0 if all subscribers are used
+  */
+uint8_t event_subscribe(uint32_t type_mask, uint32_t source_mask, void (*handler)(const Event *event)){
+	uint8_t subscriber = event_subscriber_count;
+
+	if(subscriber >= EVENT_SUBSCRIBERS || handler == NULL){
+		return 0;
+	}
+	for(uint8_t type = 0; type < EVENT_TYPE_COUNT; type++){
+		if(type_mask & EVENT_TYPE_BIT(type)){
+			event_type_subscribers[type] |= 1 << subscriber;
+		}
+	}
+	for(uint8_t source = 0; source < EVENT_SOURCE_COUNT; source++){
+		if(source_mask & EVENT_SOURCE_BIT(source)){
+			event_source_subscribers[source] |= 1 << subscriber;
+		}
+	}
+	event_handlers[subscriber] = handler;
+	event_subscriber_count++;
+	return 1;
+}
+
+/**
+  * @brief  calls the subscribers of an event
+  * @param  event, usually from unqueue_event
+  * @note   the subscribers of the event are the set bits of the type and the source entries, the loop
+  * 		ends after the last of them
+  * @retval None
+  */
+void event_dispatch(const Event *event){
+	uint8_t subscribers;
+	uint8_t subscriber;
+
+	if(event->type >= EVENT_TYPE_COUNT || event->source >= EVENT_SOURCE_COUNT){
+		return;
+	}
+	subscribers = event_type_subscribers[event->type] & event_source_subscribers[event->source];
+	for(subscriber = 0; subscribers != 0; subscriber++, subscribers >>= 1){
+		if(subscribers & 1){
+			event_handlers[subscriber](event);
 		}
-		index++;
 	}
 }
 
 /**
   * @brief  this function takes out recent events from the queue
-  * @param  None
-  * @retval event
+  * @param  event which is filled with the oldest event
+  * @note   single consumer, only called from the main loop
+  * @retval 1 if an event has been unqueued, 0 if the queue is empty
   */
-uint16_t unqueue_event(void){
-	uint16_t latest_event;
-	uint16_t index = 0;
-
-	/* save first entity of the event queue into local variable */
-	latest_event = event_queue[0];
-
-	/* check for new event */
-	if(latest_event != END_OF_QUEUE){
-
-		/* shift event queue, because the newest event has been taken out */
-		do{
-			event_queue[index] = event_queue[index+1];
-			index++;
-		}while(event_queue[index-1] != END_OF_QUEUE);
-		/* only 1 END_OF_QUEUE shall be as the last valid queue entity -> empty entities shall have zeros e.g. [0] = BUTTON_1, [1] = END_OF_QUEUE, [2...10] = 0 */
-		event_queue[index] = 0;
-	}else{
-		/* do nothing, because no new event has been saved into the event queue: first entity -> END_OF_QUEUE */
+uint8_t unqueue_event(Event *event){
+	Event_Slot *slot;
+	Event_Rule *rule;
+	uint32_t primask;
+	uint32_t level;
+
+	/* only the consumer shrinks the queue, it sees every maximum */
+	level = event_head - event_tail;
+	if(level > event_stats.high_watermark){
+		event_stats.high_watermark = level;
+	}
+
+	while(1){
+		slot = &event_queue[event_tail & EVENT_QUEUE_MASK];
+		if(slot->sequence != event_tail + 1){
+			/* empty, or the producer of the position has not published its event yet */
+			return 0;
+		}
+		__DMB();
+		if(slot->rule == EVENT_RULE_NONE){
+			*event = slot->event;
+		}else{
+			/* take the latest event of the rule, the next event of the rule is queued again. A rule which
+			 * has been released by a clear may hold a newer position, the slot is dropped then. */
+			rule = &event_rules[slot->rule];
+			primask = __get_PRIMASK();
+			__disable_irq();
+			if(rule->pending && rule->position == event_tail){
+				*event = rule->event;
+				rule->pending = 0;
+			}else{
+				*event = slot->event;
+			}
+			__set_PRIMASK(primask);
+		}
+		/* free the slot for the producers of the next round */
+		slot->sequence = event_tail + EVENT_QUEUE_LENGTH;
+		event_tail++;
+		/* events which have been queued before a clear are dropped */
+		if((int32_t)(event_clear - event_tail) < 0){
+			return 1;
+		}
 	}
-	return latest_event;
 }
 
 /**
   * @brief  this function clears the event queue
-  * @param  None
+  * @note   called from the producers, the consumer drops the events which are queued at the moment
   * @retval None
   */
 void clear_event_queue(void){
-	uint16_t index = 0;
+	event_clear = event_head;
+}
+
+/**
+  * @brief  get the counters of the event queue
+  * @note   None
+  * @retval counters
+  */
+Event_Stats* event_get_stats(void){
+	return &event_stats;
+}
+
+/**
+  * @brief  clears the counters of the event queue
+  * @note   None
+  * @retval None
+  */
+void event_reset_stats(void){
+	uint32_t primask = __get_PRIMASK();
 
-	/* fill the event queue with zeros and put END_OF_QUEUE at the begining of the queue */
-	for(index = 0; index < EVENT_QUEUE_LENGTH; index++){
-		event_queue[index] = 0;
+	__disable_irq();
+	event_stats.coalesced = 0;
+	event_stats.dropped = 0;
+	event_stats.high_watermark = 0;
+	__set_PRIMASK(primask);
+}
+
+/**
+  * @brief  reserves the next position of the queue
+  * @note   the position is reserved with ldrex/strex, an interrupt between them clears the exclusive
+  * 		monitor and the reservation is retried. A higher interrupt can publish its event before the
+  * 		interrupted producer, the consumer then waits for the event of the lower position.
+  * @retval 1 if the position has been reserved, 0 if the queue is full
+  */
+static uint8_t event_reserve(uint32_t *position){
+	int32_t difference;
+
+	while(1){
+		*position = __LDREXW(&event_head);
+		difference = (int32_t)(event_queue[*position & EVENT_QUEUE_MASK].sequence - *position);
+		if(difference < 0){
+			/* the consumer has not freed the slot yet, the queue is full */
+			__CLREX();
+			return 0;
+		}else if(difference > 0){
+			/* another producer has taken the position, read the head again */
+			__CLREX();
+		}else if(__STREXW(*position + 1, &event_head) == 0){
+			return 1;
+		}
 	}
-	event_queue[0] = END_OF_QUEUE;
+}
+
+/**
+  * @brief  writes the event into the slot of the reserved position and hands it over to the consumer
+  * @param  position which has been reserved
+  * @param  event to publish
+  * @param  rule which holds the event, EVENT_RULE_NONE if the slot holds it
+  * @retval None
+  */
+static void event_publish(uint32_t position, const Event *event, uint8_t rule){
+	Event_Slot *slot = &event_queue[position & EVENT_QUEUE_MASK];
+
+	slot->event = *event;
+	slot->rule = rule;
+	__DMB();
+	slot->sequence = position + 1;
+}
+
+/**
+  * @brief  looks up the coalescing rule of an event
+  * @note   None
+  * @retval index of the rule, EVENT_RULE_NONE if the event is not merged
+  */
+static uint8_t event_coalesce_rule(Event_Type type, Event_Source source){
+	for(uint8_t i = 0; i < event_rule_count; i++){
+		if(event_rules[i].type == type && (event_rules[i].source == EVENT_SOURCE_NONE || event_rules[i].source == source)){
+			return i;
+		}
+	}
+	return EVENT_RULE_NONE;
+}
+
+/**
+  * @brief  merges an event into the pending event of its rule or queues it
+  * @note   called with disabled interrupts. The event is merged only if the pending position is the
+  * 		last queued one and has not been cleared, else it is queued with its own slot to keep the
+  * 		order of the events.
+  * @retval 1 if the event has been merged or queued, 0 if the queue is full
+  */
+static uint8_t event_merge(const Event *event, uint8_t rule_index){
+	Event_Rule *rule = &event_rules[rule_index];
+	uint32_t position;
+
+	if(rule->pending && (int32_t)(rule->position - event_clear) < 0){
+		/* the consumer drops the pending position, the rule is free for a new one */
+		rule->pending = 0;
+	}
+	if(rule->pending){
+		if(rule->event.source == event->source && rule->position + 1 == event_head){
+			rule->event = *event;
+			event_stats.coalesced++;
+			return 1;
+		}
+		if(!event_reserve(&position)){
+			return 0;
+		}
+		event_publish(position, event, EVENT_RULE_NONE);
+		return 1;
+	}
+	if(!event_reserve(&position)){
+		return 0;
+	}
+	rule->event = *event;
+	rule->position = position;
+	rule->pending = 1;
+	event_publish(position, event, rule_index);
+	return 1;
+}
+
+/**
+  * @brief  counts up a counter which is shared by the producers
+  * @note   lock free with ldrex/strex
+  * @retval None
+  */
+static void event_count(uint32_t *counter){
+	uint32_t value;
+
+	do{
+		value = __LDREXW(counter) + 1;
+	}while(__STREXW(value, counter) != 0);
 }
@@ -0,0 +1,220 @@
+/*
+ * Autor: Nico Korn
+ * Date: 19.10.2026
+ * Firmware for a alarmlcock with custom made STM32F103 microcontroller board.
+ *  *
+ * Copyright (c) 2026 Nico Korn
+ *
+ * latency.c this module contents the button to photon latency measurement
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+
+
+
+// ----------------------------------------------------------------------------
+
+#include "latency.h"
+#include "cyclecounter.h"
+
+/* defines */
+#define LATENCY_IDLE			LATENCY_STAGE_COUNT		// no measurement in progress
+
+/* private variables */
+static Latency_Stats		latency_stats[LATENCY_EVENT_COUNT];		// read it with the debugger or latency_get_stats()
+static uint32_t				latency_stamps[LATENCY_STAGE_COUNT];	// cycle counter of the last measurement
+static uint32_t				latency_dropped;						// measurements which have been restarted or had no event type
+static volatile uint8_t		latency_next_stage = LATENCY_IDLE;
+static Event_Type			latency_type;
+static Event_Source			latency_source;
+
+/* global variables */
+
+/* private functions */
+static uint8_t latency_event_type(Event_Type type, Event_Source source);
+static uint8_t latency_bin(uint32_t us);
+static void latency_record(void);
+
+
+
+/**
+  * @brief  initialization of the latency measurement
+  * @note   the cycle counter has to be initialized
+  * @retval None
+  */
+void init_latency(void){
+	latency_reset();
+}
+
+/**
+  * @brief  stamps a stage of the measurement which belongs to an event
+  * @param  stage which is passed
+  * @param  type of the event of the stage, EVENT_TYPE_PRESS for LATENCY_STAGE_EXTI
+  * @param  source of the event of the stage
+  * @note   the exti stage starts a new measurement, the unqueued stage has to be the measured event
+  * @retval None
+  */
+void latency_stamp_event(Latency_Stage stage, Event_Type type, Event_Source source){
+	uint32_t primask = __get_PRIMASK();
+
+	__disable_irq();
+	if(stage == LATENCY_STAGE_EXTI){
+		if(latency_next_stage != LATENCY_IDLE){
+			latency_dropped++;
+		}
+		latency_type = type;
+		latency_source = source;
+		latency_stamps[stage] = get_cyclecount();
+		latency_next_stage = LATENCY_STAGE_QUEUED;
+	}else if(latency_next_stage == stage && (stage == LATENCY_STAGE_QUEUED || (type == latency_type && source == latency_source))){
+		latency_type = type;		// the queued type of a double click differs from the press of the exti
+		latency_source = source;
+		latency_stamps[stage] = get_cyclecount();
+		latency_next_stage = stage + 1;
+	}
+	__set_PRIMASK(primask);
+}
+
+/**
+  * @brief  stamps a stage of the measurement on the way to the leds
+  * @param  stage which is passed
+  * @note   called for every frame, it returns at once if the stage is not the next of the measurement
+  * @retval None
+  */
+void latency_stamp(Latency_Stage stage){
+	uint32_t primask;
+
+	if(latency_next_stage != stage){
+		return;
+	}
+	primask = __get_PRIMASK();
+	__disable_irq();
+	if(latency_next_stage == stage){
+		latency_stamps[stage] = get_cyclecount();
+		latency_next_stage = stage + 1;
+		if(stage == LATENCY_STAGE_TRANSFER_COMPLETE){
+			latency_record();
+			latency_next_stage = LATENCY_IDLE;
+		}
+	}
+	__set_PRIMASK(primask);
+}
+
+/**
+  * @brief  get the statistics of an event type
+  * @note   None
+  * @retval statistics
+  */
+Latency_Stats* latency_get_stats(Latency_Event type){
+	return &latency_stats[type];
+}
+
+/**
+  * @brief  get the amount of dropped measurements
+  * @note   None
+  * @retval dropped measurements
+  */
+uint32_t latency_get_dropped(void){
+	return latency_dropped;
+}
+
+/**
+  * @brief  clears all statistics and stops a running measurement
+  * @note   None
+  * @retval None
+  */
+void latency_reset(void){
+	uint32_t primask = __get_PRIMASK();
+
+	__disable_irq();
+	for(uint8_t type = 0; type < LATENCY_EVENT_COUNT; type++){
+		latency_stats[type].count = 0;
+		latency_stats[type].max = 0;
+		for(uint8_t stage = 0; stage < LATENCY_STAGE_COUNT; stage++){
+			latency_stats[type].stage_sum[stage] = 0;
+		}
+		for(uint8_t bin = 0; bin < LATENCY_BINS; bin++){
+			latency_stats[type].histogram[bin] = 0;
+		}
+	}
+	latency_dropped = 0;
+	latency_next_stage = LATENCY_IDLE;
+	__set_PRIMASK(primask);
+}
+
+/**
+  * @brief  maps the type and the source of an event to the latency event type
+  * @note   None
+  * @retval latency event type, LATENCY_EVENT_COUNT if the event is not measured
+  */
+static uint8_t latency_event_type(Event_Type type, Event_Source source){
+	switch(source){
+		case EVENT_SOURCE_MODE:			return LATENCY_EVENT_MODE;
+		case EVENT_SOURCE_PLUS:			return LATENCY_EVENT_PLUS;
+		case EVENT_SOURCE_MINUS:		return LATENCY_EVENT_MINUS;
+		case EVENT_SOURCE_SNOOZE:		return type == EVENT_TYPE_DOUBLE_CLICK ? LATENCY_EVENT_SNOOZE_DOUBLE : LATENCY_EVENT_SNOOZE;
+		case EVENT_SOURCE_SWITCH_ALARM:	return LATENCY_EVENT_SWITCH_ALARM;
+		default:						return LATENCY_EVENT_COUNT;
+	}
+}
+
+/**
+  * @brief  histogram bin of a latency
+  * @note   None
+  * @retval bin, the position of the highest set bit
+  */
+static uint8_t latency_bin(uint32_t us){
+	uint8_t bin = 0;
+
+	while(us != 0 && bin < LATENCY_BINS - 1){
+		us >>= 1;
+		bin++;
+	}
+	return bin;
+}
+
+/**
+  * @brief  adds the finished measurement to the statistics of its event type
+  * @note   called with disabled interrupts
+  * @retval None
+  */
+static void latency_record(void){
+	uint8_t type = latency_event_type(latency_type, latency_source);
+	uint32_t total;
+	Latency_Stats *stats;
+
+	if(type == LATENCY_EVENT_COUNT){
+		latency_dropped++;
+		return;
+	}
+	stats = &latency_stats[type];
+	for(uint8_t stage = LATENCY_STAGE_QUEUED; stage < LATENCY_STAGE_COUNT; stage++){
+		stats->stage_sum[stage] += cycles_to_us(latency_stamps[stage] - latency_stamps[stage - 1]);
+	}
+	total = cycles_to_us(latency_stamps[LATENCY_STAGE_TRANSFER_COMPLETE] - latency_stamps[LATENCY_STAGE_EXTI]);
+	if(total > stats->max){
+		stats->max = total;
+	}
+	if(stats->histogram[latency_bin(total)] < 0xFFFF){
+		stats->histogram[latency_bin(total)]++;
+	}
+	stats->count++;
+}
@@ -29,6 +29,8 @@
 // ----------------------------------------------------------------------------
 
 #include "lightsensor.h"
+#include "profile.h"
+#include "record.h"
 
 /* defines */
 #define BUFFERSIZE			32
@@ -57,6 +59,8 @@ void init_lightsensor(Alarmclock *alarmclock_param){
 	init_filter();
 	/* safe address into alarmclock object */
 	alarmclock_param->ambient_light_factor = &ambientlight_factor;
+	/* start with the lowest brightness of the filter range, the display is not dark until the first measurements are done */
+	ambientlight_factor = 2;
 	/* init peripherals for lightsensor */
 	init_gpio_lightsensor();
 	init_dma_lightsensor();
@@ -227,11 +231,17 @@ void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef* hadc){
 	//static const uint16_t schmitt_base_th = 2;
 	static uint16_t schmitt_ex_th = 2;
 
+	PROFILE_BEGIN(PROFILE_SCOPE_ADC_CONV_CPLT);
+
 	/* init the filter with zeros */
 	for(uint16_t i = BUFFERSIZE-1; i>0; i--){
 		adc_buffer[i] = adc_buffer[i-1];
 		array_cumulus += adc_buffer[i];
 	}
+	#ifdef RECORD_REPLAY
+	adc_raw = record_replay_adc(adc_raw);
+	#endif
+	RECORD_INPUT(RECORD_TYPE_ADC, adc_raw);
 	adc_buffer[0] = adc_raw;
 	array_cumulus += adc_buffer[0];
 
@@ -243,15 +253,18 @@ void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef* hadc){
 		//ambientlight_factor = 1;
 		if(ambientlight_factor > 2){
 			ambientlight_factor--;
+			clock_request_redraw();	// the brightness of the clock face changed
 		}
 		schmitt_ex_th = 3;//schmitt_base_th + 2;
 	}else{
 		if(ambientlight_factor < 26){
 			ambientlight_factor++;
+			clock_request_redraw();
 		}
 		//ambientlight_factor = 25; //24
 		schmitt_ex_th = 0;//schmitt_base_th - 2;
 	}
+	PROFILE_END(PROFILE_SCOPE_ADC_CONV_CPLT);
 }
 
 /**
@@ -30,13 +30,124 @@
 #include "main.h"
 
 /* defines */
-#define CLOCK_REFRESH_PERIOD		50 		// refresh period in ms
+#define CLOCK_REFRESH_PERIOD		50 		// render period in ms, the clock face itself is only redrawn on a new second
+#define SENSOR_PERIOD				50		// in ms
+#define PREFERENCES_FLUSH_DELAY		1000	// in ms after the last change
+/* uncomment this to show the name of a task which overran its budget as notification */
+//#define REPORT_OVERRUN
+/* comment this to play the intro at startup, with fast boot the time is shown in the first frame after reset */
+#define FAST_BOOT
 
 /* variables */
 Alarmclock			alarmclock;
+uint32_t			boot_profile[BOOT_STAGE_COUNT];		// cycles of every boot stage, read it with the debugger
+static uint32_t		boot_stage_start;
 
 /* function prototypes */
 void SystemClock_Config(void);
+static void boot_stage_done(Boot_Stage stage);
+static void input_task(void);
+static void input_notify(void);
+static void handle_event(const Event *event);
+static Mode_Event mode_event_index(const Event *event);
+static void mode_transition(Wordclock_Mode mode);
+static void mode_entry(Alarmclock *alarmclock_param);
+static void mode_next(Alarmclock *alarmclock_param);
+static void clock_entry(Alarmclock *alarmclock_param);
+static void clock_exit(Alarmclock *alarmclock_param);
+static void clock_render(Alarmclock *alarmclock_param);
+static void clock_mode_button(Alarmclock *alarmclock_param);
+static void clock_color_plus(Alarmclock *alarmclock_param);
+static void clock_color_minus(Alarmclock *alarmclock_param);
+static void clock_snooze_button(Alarmclock *alarmclock_param);
+static void clock_snooze_double(Alarmclock *alarmclock_param);
+static void clock_alarm_switch(Alarmclock *alarmclock_param);
+static void clock_follow_alarm_switch(Alarmclock *alarmclock_param);
+static void clock_buzzer(Alarmclock *alarmclock_param);
+static void setup_exit(Alarmclock *alarmclock_param);
+static void setup_time_render(Alarmclock *alarmclock_param);
+static void setup_alarm_select_render(Alarmclock *alarmclock_param);
+static void setup_alarm_rule_render(Alarmclock *alarmclock_param);
+static void setup_snooze_render(Alarmclock *alarmclock_param);
+static void setup_alarm_style_exit(Alarmclock *alarmclock_param);
+static void setup_alarm_style_render(Alarmclock *alarmclock_param);
+static void lux_render(Alarmclock *alarmclock_param);
+static void render_task(void);
+static void sensor_task(void);
+static void preferences_task(void);
+static void request_preferences_flush(void);
+static void task_overrun(Task *task);
+#ifdef PROFILE
+static void profile_task(void);
+#endif
+#ifdef RECORD
+static void record_task(void);
+#endif
+#ifdef RECORD_REPLAY
+static void replay_task(void);
+#endif
+
+/* tasks						name			run					period					budget in us	release, active and statistics are set by scheduler_add() */
+static Task			task_input = 		{"input",		input_task,			0,						1000,			0, 0, 0, 0, 0, 0, 0, 0};
+static Task			task_render = 		{"render",		render_task,		CLOCK_REFRESH_PERIOD,	8000,			0, 0, 0, 0, 0, 0, 0, 0};
+static Task			task_sensor = 		{"sensor",		sensor_task,		SENSOR_PERIOD,			50,				0, 0, 0, 0, 0, 0, 0, 0};
+static Task			task_preferences =	{"prefs",		preferences_task,	0,						100,			0, 0, 0, 0, 0, 0, 0, 0};
+#ifdef PROFILE
+static Task			task_profile =		{"profile",		profile_task,		PROFILE_REPORT_PERIOD,	5000,			0, 0, 0, 0, 0, 0, 0, 0};
+#endif
+#ifdef RECORD
+static Task			task_record =		{"record",		record_task,		RECORD_FLUSH_PERIOD,	2000,			0, 0, 0, 0, 0, 0, 0, 0};
+#endif
+#ifdef RECORD_REPLAY
+static Task			task_replay =		{"replay",		replay_task,		RECORD_REPLAY_PERIOD,	500,			0, 0, 0, 0, 0, 0, 0, 0};
+#endif
+
+/* mode fsm, an event without action is ignored in the mode */
+static const Mode_State	mode_states[MODE_COUNT] = {
+	[MODE_TIME_CLOCK] = 			{clock_entry,	clock_exit,				clock_render,				{
+										[MODE_EVENT_MODE] = 			clock_mode_button,
+										[MODE_EVENT_PLUS] = 			clock_color_plus,
+										[MODE_EVENT_MINUS] = 			clock_color_minus,
+										[MODE_EVENT_SNOOZE] = 			clock_snooze_button,
+										[MODE_EVENT_SNOOZE_DOUBLE] = 	clock_snooze_double,
+										[MODE_EVENT_SWITCH_ALARM] = 	clock_alarm_switch,
+										[MODE_EVENT_BUZZER] = 			clock_buzzer}},
+	[MODE_TIME_SET_CLOCK_h] = 		{mode_entry,	0,						setup_time_render,			{
+										[MODE_EVENT_MODE] = 			mode_next,
+										[MODE_EVENT_PLUS] = 			led_clock_hour_plus,
+										[MODE_EVENT_MINUS] = 			led_clock_hour_minus}},
+	[MODE_TIME_SET_CLOCK_min] = 	{mode_entry,	0,						setup_time_render,			{
+										[MODE_EVENT_MODE] = 			mode_next,
+										[MODE_EVENT_PLUS] = 			led_clock_minute_plus,
+										[MODE_EVENT_MINUS] = 			led_clock_minute_minus}},
+	[MODE_TIME_SET_ALARM_SELECT] = 	{mode_entry,	load_alarm_setup,		setup_alarm_select_render,	{
+										[MODE_EVENT_MODE] = 			mode_next,
+										[MODE_EVENT_PLUS] = 			alarm_select_plus,
+										[MODE_EVENT_MINUS] = 			alarm_select_minus,
+										[MODE_EVENT_SNOOZE] = 			alarm_select_skip}},
+	[MODE_TIME_SET_ALARM_h] = 		{mode_entry,	0,						setup_time_render,			{
+										[MODE_EVENT_MODE] = 			mode_next,
+										[MODE_EVENT_PLUS] = 			led_alarm_hour_plus,
+										[MODE_EVENT_MINUS] = 			led_alarm_hour_minus}},
+	[MODE_TIME_SET_ALARM_min] = 	{mode_entry,	0,						setup_time_render,			{
+										[MODE_EVENT_MODE] = 			mode_next,
+										[MODE_EVENT_PLUS] = 			led_alarm_minute_plus,
+										[MODE_EVENT_MINUS] = 			led_alarm_minute_minus}},
+	[MODE_TIME_SET_ALARM_RULE] = 	{mode_entry,	store_alarm_setup,		setup_alarm_rule_render,	{	// the alarm table is written when the mode is left
+										[MODE_EVENT_MODE] = 			mode_next,
+										[MODE_EVENT_PLUS] = 			alarm_rule_plus,
+										[MODE_EVENT_MINUS] = 			alarm_rule_minus}},
+	[MODE_TIME_SET_SNOOZE] = 		{mode_entry,	setup_exit,				setup_snooze_render,		{
+										[MODE_EVENT_MODE] = 			mode_next,
+										[MODE_EVENT_PLUS] = 			snooze_plus,
+										[MODE_EVENT_MINUS] = 			snooze_minus}},
+	[MODE_TIME_SET_ALARM_STYLE] = 	{mode_entry,	setup_alarm_style_exit,	setup_alarm_style_render,	{
+										[MODE_EVENT_MODE] = 			mode_next,
+										[MODE_EVENT_PLUS] = 			alarm_style_plus,
+										[MODE_EVENT_MINUS] = 			alarm_style_minus}},
+	[MODE_TIME_LUX] = 				{mode_entry,	0,						lux_render,					{	// only entered if #define DEV_MODE is uncommented in clock.c
+										[MODE_EVENT_MODE] = 			mode_next}}
+};
 
 /**
   * @brief  Main program
@@ -45,6 +156,10 @@ void SystemClock_Config(void);
   */
 int main(void){
 
+	/* start cycle counter for the boot profile */
+	init_cyclecounter();
+	boot_stage_start = get_cyclecount();
+
 	/* STM32F103xG HAL library initialization:
        - Configure the Flash prefetch
        - Systick timer is configured by default as source of time base, but user 
@@ -56,216 +171,532 @@ int main(void){
        - Low Level Initialization
     */
 	HAL_Init();
+	boot_stage_done(BOOT_STAGE_HAL);
 
 	/* Configure the system clock to 72 MHz */
 	SystemClock_Config();
+	boot_stage_done(BOOT_STAGE_SYSTEM_CLOCK);
 
 	/* initialize ws2812 peripherals */
 	init_ws2812();
+	boot_stage_done(BOOT_STAGE_WS2812);
+
+	/* initialize particle engine, its effects have to be registered before the alarm style is loaded */
+	init_particle();
+	boot_stage_done(BOOT_STAGE_PARTICLE);
 
 	/* initialize buttons */
 	init_buttons();
+	boot_stage_done(BOOT_STAGE_BUTTONS);
 
 	/* initialize buzzer */
 	init_buzzer(&alarmclock);
+	boot_stage_done(BOOT_STAGE_BUZZER);
 
 	/* initialize light sensor */
 	init_lightsensor(&alarmclock);
+	boot_stage_done(BOOT_STAGE_LIGHTSENSOR);
+
+	/* initialize animations, the same applies to the animation effects, their colors follow the ambient light */
+	init_animation(alarmclock.ambient_light_factor);
+	boot_stage_done(BOOT_STAGE_ANIMATION);
 
 	/* initialize RTC and init mode */
 	init_clock(&alarmclock);
+	boot_stage_done(BOOT_STAGE_CLOCK);
 
 	/* init event queue with end flag */
 	init_event_engine();
+	/* the input task gets the latest repeat of a held button and the latest buzzer toggle if it lags */
+	event_coalesce(EVENT_TYPE_REPEAT, EVENT_SOURCE_NONE);
+	event_coalesce(EVENT_TYPE_BEEP, EVENT_SOURCE_BUZZER);
+	/* init button to photon latency measurement */
+	init_latency();
+	/* init recording of the inputs */
+	init_record();
+	boot_stage_done(BOOT_STAGE_EVENT);
+
+	/* init ticker and notification queue for messages on the display */
+	init_ticker();
+	init_notification(&alarmclock.red, &alarmclock.green, &alarmclock.blue, alarmclock.ambient_light_factor);
+	boot_stage_done(BOOT_STAGE_NOTIFICATION);
+
+	/* init effect player */
+	init_effect();
+	boot_stage_done(BOOT_STAGE_EFFECT);
+
+	#ifdef BENCHMARK
+	/* measure the render workloads, the first frame stage of the boot profile includes them */
+	benchmark_run(&alarmclock, benchmark_itm_output);
+	#endif
 
-	/* show alarmclock intro */
+	#ifdef FAST_BOOT
+	/* show the time without the number change effect */
+	show_time(&alarmclock);
+	#else
+	/* show alarmclock intro, it runs on the effect player */
 	clock_intro();
+	#endif
+	boot_stage_done(BOOT_STAGE_FIRST_FRAME);
 
+	/* the tasks replace the fixed 50 ms super loop, the registration order is the priority */
+	init_scheduler(task_overrun);
+	scheduler_add(&task_input);
+	scheduler_add(&task_render);
+	scheduler_add(&task_sensor);
+	scheduler_add(&task_preferences);
+	#ifdef PROFILE
+	init_profile();
+	scheduler_add(&task_profile);
+	#endif
+	#ifdef RECORD
+	scheduler_add(&task_record);
+	#endif
+	#ifdef RECORD_REPLAY
+	record_replay_start(record_scenario, record_scenario_length, &alarmclock);
+	scheduler_add(&task_replay);
+	#endif
+	/* the input task is released by the queued events and dispatches them, the mode fsm subscribes to
+	 * the buttons, the switch and the buzzer */
+	event_subscribe(EVENT_TYPE_BIT(EVENT_TYPE_PRESS) | EVENT_TYPE_BIT(EVENT_TYPE_LONG_PRESS) | EVENT_TYPE_BIT(EVENT_TYPE_REPEAT)
+			| EVENT_TYPE_BIT(EVENT_TYPE_DOUBLE_CLICK) | EVENT_TYPE_BIT(EVENT_TYPE_SWITCH) | EVENT_TYPE_BIT(EVENT_TYPE_BEEP),
+			EVENT_SOURCE_ALL, handle_event);
+	event_set_notify(input_notify);
+	scheduler_start(&task_input, 0);
+
+	/* sleep until the next task release or an interrupt */
+	init_power();
 	while (1){
-		/* check for new events */
-		alarmclock.event = unqueue_event();
-		/* finite state machine */
-		switch(alarmclock.mode){
-			case MODE_TIME_CLOCK:			if(read_alarm_switch()){	// read if the switch for alarm is on or off
-												set_alarm_irq(ENABLE, &alarmclock);
-											}else{
-												set_alarm_irq(DISABLE, &alarmclock);
-												if(alarmclock.buzzer_state == BUZZER_SET){	// only if snooze is activated it should be deactivated
-													buzzer_stop(&alarmclock);
-													snooze_reset(&alarmclock);
-												}else if(alarmclock.snooze_state == SNOOZE_SET){
-													snooze_reset(&alarmclock);
-												}
-											}
-											switch(alarmclock.event){
-												case BUTTON_MODE:			if(alarmclock.buzzer_state == BUZZER_SET){	// only if snooze is activated it should be deactivated
-																				buzzer_stop(&alarmclock);
-																				snooze_reset(&alarmclock);
-																				draw_string("snooze off", 0, 0, &alarmclock.red, &alarmclock.green, &alarmclock.blue, alarmclock.ambient_light_factor);
-																			}else if(alarmclock.snooze_state == SNOOZE_SET){
-																				snooze_reset(&alarmclock);
-																				draw_string("snooze off", 0, 0, &alarmclock.red, &alarmclock.green, &alarmclock.blue, alarmclock.ambient_light_factor);
-																			}
-																			increment_mode(&alarmclock);
-												break;
-												case BUTTON_PLUS:			increment_clock_color(&alarmclock);
-																			set_clock_preferences(&alarmclock);	// set preferences
-												break;
-												case BUTTON_MINUS:			decrement_clock_color(&alarmclock);
-																			set_clock_preferences(&alarmclock);	// set preferences
-												break;
-												case BUTTON_SNOOZE: 		if(alarmclock.buzzer_state == BUZZER_SET){	// only if buzzer is running, snooze should be enabled
-																				buzzer_stop(&alarmclock);
-																				snooze(&alarmclock);
-																			}
-												break;
-												case BUTTON_SNOOZE_DOUBLE:	if(alarmclock.snooze_state == SNOOZE_SET){
-																				snooze_reset(&alarmclock);
-																				draw_string("snooze off", 0, 0, &alarmclock.red, &alarmclock.green, &alarmclock.blue, alarmclock.ambient_light_factor);
-																			}
-												break;
-												case SWITCH_ALARM:			if(read_alarm_switch()){	// read if the switch for alarm is on or off
-																				draw_string("alarm on", 0, 0, &alarmclock.red, &alarmclock.green, &alarmclock.blue, alarmclock.ambient_light_factor);
-																			}else{
-																				draw_string("alarm off", 0, 0, &alarmclock.red, &alarmclock.green, &alarmclock.blue, alarmclock.ambient_light_factor);
-																			}
-												break;
-												case BUZZER_PIN:			show_alarm_style(&alarmclock);
-												break;
-											}
-											if(alarmclock.mode == MODE_TIME_CLOCK){
-												refresh_clock_display(&alarmclock);		// refresh clock
-											}
-			break;
-			case MODE_TIME_SET_CLOCK_h:		switch(alarmclock.event){
-												case BUTTON_MODE:	increment_mode(&alarmclock);
-												break;
-												case BUTTON_PLUS:	led_clock_hour_plus(&alarmclock);
-												break;
-												case BUTTON_MINUS:	led_clock_hour_minus(&alarmclock);
-												break;
-												case BUTTON_SNOOZE:	;
-												break;
-												case SWITCH_ALARM:	;
-												break;
-											}
-											if(alarmclock.mode == MODE_TIME_SET_CLOCK_h){
-												setup_clock_blinking(&alarmclock);			// let the hours blink
-											}
-			break;
-			case MODE_TIME_SET_CLOCK_min:	switch(alarmclock.event){
-												case BUTTON_MODE:	increment_mode(&alarmclock);
-												break;
-												case BUTTON_PLUS:	led_clock_minute_plus(&alarmclock);
-												break;
-												case BUTTON_MINUS:	led_clock_minute_minus(&alarmclock);
-												break;
-												case BUTTON_SNOOZE:	;
-												break;
-												case SWITCH_ALARM:	;
-												break;
-											}
-											if(alarmclock.mode == MODE_TIME_SET_CLOCK_min){
-												setup_clock_blinking(&alarmclock);		// let the minutes blink
-											}
-			break;
-			case MODE_TIME_SET_ALARM_h:		switch(alarmclock.event){
-												case BUTTON_MODE:	increment_mode(&alarmclock);
-												break;
-												case BUTTON_PLUS:	led_alarm_hour_plus(&alarmclock);
-																	set_clock_preferences(&alarmclock);	// set preferences
-												break;
-												case BUTTON_MINUS:	led_alarm_hour_minus(&alarmclock);
-																	set_clock_preferences(&alarmclock);	// set preferences
-												break;
-												case BUTTON_SNOOZE:	;
-												break;
-												case SWITCH_ALARM:	;
-												break;
-											}
-											if(alarmclock.mode == MODE_TIME_SET_ALARM_h){
-												setup_clock_blinking(&alarmclock);		// let the hours blink
-											}
-			break;
-			case MODE_TIME_SET_ALARM_min:	switch(alarmclock.event){
-												case BUTTON_MODE:	increment_mode(&alarmclock);
-												break;
-												case BUTTON_PLUS:	led_alarm_minute_plus(&alarmclock);
-																	set_clock_preferences(&alarmclock);	// set preferences
-												break;
-												case BUTTON_MINUS:	led_alarm_minute_minus(&alarmclock);
-																	set_clock_preferences(&alarmclock);	// set preferences
-												break;
-												case BUTTON_SNOOZE:	;
-												break;
-												case SWITCH_ALARM:	;
-												break;
-											}
-											if(alarmclock.mode == MODE_TIME_SET_ALARM_min){
-												setup_clock_blinking(&alarmclock);		// let the minutes blink
-											}
-			break;
-			case MODE_TIME_SET_SNOOZE:		switch(alarmclock.event){
-												case BUTTON_MODE:	increment_mode(&alarmclock);
-												break;
-												case BUTTON_PLUS:	snooze_plus(&alarmclock);
-																	set_clock_preferences(&alarmclock);	// set preferences
-												break;
-												case BUTTON_MINUS:	snooze_minus(&alarmclock);
-																	set_clock_preferences(&alarmclock);	// set preferences
-												break;
-												case BUTTON_SNOOZE:	;
-												break;
-												case SWITCH_ALARM:	;
-												break;
-											}
-											if(alarmclock.mode == MODE_TIME_SET_SNOOZE){
-												draw_snooze(&alarmclock);
-											}
-			break;
-			case MODE_TIME_SET_ALARM_STYLE:	switch(alarmclock.event){
-												case BUTTON_MODE:	increment_mode(&alarmclock);
-												break;
-												case BUTTON_PLUS:	alarm_style_plus(&alarmclock);
-																	set_clock_preferences(&alarmclock);	// set preferences
-												break;
-												case BUTTON_MINUS:	alarm_style_minus(&alarmclock);
-																	set_clock_preferences(&alarmclock);	// set preferences
-												break;
-												case BUTTON_SNOOZE:	;
-												break;
-												case SWITCH_ALARM:	;
-												break;
-											}
-											if(alarmclock.mode == MODE_TIME_SET_ALARM_STYLE){
-												show_alarm_style(&alarmclock);		// show alarm style
-											}
-			break;
-			case MODE_TIME_LUX:				// this mode will only be entered if #define DEV_MODE is uncommented in clock.c
-											switch(alarmclock.event){
-												case BUTTON_MODE:	increment_mode(&alarmclock);
-												break;
-												case BUTTON_PLUS:	;
-												break;
-												case BUTTON_MINUS:	;
-												break;
-												case BUTTON_SNOOZE:	;
-												break;
-												case SWITCH_ALARM:	;
-												break;
-											}
-											if(alarmclock.mode == MODE_TIME_LUX){
-												draw_lux(&alarmclock);
-											}
-			break;
+		power_idle(scheduler_run());
+	}
+}
+
+/**
+  * @brief  releases the input task, called from the interrupt which queued an event
+  * @note   None
+  * @retval None
+  */
+static void input_notify(void){
+	scheduler_start(&task_input, 0);
+	power_wakeup();
+}
+
+/**
+  * @brief  input task, dispatches the queued events to their subscribers
+  * @note   rendering is done by the render task
+  * @retval None
+  */
+static void input_task(void){
+	Event event;
+
+	/* check for new events */
+	while(unqueue_event(&event)){
+		latency_stamp_event(LATENCY_STAGE_UNQUEUED, event.type, event.source);
+		event_dispatch(&event);
+	}
+}
+
+/**
+  * @brief  finite state machine, handles an event in the recent mode
+  * @param  event from the event queue
+  * @note   subscriber of the button, switch and buzzer events, constant time lookup in the dispatch table
+  * 		of the recent mode
+  * @retval None
+  */
+static void handle_event(const Event *event){
+	Mode_Event index = mode_event_index(event);
+
+	alarmclock.event = *event;
+
+	if(index == MODE_EVENT_NONE || mode_states[alarmclock.mode].event[index] == 0){
+		return;
+	}
+	mode_states[alarmclock.mode].event[index](&alarmclock);
+}
+
+/**
+  * @brief  maps an event from the event queue to the index in the dispatch table
+  * @param  event from the event queue
+  * @note   press, long press and repeat of a button are the same mode event, the handlers repeat
+  * 		while the button is held
+  * @retval mode event or MODE_EVENT_NONE
+  */
+static Mode_Event mode_event_index(const Event *event){
+	switch(event->source){
+		case EVENT_SOURCE_MODE:			return MODE_EVENT_MODE;
+		case EVENT_SOURCE_PLUS:			return MODE_EVENT_PLUS;
+		case EVENT_SOURCE_MINUS:		return MODE_EVENT_MINUS;
+		case EVENT_SOURCE_SNOOZE:		return event->type == EVENT_TYPE_DOUBLE_CLICK ? MODE_EVENT_SNOOZE_DOUBLE : MODE_EVENT_SNOOZE;
+		case EVENT_SOURCE_SWITCH_ALARM:	return MODE_EVENT_SWITCH_ALARM;
+		case EVENT_SOURCE_BUZZER:		return MODE_EVENT_BUZZER;
+		default:						return MODE_EVENT_NONE;
+	}
+}
+
+/**
+  * @brief  leaves the recent mode and enters the new mode
+  * @param  mode to enter
+  * @retval None
+  */
+static void mode_transition(Wordclock_Mode mode){
+	if(mode_states[alarmclock.mode].exit != 0){
+		mode_states[alarmclock.mode].exit(&alarmclock);
+	}
+	alarmclock.mode = mode;
+	if(mode_states[alarmclock.mode].entry != 0){
+		mode_states[alarmclock.mode].entry(&alarmclock);
+	}
+}
+
+/**
+  * @brief  entry action of all modes, shows the mode change on the display
+  * @note   the message runs as notification, the setup blinking starts with a dark number
+  * @retval None
+  */
+static void mode_entry(Alarmclock *alarmclock_param){
+	restart_setup_blinking(0);
+	draw_mode(alarmclock_param);
+}
+
+/**
+  * @brief  steps to the next mode, action of the mode button
+  * @note   None
+  * @retval None
+  */
+static void mode_next(Alarmclock *alarmclock_param){
+	mode_transition(get_next_mode(alarmclock_param));
+}
+
+/**
+  * @brief  entry action of the clock mode, only in the clock mode the alarm shall work
+  * @note   None
+  * @retval None
+  */
+static void clock_entry(Alarmclock *alarmclock_param){
+	mode_entry(alarmclock_param);
+	clock_follow_alarm_switch(alarmclock_param);
+	clock_request_redraw();
+}
+
+/**
+  * @brief  exit action of the clock mode
+  * @note   None
+  * @retval None
+  */
+static void clock_exit(Alarmclock *alarmclock_param){
+	/* disable the alarm interrupt */
+	set_alarm_irq(DISABLE, alarmclock_param);
+}
+
+/**
+  * @brief  tick action of the clock mode
+  * @note   a running effect or notification has priority
+  * @retval None
+  */
+static void clock_render(Alarmclock *alarmclock_param){
+	if(effect_tick() || notification_tick()){
+		clock_request_redraw();					// the clock face is overdrawn, show it again afterwards
+	}else{
+		clock_tick(alarmclock_param);			// redraw the clock on a new second or a running transition
+	}
+}
+
+/**
+  * @brief  mode button in the clock mode
+  * @note   None
+  * @retval None
+  */
+static void clock_mode_button(Alarmclock *alarmclock_param){
+	if(alarmclock_param->buzzer_state == BUZZER_SET){	// only if snooze is activated it should be deactivated
+		buzzer_stop(alarmclock_param);
+		notification_cancel(NOTIFICATION_KEY_ALARM);
+		snooze_reset(alarmclock_param);
+		notification_post("snooze off", NOTIFICATION_PRIORITY_ALARM, NOTIFICATION_KEY_SNOOZE, NOTIFICATION_TIMEOUT_LONG);
+	}else if(alarmclock_param->snooze_state == SNOOZE_SET){
+		snooze_reset(alarmclock_param);
+		notification_post("snooze off", NOTIFICATION_PRIORITY_ALARM, NOTIFICATION_KEY_SNOOZE, NOTIFICATION_TIMEOUT_LONG);
+	}
+	mode_next(alarmclock_param);
+}
+
+/**
+  * @brief  plus button in the clock mode
+  * @note   None
+  * @retval None
+  */
+static void clock_color_plus(Alarmclock *alarmclock_param){
+	increment_clock_color(alarmclock_param);
+	request_preferences_flush();	// set preferences
+}
+
+/**
+  * @brief  minus button in the clock mode
+  * @note   None
+  * @retval None
+  */
+static void clock_color_minus(Alarmclock *alarmclock_param){
+	decrement_clock_color(alarmclock_param);
+	request_preferences_flush();	// set preferences
+}
+
+/**
+  * @brief  snooze button in the clock mode
+  * @note   None
+  * @retval None
+  */
+static void clock_snooze_button(Alarmclock *alarmclock_param){
+	if(alarmclock_param->buzzer_state == BUZZER_SET){	// only if buzzer is running, snooze should be enabled
+		buzzer_stop(alarmclock_param);
+		notification_cancel(NOTIFICATION_KEY_ALARM);
+		snooze(alarmclock_param);
+	}
+}
+
+/**
+  * @brief  double click on the snooze button in the clock mode
+  * @note   None
+  * @retval None
+  */
+static void clock_snooze_double(Alarmclock *alarmclock_param){
+	if(alarmclock_param->snooze_state == SNOOZE_SET){
+		snooze_reset(alarmclock_param);
+		notification_post("snooze off", NOTIFICATION_PRIORITY_ALARM, NOTIFICATION_KEY_SNOOZE, NOTIFICATION_TIMEOUT_LONG);
+	}
+}
+
+/**
+  * @brief  alarm switch in the clock mode
+  * @note   the alarm interrupt follows the switch, in the setup modes the switch is read when the clock mode
+  * 		is entered again
+  * @retval None
+  */
+static void clock_alarm_switch(Alarmclock *alarmclock_param){
+	clock_follow_alarm_switch(alarmclock_param);
+	if(alarmclock_param->event.payload){	// position of the switch when it changed
+		notification_post("alarm on", NOTIFICATION_PRIORITY_INFO, NOTIFICATION_KEY_ALARM_SWITCH, NOTIFICATION_TIMEOUT_SHORT);
+	}else{
+		notification_post("alarm off", NOTIFICATION_PRIORITY_INFO, NOTIFICATION_KEY_ALARM_SWITCH, NOTIFICATION_TIMEOUT_SHORT);
+	}
+}
+
+/**
+  * @brief  buzzer event in the clock mode, queued by the alarm
+  * @note   None
+  * @retval None
+  */
+static void clock_buzzer(Alarmclock *alarmclock_param){
+	show_alarm_style(alarmclock_param);
+	if(alarmclock_param->buzzer_state == BUZZER_SET){	// the alarm message pre-empts all other notifications
+		notification_post("wake up", NOTIFICATION_PRIORITY_ALARM, NOTIFICATION_KEY_ALARM, NOTIFICATION_NO_TIMEOUT);
+	}
+}
+
+/**
+  * @brief  exit action of the setup modes which change the preferences
+  * @note   repeated changes in the mode are written once
+  * @retval None
+  */
+static void setup_exit(Alarmclock *alarmclock_param){
+	request_preferences_flush();	// set preferences
+}
+
+/**
+  * @brief  tick action of the time and alarm setup modes, lets the hours or minutes blink
+  * @note   None
+  * @retval None
+  */
+static void setup_time_render(Alarmclock *alarmclock_param){
+	if(!notification_tick()){
+		setup_clock_blinking(alarmclock_param);
+	}
+}
+
+/**
+  * @brief  tick action of the alarm select setup mode
+  * @note   None
+  * @retval None
+  */
+static void setup_alarm_select_render(Alarmclock *alarmclock_param){
+	if(!notification_tick()){
+		draw_alarm_select(alarmclock_param);
+	}
+}
+
+/**
+  * @brief  tick action of the alarm rule setup mode
+  * @note   None
+  * @retval None
+  */
+static void setup_alarm_rule_render(Alarmclock *alarmclock_param){
+	if(!notification_tick()){
+		draw_alarm_rule(alarmclock_param);
+	}
+}
+
+/**
+  * @brief  tick action of the snooze setup mode
+  * @note   None
+  * @retval None
+  */
+static void setup_snooze_render(Alarmclock *alarmclock_param){
+	if(!notification_tick()){
+		draw_snooze(alarmclock_param);
+	}
+}
+
+/**
+  * @brief  exit action of the alarm style setup mode, the preview does not run into the next mode
+  * @note   None
+  * @retval None
+  */
+static void setup_alarm_style_exit(Alarmclock *alarmclock_param){
+	effect_stop();
+	setup_exit(alarmclock_param);
+}
+
+/**
+  * @brief  tick action of the alarm style setup mode
+  * @note   None
+  * @retval None
+  */
+static void setup_alarm_style_render(Alarmclock *alarmclock_param){
+	if(!notification_tick() && !effect_tick()){
+		show_alarm_style(alarmclock_param);		// restart the alarm style preview
+	}
+}
+
+/**
+  * @brief  tick action of the lux mode
+  * @note   None
+  * @retval None
+  */
+static void lux_render(Alarmclock *alarmclock_param){
+	if(!notification_tick()){
+		draw_lux(alarmclock_param);
+	}
+}
+
+/**
+  * @brief  render task, runs the tick action of the recent mode
+  * @note   a running effect sets the pace of the display
+  * @retval None
+  */
+static void render_task(void){
+	latency_stamp(LATENCY_STAGE_RENDER);
+	if(mode_states[alarmclock.mode].tick != 0){
+		mode_states[alarmclock.mode].tick(&alarmclock);
+	}
+	if(effect_running()){
+		scheduler_set_period(&task_render, effect_get_frame_period());
+	}else{
+		scheduler_set_period(&task_render, CLOCK_REFRESH_PERIOD);
+	}
+}
+
+/**
+  * @brief  enables or disables the alarm interrupt with the alarm switch, only in the clock mode the alarm shall work
+  * @note   the switch is read, the level has settled after the bouncing which queued the switch events
+  * @retval None
+  */
+static void clock_follow_alarm_switch(Alarmclock *alarmclock_param){
+	if(read_alarm_switch()){	// read if the switch for alarm is on or off
+		set_alarm_irq(ENABLE, alarmclock_param);
+	}else{
+		set_alarm_irq(DISABLE, alarmclock_param);
+		if(alarmclock_param->buzzer_state == BUZZER_SET){	// only if snooze is activated it should be deactivated
+			buzzer_stop(alarmclock_param);
+			notification_cancel(NOTIFICATION_KEY_ALARM);
+			snooze_reset(alarmclock_param);
+		}else if(alarmclock_param->snooze_state == SNOOZE_SET){
+			snooze_reset(alarmclock_param);
 		}
-		/* delay */
-		HAL_Delay(CLOCK_REFRESH_PERIOD);
-		/* measure ambient light to control led light strength */
-		start_lightsensor_adc_conversion();
 	}
 }
 
+/**
+  * @brief  sensor task, measures ambient light to control led light strength
+  * @note   the conversion completes in the adc interrupt
+  * @retval None
+  */
+static void sensor_task(void){
+	start_lightsensor_adc_conversion();
+}
+
+/**
+  * @brief  preferences task, writes the preferences into the backup registers
+  * @note   one shot, started by request_preferences_flush()
+  * @retval None
+  */
+static void preferences_task(void){
+	set_clock_preferences(&alarmclock);
+}
+
+#ifdef PROFILE
+/**
+  * @brief  profile task, sends the cycles of the profiled scopes to the itm
+  * @note   None
+  * @retval None
+  */
+static void profile_task(void){
+	profile_report();
+}
+#endif
+
+#ifdef RECORD
+/**
+  * @brief  record task, sends the recorded inputs and frames to the itm
+  * @note   None
+  * @retval None
+  */
+static void record_task(void){
+	record_flush();
+}
+#endif
+
+#ifdef RECORD_REPLAY
+/**
+  * @brief  replay task, replays the due records of the scenario
+  * @note   the task stops after the last record
+  * @retval None
+  */
+static void replay_task(void){
+	if(!record_replay_tick()){
+		scheduler_stop(&task_replay);
+	}
+}
+#endif
+
+/**
+  * @brief  writes the preferences after PREFERENCES_FLUSH_DELAY
+  * @note   repeated changes within the delay are written once
+  * @retval None
+  */
+static void request_preferences_flush(void){
+	scheduler_start(&task_preferences, PREFERENCES_FLUSH_DELAY);
+}
+
+/**
+  * @brief  called by the scheduler if a task overran its budget
+  * @note   the statistics of the task are in the task itself
+  * @retval None
+  */
+static void task_overrun(Task *task){
+	#ifdef REPORT_OVERRUN
+	notification_post(task->name, NOTIFICATION_PRIORITY_INFO, NOTIFICATION_KEY_MODE, NOTIFICATION_TIMEOUT_SHORT);
+	#endif
+}
+
+/**
+  * @brief  stores the cycles since the last boot stage into the boot profile
+  * @param  stage which is done
+  * @retval None
+  */
+static void boot_stage_done(Boot_Stage stage){
+	uint32_t now = get_cyclecount();
+	boot_profile[stage] = now - boot_stage_start;
+	boot_stage_start = now;
+}
+
 /**
   * @brief  System Clock Configuration
   *         The system Clock is configured as follow : 
@@ -0,0 +1,258 @@
+/*
+ * Autor: Nico Korn
+ * Date: 19.10.2026
+ * Firmware for a alarmlcock with custom made STM32F103 microcontroller board.
+ *  *
+ * Copyright (c) 2026 Nico Korn
+ *
+ * notification.c this module contents a prioritised queue for messages on the display.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+
+// ----------------------------------------------------------------------------
+
+#include <string.h>
+#include "notification.h"
+
+/* defines */
+#define NOTIFICATION_QUEUE_LENGTH	4 		// length of notification buffer
+
+/* private variables */
+static Notification			notification_queue[NOTIFICATION_QUEUE_LENGTH];
+static Notification			notification_current;		// notification which is running on the ticker
+static uint16_t				notification_order;
+static uint8_t				*notification_red, *notification_green, *notification_blue;
+static uint16_t				*notification_ambient_factor;
+
+/* private functions */
+static void notification_show(Notification *notification);
+static uint8_t notification_expired(Notification *notification, uint32_t tick);
+
+/**
+  * @brief  initialization of the notification queue
+  * @note   the colors are read on every frame, so color changes are shown immediately
+  * @retval None
+  */
+void init_notification(uint8_t *red, uint8_t *green, uint8_t *blue, uint16_t *ambient_factor){
+	notification_red = red;
+	notification_green = green;
+	notification_blue = blue;
+	notification_ambient_factor = ambient_factor;
+	notification_order = 0;
+	notification_clear();
+}
+
+/**
+  * @brief  posts a notification
+  * @note   a notification with the same key as a running or queued one replaces it. A notification with
+  * 		a higher priority than the running one pre-empts it. If the queue is full, the oldest notification
+  * 		with the lowest priority is dropped if its priority is lower, else the new one is dropped.
+  * 		The string is not copied and has to stay valid until the notification is done.
+  * @param  string, priority, key for coalescing, timeout in ms the notification may wait in the queue
+  * @retval None
+  */
+void notification_post(char *string, Notification_Priority priority, Notification_Key key, uint32_t timeout){
+	Notification *slot = NULL;
+	uint32_t tick = HAL_GetTick();
+
+	/* coalesce with the running notification, only restart it if the text has changed */
+	if(notification_current.used && key != NOTIFICATION_KEY_NONE && notification_current.key == key){
+		if(priority > notification_current.priority){
+			notification_current.priority = priority;
+		}
+		if(strcmp(notification_current.string, string) != 0){
+			notification_current.string = string;
+			notification_show(&notification_current);
+		}
+		return;
+	}
+
+	/* coalesce with a queued notification */
+	if(key != NOTIFICATION_KEY_NONE){
+		for(uint8_t i = 0; i < NOTIFICATION_QUEUE_LENGTH; i++){
+			if(notification_queue[i].used && notification_queue[i].key == key){
+				slot = &notification_queue[i];
+				break;
+			}
+		}
+	}
+
+	/* show the notification immediately if nothing is running or if it pre-empts the running one */
+	if(!notification_current.used || priority > notification_current.priority){
+		if(slot != NULL){
+			slot->used = 0;
+		}
+		notification_current.string = string;
+		notification_current.priority = priority;
+		notification_current.key = key;
+		notification_current.post_tick = tick;
+		notification_current.timeout = timeout;
+		notification_current.order = notification_order++;
+		notification_current.used = 1;
+		notification_show(&notification_current);
+		return;
+	}
+
+	/* get a free slot */
+	if(slot == NULL){
+		for(uint8_t i = 0; i < NOTIFICATION_QUEUE_LENGTH; i++){
+			if(!notification_queue[i].used){
+				slot = &notification_queue[i];
+				break;
+			}
+		}
+	}
+
+	/* queue is full, replace the oldest notification with the lowest priority if it is less important */
+	if(slot == NULL){
+		for(uint8_t i = 0; i < NOTIFICATION_QUEUE_LENGTH; i++){
+			if(notification_queue[i].priority < priority){
+				if(slot == NULL || notification_queue[i].priority < slot->priority || (notification_queue[i].priority == slot->priority && (int16_t)(notification_queue[i].order - slot->order) < 0)){
+					slot = &notification_queue[i];
+				}
+			}
+		}
+	}
+
+	/* queue is full with more important notifications, drop the new one */
+	if(slot == NULL){
+		return;
+	}
+
+	slot->string = string;
+	slot->priority = priority;
+	slot->key = key;
+	slot->post_tick = tick;
+	slot->timeout = timeout;
+	slot->order = notification_order++;
+	slot->used = 1;
+}
+
+/**
+  * @brief  removes all running and queued notifications with the given key
+  * @note   None
+  * @retval None
+  */
+void notification_cancel(Notification_Key key){
+	for(uint8_t i = 0; i < NOTIFICATION_QUEUE_LENGTH; i++){
+		if(notification_queue[i].key == key){
+			notification_queue[i].used = 0;
+		}
+	}
+	if(notification_current.used && notification_current.key == key){
+		notification_current.used = 0;
+		ticker_stop();
+	}
+}
+
+/**
+  * @brief  removes all running and queued notifications
+  * @note   None
+  * @retval None
+  */
+void notification_clear(void){
+	for(uint8_t i = 0; i < NOTIFICATION_QUEUE_LENGTH; i++){
+		notification_queue[i].used = 0;
+	}
+	notification_current.used = 0;
+	ticker_stop();
+}
+
+/**
+  * @brief  checks if a notification is running or waiting
+  * @note   None
+  * @retval 1 if a notification is running or waiting, else 0
+  */
+uint8_t notification_busy(void){
+	if(notification_current.used){
+		return 1;
+	}
+	for(uint8_t i = 0; i < NOTIFICATION_QUEUE_LENGTH; i++){
+		if(notification_queue[i].used){
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/**
+  * @brief  draws the running notification over the clock face and starts the next one if it is done,
+  * 		has to be called every display tick
+  * @note   None
+  * @retval 1 if a notification has drawn the display, else 0
+  */
+uint8_t notification_tick(void){
+	Notification *next = NULL;
+	uint32_t tick = HAL_GetTick();
+
+	/* advance the running notification */
+	if(notification_current.used){
+		if(ticker_tick()){
+			return 1;
+		}
+		notification_current.used = 0;
+	}
+
+	/* get the next notification: highest priority first, same priorities in the order they were posted */
+	for(uint8_t i = 0; i < NOTIFICATION_QUEUE_LENGTH; i++){
+		if(!notification_queue[i].used){
+			continue;
+		}
+		if(notification_expired(&notification_queue[i], tick)){
+			notification_queue[i].used = 0;
+			continue;
+		}
+		if(next == NULL || notification_queue[i].priority > next->priority || (notification_queue[i].priority == next->priority && (int16_t)(notification_queue[i].order - next->order) < 0)){
+			next = &notification_queue[i];
+		}
+	}
+	if(next == NULL){
+		return 0;
+	}
+
+	/* take the notification out of the queue and show it */
+	notification_current = *next;
+	next->used = 0;
+	notification_show(&notification_current);
+	return ticker_tick();
+}
+
+/**
+  * @brief  starts a notification on the ticker
+  * @note   None
+  * @retval None
+  */
+static void notification_show(Notification *notification){
+	ticker_start(notification->string, notification_red, notification_green, notification_blue, notification_ambient_factor);
+}
+
+/**
+  * @brief  checks if a queued notification has waited longer than its timeout
+  * @note   None
+  * @retval 1 if the notification is expired, else 0
+  */
+static uint8_t notification_expired(Notification *notification, uint32_t tick){
+	if(notification->timeout == NOTIFICATION_NO_TIMEOUT){
+		return 0;
+	}
+	return (tick - notification->post_tick) >= notification->timeout;
+}
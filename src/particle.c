@@ -0,0 +1,276 @@
+/*
+ * Autor: Nico Korn
+ * Date: 19.10.2026
+ * Firmware for a alarmlcock with custom made STM32F103 microcontroller board.
+ *  *
+ * Copyright (c) 2026 Nico Korn
+ *
+ * particle.c this module contents a particle engine with a fixed size particle pool for background effects.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+
+
+
+// ----------------------------------------------------------------------------
+
+#include "particle.h"
+
+/* defines */
+#define PARTICLE_NONE				0xFF 	// end of a particle list
+#define PARTICLE_EFFECT_FRAMES		100 	// amount of frames of a particle effect
+#define PARTICLE_EFFECT_PERIOD		20 		// in ms
+
+/* private variables */
+static Particle				particle_pool[PARTICLE_POOL_SIZE];
+static uint8_t				particle_live_head;		// first particle of the live list
+static uint8_t				particle_free_head;		// first particle of the free list
+static Particle_Style		particle_style;
+static uint32_t				particle_seed = 0x2545F491;
+static const Particle_Preset	particle_presets[] = {
+	/* origin, spawn chance, spawn count, vx min, vx range, vy min, vy range, gravity, life, fade, red, green, blue */
+	{PARTICLE_ORIGIN_TOP,		0,		0,	0,		0,	0,		0,	0,	0,		0,	0x00, 0x00, 0x00},	// none
+	{PARTICLE_ORIGIN_TOP,		160,	1,	0,		0,	8,		12,	0,	16,		1,	0x00, 0x33, 0x00},	// rain
+	{PARTICLE_ORIGIN_TOP,		96,		1,	-3,		7,	2,		3,	0,	80,		0,	0x10, 0x10, 0x10},	// snow
+	{PARTICLE_ORIGIN_ANYWHERE,	64,		4,	-12,	25,	-16,	17,	2,	10,		1,	0x40, 0x20, 0x00}	// sparks
+};
+
+/* private functions */
+static void particle_spawn(const Particle_Preset *preset);
+static int8_t particle_random_range(int8_t min, uint8_t range);
+static void particle_effect_init(Effect *effect);
+static void particle_effect_step(Effect *effect);
+static uint8_t particle_effect_done(Effect *effect);
+
+/* private effects */
+static Particle_Style		particle_rain = PARTICLE_STYLE_RAIN;
+static Particle_Style		particle_snow = PARTICLE_STYLE_SNOW;
+static Particle_Style		particle_sparks = PARTICLE_STYLE_SPARKS;
+static Effect				particle_effect_rain = 		{"rain",	EFFECT_CLASS_ALARM,	particle_effect_init,	particle_effect_step,	particle_effect_done,	PARTICLE_EFFECT_PERIOD,	0,	&particle_rain};
+static Effect				particle_effect_snow = 		{"snow",	EFFECT_CLASS_ALARM,	particle_effect_init,	particle_effect_step,	particle_effect_done,	PARTICLE_EFFECT_PERIOD,	0,	&particle_snow};
+static Effect				particle_effect_sparks = 	{"sparks",	EFFECT_CLASS_ALARM,	particle_effect_init,	particle_effect_step,	particle_effect_done,	PARTICLE_EFFECT_PERIOD,	0,	&particle_sparks};
+
+/**
+  * @brief  initialization of the particle engine
+  * @note   registers the particle effects, has to be called before the alarm style is loaded
+  * @retval None
+  */
+void init_particle(void){
+	particle_stop();
+	if(!effect_register(&particle_effect_rain) || !effect_register(&particle_effect_snow)
+			|| !effect_register(&particle_effect_sparks)){
+		/* the registry is full, increase EFFECT_REGISTRY_LENGTH */
+		while(1){
+			//error
+		}
+	}
+}
+
+/**
+  * @brief  starts the particle engine with a style, all live particles are removed
+  * @note   None
+  * @retval None
+  */
+void particle_start(Particle_Style style){
+	/* put all particles into the free list */
+	for(uint8_t i = 0; i < PARTICLE_POOL_SIZE-1; i++){
+		particle_pool[i].next = i+1;
+	}
+	particle_pool[PARTICLE_POOL_SIZE-1].next = PARTICLE_NONE;
+	particle_free_head = 0;
+	particle_live_head = PARTICLE_NONE;
+	particle_style = style;
+	/* new sequence on every start */
+	particle_seed ^= HAL_GetTick();
+	if(particle_seed == 0){
+		particle_seed = 0x2545F491;
+	}
+}
+
+/**
+  * @brief  stops the particle engine
+  * @note   None
+  * @retval None
+  */
+void particle_stop(void){
+	particle_start(PARTICLE_STYLE_NONE);
+}
+
+/**
+  * @brief  gets the running particle style
+  * @note   None
+  * @retval particle style, PARTICLE_STYLE_NONE if the engine is stopped
+  */
+Particle_Style particle_get_style(void){
+	return particle_style;
+}
+
+/**
+  * @brief  spawns new particles and moves the live particles by one frame
+  * @note   only live particles are processed, dead particles are put back into the free list
+  * @retval None
+  */
+void particle_tick(void){
+	const Particle_Preset *preset = &particle_presets[particle_style];
+	uint8_t index = particle_live_head;
+	uint8_t previous = PARTICLE_NONE;
+	uint8_t next;
+	Particle *particle;
+
+	if(particle_style == PARTICLE_STYLE_NONE){
+		return;
+	}
+
+	/* move live particles */
+	while(index != PARTICLE_NONE){
+		particle = &particle_pool[index];
+		next = particle->next;
+		particle->x += particle->vx;
+		particle->y += particle->vy;
+		particle->vy += preset->gravity;
+		particle->life--;
+		if(particle->life == 0 || particle->x < 0 || particle->y < 0 || (particle->x>>PARTICLE_SUBPIXEL_SHIFT) >= COL || (particle->y>>PARTICLE_SUBPIXEL_SHIFT) >= ROW){
+			/* unlink from the live list and put into the free list */
+			if(previous == PARTICLE_NONE){
+				particle_live_head = next;
+			}else{
+				particle_pool[previous].next = next;
+			}
+			particle->next = particle_free_head;
+			particle_free_head = index;
+		}else{
+			previous = index;
+		}
+		index = next;
+	}
+
+	/* spawn new particles */
+	if((particle_random() & 0xFF) < preset->spawn_chance){
+		for(uint8_t i = 0; i < preset->spawn_count; i++){
+			particle_spawn(preset);
+		}
+	}
+}
+
+/**
+  * @brief  draws the live particles into the frame buffer
+  * @note   the frame buffer is not cleared, the caller draws the foreground afterwards
+  * @retval None
+  */
+void particle_draw(void){
+	const Particle_Preset *preset = &particle_presets[particle_style];
+	uint8_t index = particle_live_head;
+	uint8_t red = preset->red;
+	uint8_t green = preset->green;
+	uint8_t blue = preset->blue;
+	Particle *particle;
+
+	while(index != PARTICLE_NONE){
+		particle = &particle_pool[index];
+		if(preset->fade){
+			/* scale the color with the remaining life */
+			red = (preset->red * particle->life) / preset->life;
+			green = (preset->green * particle->life) / preset->life;
+			blue = (preset->blue * particle->life) / preset->life;
+		}
+		WS2812_framedata_setPixel(particle->y>>PARTICLE_SUBPIXEL_SHIFT, particle->x>>PARTICLE_SUBPIXEL_SHIFT, red, green, blue);
+		index = particle->next;
+	}
+}
+
+/**
+  * @brief  xorshift32 pseudo random number generator
+  * @note   None
+  * @retval pseudo random number
+  */
+uint32_t particle_random(void){
+	particle_seed ^= particle_seed << 13;
+	particle_seed ^= particle_seed >> 17;
+	particle_seed ^= particle_seed << 5;
+	return particle_seed;
+}
+
+/**
+  * @brief  takes a particle from the free list and puts it into the live list
+  * @note   nothing is spawned if the pool is exhausted
+  * @retval None
+  */
+static void particle_spawn(const Particle_Preset *preset){
+	uint8_t index = particle_free_head;
+	Particle *particle;
+
+	if(index == PARTICLE_NONE){
+		return;
+	}
+	particle = &particle_pool[index];
+	particle_free_head = particle->next;
+	particle->next = particle_live_head;
+	particle_live_head = index;
+
+	/* place the particle in the middle of a pixel */
+	particle->x = (particle_random_range(0, COL)<<PARTICLE_SUBPIXEL_SHIFT) + (1<<(PARTICLE_SUBPIXEL_SHIFT-1));
+	if(preset->origin == PARTICLE_ORIGIN_TOP){
+		particle->y = 1<<(PARTICLE_SUBPIXEL_SHIFT-1);
+	}else{
+		particle->y = (particle_random_range(0, ROW)<<PARTICLE_SUBPIXEL_SHIFT) + (1<<(PARTICLE_SUBPIXEL_SHIFT-1));
+	}
+	particle->vx = particle_random_range(preset->vx_min, preset->vx_range);
+	particle->vy = particle_random_range(preset->vy_min, preset->vy_range);
+	particle->life = preset->life;
+}
+
+/**
+  * @brief  gets a pseudo random number in the range min..min+range-1
+  * @note   scaled with a multiplication instead of a division
+  * @retval pseudo random number
+  */
+static int8_t particle_random_range(int8_t min, uint8_t range){
+	return min + (int8_t)(((particle_random() & 0xFFFF) * range) >> 16);
+}
+
+/**
+  * @brief  starts the particle engine with the style of the effect
+  * @note   None
+  * @retval None
+  */
+static void particle_effect_init(Effect *effect){
+	particle_start(*(Particle_Style*)effect->data);
+}
+
+/**
+  * @brief  draws one frame of a particle effect on a dark display
+  * @note   None
+  * @retval None
+  */
+static void particle_effect_step(Effect *effect){
+	WS2812_clear_buffer();
+	particle_tick();
+	particle_draw();
+}
+
+/**
+  * @brief  checks if the particle effect has shown all its frames
+  * @note   None
+  * @retval 1 if the effect is finished, else 0
+  */
+static uint8_t particle_effect_done(Effect *effect){
+	return effect->frame >= PARTICLE_EFFECT_FRAMES;
+}
@@ -0,0 +1,173 @@
+/*
+ * Autor: Nico Korn
+ * Date: 19.10.2026
+ * Firmware for a alarmlcock with custom made STM32F103 microcontroller board.
+ *  *
+ * Copyright (c) 2026 Nico Korn
+ *
+ * power.c this module contents the tickless idle mode
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+
+
+
+// ----------------------------------------------------------------------------
+
+#include "power.h"
+
+/* defines */
+
+/* private variables */
+static Power_Stats			power_stats;				// read it with the debugger
+static volatile uint8_t		power_wakeup_pending;
+static uint32_t				power_cycles;				// systick cycles of the started ms, carried into the hal tick
+
+/* global variables */
+
+/* private functions */
+static void power_update_stats(uint32_t idle);
+
+
+
+/**
+  * @brief  initialization of the idle statistics
+  * @note   None
+  * @retval None
+  */
+void init_power(void){
+	power_stats.duty = 100;
+	power_stats.wakeups = 0;
+	power_stats.idle = 0;
+	power_stats.window_wakeups = 0;
+	power_stats.window_start = HAL_GetTick();
+}
+
+/**
+  * @brief  sleeps until an interrupt or for wait ms
+  * @note   tickless: the systick is reloaded to interrupt once after wait ms instead of every ms,
+  * 		the hal tick is corrected with the slept time after the wakeup. The cycles of a started ms
+  * 		are accumulated in power_cycles, the hal tick does not drift with early wakeups.
+  * @retval None
+  */
+void power_idle(uint32_t wait){
+	uint32_t ticks_per_ms = SystemCoreClock / 1000U;
+	uint32_t reload, elapsed;
+
+	if(wait == 0){
+		/* the core stays awake, the window of the statistics is closed anyway */
+		power_update_stats(0);
+		return;
+	}
+	if(wait > POWER_MAX_IDLE){
+		wait = POWER_MAX_IDLE;
+	}
+
+	__disable_irq();
+	/* an interrupt released work after the scheduler was asked for the idle time */
+	if(power_wakeup_pending){
+		power_wakeup_pending = 0;
+		__enable_irq();
+		power_update_stats(0);
+		return;
+	}
+	/* the cycles since the last 1 ms tick are lost with the reload */
+	power_cycles += ticks_per_ms - 1 - SysTick->VAL;
+	reload = wait * ticks_per_ms - 1;
+	SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+	SysTick->LOAD = reload;
+	SysTick->VAL = 0;
+	SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+
+	/* a pending interrupt wakes the core up although the interrupts are disabled */
+	__DSB();
+	__WFI();
+
+	/* an expired systick is counted by its pending interrupt, the counter has restarted at reload */
+	if(SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk){
+		elapsed = wait - 1;
+	}else{
+		elapsed = 0;
+	}
+	power_cycles += reload - SysTick->VAL;
+	elapsed += power_cycles / ticks_per_ms;
+	power_cycles %= ticks_per_ms;
+	SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+	SysTick->LOAD = ticks_per_ms - 1;
+	SysTick->VAL = 0;
+	SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+	uwTick += elapsed;
+	__enable_irq();
+
+	power_stats.window_wakeups++;
+	power_update_stats(elapsed);
+}
+
+/**
+  * @brief  skips the next idle, called from interrupts which release work
+  * @note   None
+  * @retval None
+  */
+void power_wakeup(void){
+	power_wakeup_pending = 1;
+}
+
+/**
+  * @brief  returns the idle statistics
+  * @note   None
+  * @retval pointer to the statistics
+  */
+Power_Stats* power_get_stats(void){
+	return &power_stats;
+}
+
+/**
+  * @brief  delay in ms, overrides the weak busy waiting delay of the hal
+  * @note   the core sleeps between the systick interrupts
+  * @retval None
+  */
+void HAL_Delay(uint32_t Delay){
+	uint32_t start = HAL_GetTick();
+
+	while((HAL_GetTick() - start) < Delay){
+		__WFI();
+	}
+}
+
+/**
+  * @brief  adds an idle period to the statistics, the duty cycle is calculated every window
+  * @note   called on every pass of the main loop, also if the core did not sleep, so the window of a busy
+  * 		core is closed too. The wakeups are counted by power_idle() after the wfi.
+  * @retval None
+  */
+static void power_update_stats(uint32_t idle){
+	uint32_t now = HAL_GetTick();
+	uint32_t window = now - power_stats.window_start;
+
+	power_stats.idle += idle;
+	if(window >= POWER_STATS_WINDOW){
+		power_stats.duty = 100 - (power_stats.idle * 100) / window;
+		power_stats.wakeups = power_stats.window_wakeups;
+		power_stats.idle = 0;
+		power_stats.window_wakeups = 0;
+		power_stats.window_start = now;
+	}
+}
@@ -0,0 +1,217 @@
+/*
+ * Autor: Nico Korn
+ * Date: 19.10.2026
+ * Firmware for a alarmlcock with custom made STM32F103 microcontroller board.
+ *  *
+ * Copyright (c) 2026 Nico Korn
+ *
+ * profile.c this module contents the cycle profiler of named scopes
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+
+
+
+// ----------------------------------------------------------------------------
+
+#include "profile.h"
+#include "cyclecounter.h"
+#include <string.h>
+
+/* defines */
+
+/* private variables */
+static Profile_Stats		profile_stats[PROFILE_SCOPE_COUNT];		// statistics of the recent window, read it with the debugger
+static uint32_t				profile_window_start;
+static uint8_t				profile_reports;
+static const char			*profile_names[PROFILE_SCOPE_COUNT] = {
+									"setPixel",
+									"clear_buffer",
+									"draw_time",
+									"draw_string_frame",
+									"sendbuf",
+									"adc_conv_cplt",
+									"systick_irq",
+									"exti0_irq",
+									"exti1_irq",
+									"exti2_irq",
+									"exti15_10_irq",
+									"tim1_irq",
+									"tim2_irq",
+									"tim3_irq",
+									"tim4_irq",
+									"rtc_alarm_irq",
+									"rtc_irq",
+									"adc_irq",
+									"dma1_ch1_irq",
+									"dma1_ch7_irq"
+									};
+
+/* global variables */
+
+/* private functions */
+static void profile_clear(Profile_Stats *stats);
+static uint8_t profile_itm_enabled(void);
+static void profile_send(uint8_t byte);
+static void profile_send_u32(uint32_t value);
+
+
+
+/**
+  * @brief  initialization of the profiler
+  * @note   the cycle counter has to be initialized
+  * @retval None
+  */
+void init_profile(void){
+	for(uint8_t scope = 0; scope < PROFILE_SCOPE_COUNT; scope++){
+		profile_clear(&profile_stats[scope]);
+	}
+	profile_reports = 0;
+	profile_window_start = get_cyclecount();
+}
+
+/**
+  * @brief  begin of a call of a scope
+  * @note   a scope must not be called recursively
+  * @retval None
+  */
+void profile_begin(Profile_Scope scope){
+	profile_stats[scope].start = get_cyclecount();
+}
+
+/**
+  * @brief  end of a call of a scope
+  * @note   None
+  * @retval None
+  */
+void profile_end(Profile_Scope scope){
+	Profile_Stats *stats = &profile_stats[scope];
+	uint32_t cycles = get_cyclecount() - stats->start;
+
+	stats->calls++;
+	stats->total += cycles;
+	if(cycles < stats->min){
+		stats->min = cycles;
+	}
+	if(cycles > stats->max){
+		stats->max = cycles;
+	}
+}
+
+/**
+  * @brief  sends the statistics of the recent window to the itm and starts a new window
+  * @note   nothing is sent if no debugger has enabled the itm stimulus port
+  * @retval None
+  */
+void profile_report(void){
+	Profile_Stats stats;
+	uint32_t primask, now;
+	uint8_t send = profile_itm_enabled();
+	uint8_t names = (profile_reports % PROFILE_NAME_PERIOD) == 0;
+
+	now = get_cyclecount();
+	if(send){
+		profile_send(PROFILE_RECORD_SYNC);
+		profile_send(PROFILE_RECORD_REPORT);
+		profile_send(PROFILE_SCOPE_COUNT);
+		profile_send(SystemCoreClock / 1000000U);
+		profile_send_u32(now - profile_window_start);
+	}
+	profile_window_start = now;
+	profile_reports++;
+
+	for(uint8_t scope = 0; scope < PROFILE_SCOPE_COUNT; scope++){
+		/* take the statistics out of the window, the interrupt scopes keep running */
+		primask = __get_PRIMASK();
+		__disable_irq();
+		stats = profile_stats[scope];
+		profile_clear(&profile_stats[scope]);
+		profile_stats[scope].start = stats.start;
+		__set_PRIMASK(primask);
+
+		if(!send){
+			continue;
+		}
+		if(names){
+			profile_send(PROFILE_RECORD_SYNC);
+			profile_send(PROFILE_RECORD_NAME);
+			profile_send(scope);
+			profile_send(strlen(profile_names[scope]));
+			for(const char *c = profile_names[scope]; *c != '\0'; c++){
+				profile_send(*c);
+			}
+		}
+		if(stats.calls != 0){
+			profile_send(PROFILE_RECORD_SYNC);
+			profile_send(PROFILE_RECORD_SCOPE);
+			profile_send(scope);
+			profile_send_u32(stats.calls);
+			profile_send_u32(stats.min);
+			profile_send_u32(stats.max);
+			profile_send_u32(stats.total);
+		}
+	}
+}
+
+/**
+  * @brief  clears the statistics of a scope
+  * @note   None
+  * @retval None
+  */
+static void profile_clear(Profile_Stats *stats){
+	stats->calls = 0;
+	stats->min = 0xFFFFFFFF;
+	stats->max = 0;
+	stats->total = 0;
+}
+
+/**
+  * @brief  checks if the itm and the stimulus port of the records are enabled
+  * @note   None
+  * @retval 1 if enabled, else 0
+  */
+static uint8_t profile_itm_enabled(void){
+	return (ITM->TCR & ITM_TCR_ITMENA_Msk) && (ITM->TER & (1UL << PROFILE_ITM_PORT));
+}
+
+/**
+  * @brief  sends a byte to the itm stimulus port
+  * @note   waits until the fifo of the port is ready
+  * @retval None
+  */
+static void profile_send(uint8_t byte){
+	while(ITM->PORT[PROFILE_ITM_PORT].u32 == 0){
+		__NOP();
+	}
+	ITM->PORT[PROFILE_ITM_PORT].u8 = byte;
+}
+
+/**
+  * @brief  sends a word to the itm stimulus port, little endian
+  * @note   None
+  * @retval None
+  */
+static void profile_send_u32(uint32_t value){
+	for(uint8_t i = 0; i < 4; i++){
+		profile_send(value & 0xFF);
+		value >>= 8;
+	}
+}
@@ -0,0 +1,237 @@
+/*
+ * Autor: Nico Korn
+ * Date: 19.10.2026
+ * Firmware for a alarmlcock with custom made STM32F103 microcontroller board.
+ *  *
+ * Copyright (c) 2026 Nico Korn
+ *
+ * record.c this module contents the recording and the replay of the inputs
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+
+
+
+// ----------------------------------------------------------------------------
+
+#include "record.h"
+#include "event.h"
+#include "latency.h"
+#include "timebase.h"
+#include "buzzer.h"
+
+/* private variables */
+static Record_Entry			record_buffer[RECORD_BUFFER_LENGTH];
+static uint8_t				record_head;				// next record to write
+static uint8_t				record_tail;				// next record to send
+static uint32_t				record_dropped;				// records lost on a full buffer, read it with the debugger
+static uint32_t				record_last_adc = UINT32_MAX;
+static const Record_Entry	*replay_entries;
+static uint16_t				replay_count;
+static uint16_t				replay_index;
+static uint32_t				replay_start;				// HAL tick of the first entry
+static uint8_t				replay_adc_valid;
+static uint16_t				replay_adc;
+static Alarmclock			*replay_alarmclock;
+
+/* private functions */
+static uint8_t record_itm_enabled(void);
+static void record_send(uint8_t byte);
+static void record_send_u32(uint32_t value);
+
+
+
+/**
+  * @brief  initialization of the recording
+  * @note   None
+  * @retval None
+  */
+void init_record(void){
+	record_head = 0;
+	record_tail = 0;
+	record_dropped = 0;
+	record_last_adc = UINT32_MAX;
+}
+
+/**
+  * @brief  stores a record with the recent HAL tick, called from the interrupts and the tasks
+  * @note   use the macro RECORD_INPUT, it is empty without RECORD
+  * @retval None
+  */
+void record_input(Record_Type type, uint32_t value){
+	uint32_t primask = __get_PRIMASK();
+	uint8_t next;
+
+	__disable_irq();
+	/* the light sensor is sampled every 50 ms, only changes are recorded */
+	if(type == RECORD_TYPE_ADC){
+		if(value == record_last_adc){
+			__set_PRIMASK(primask);
+			return;
+		}
+		record_last_adc = value;
+	}
+	next = (record_head + 1) % RECORD_BUFFER_LENGTH;
+	if(next == record_tail){
+		record_dropped++;
+	}else{
+		record_buffer[record_head].ms = HAL_GetTick();
+		record_buffer[record_head].type = type;
+		record_buffer[record_head].value = value;
+		record_head = next;
+	}
+	__set_PRIMASK(primask);
+}
+
+/**
+  * @brief  sends the stored records to the itm
+  * @note   called by the record task, the records are dropped if the port is not enabled
+  * @retval None
+  */
+void record_flush(void){
+	Record_Entry entry;
+	uint8_t enabled = record_itm_enabled();
+
+	while(record_tail != record_head){
+		entry = record_buffer[record_tail];
+		record_tail = (record_tail + 1) % RECORD_BUFFER_LENGTH;
+		if(enabled){
+			record_send(RECORD_SYNC);
+			record_send(entry.type);
+			record_send_u32(entry.ms);
+			record_send_u32(entry.value);
+		}
+	}
+}
+
+/**
+  * @brief  get the amount of records lost on a full buffer
+  * @note   None
+  * @retval records
+  */
+uint32_t record_get_dropped(void){
+	return record_dropped;
+}
+
+/**
+  * @brief  starts the replay of the records, the first record is replayed at once
+  * @note   the records have to be in the order of their time
+  * @retval None
+  */
+void record_replay_start(const Record_Entry *entries, uint16_t count, Alarmclock *alarmclock_param){
+	replay_entries = entries;
+	replay_count = count;
+	replay_index = 0;
+	replay_alarmclock = alarmclock_param;
+	replay_adc_valid = 0;
+	if(count > 0){
+		replay_start = HAL_GetTick() - entries[0].ms;
+	}
+}
+
+/**
+  * @brief  replays the due records
+  * @note   called every RECORD_REPLAY_PERIOD by the replay task
+  * @retval 1 while records are left, else 0
+  */
+uint8_t record_replay_tick(void){
+	uint32_t now = HAL_GetTick() - replay_start;
+
+	while(replay_index < replay_count && replay_entries[replay_index].ms <= now){
+		record_replay_entry(&replay_entries[replay_index]);
+		replay_index++;
+	}
+	return replay_index < replay_count;
+}
+
+/**
+  * @brief  replays one record through the event engine, the rtc and the light sensor
+  * @note   the pin records need the pin levels, they are replayed by the host simulation only.
+  * 		A replayed event starts its latency measurement like a button.
+  * @retval None
+  */
+void record_replay_entry(const Record_Entry *entry){
+	switch(entry->type){
+		case RECORD_TYPE_EVENT:
+			latency_stamp_event(LATENCY_STAGE_EXTI, EVENT_RECORD_TYPE(entry->value), EVENT_RECORD_SOURCE(entry->value));
+			queue_event(EVENT_RECORD_TYPE(entry->value), EVENT_RECORD_SOURCE(entry->value), EVENT_RECORD_PAYLOAD(entry->value));
+		break;
+		case RECORD_TYPE_RTC:
+			/* keeps the time of the replay on the time of the recording */
+			if(timebase_read() != entry->value){
+				timebase_write(entry->value);
+			}
+		break;
+		case RECORD_TYPE_ALARM:
+			if(replay_alarmclock != NULL){
+				buzzer_start(replay_alarmclock);
+			}
+		break;
+		case RECORD_TYPE_ADC:
+			replay_adc = entry->value;
+			replay_adc_valid = 1;
+		break;
+		default:
+		break;
+	}
+}
+
+/**
+  * @brief  replaces a light sensor sample with the replayed sample
+  * @note   None
+  * @retval sample
+  */
+uint16_t record_replay_adc(uint16_t sample){
+	return replay_adc_valid ? replay_adc : sample;
+}
+
+/**
+  * @brief  checks if the itm and the stimulus port of the records are enabled
+  * @note   None
+  * @retval 1 if enabled, else 0
+  */
+static uint8_t record_itm_enabled(void){
+	return (ITM->TCR & ITM_TCR_ITMENA_Msk) && (ITM->TER & (1UL << RECORD_ITM_PORT));
+}
+
+/**
+  * @brief  sends a byte to the itm stimulus port
+  * @note   waits until the fifo of the port is ready
+  * @retval None
+  */
+static void record_send(uint8_t byte){
+	while(ITM->PORT[RECORD_ITM_PORT].u32 == 0){
+		__NOP();
+	}
+	ITM->PORT[RECORD_ITM_PORT].u8 = byte;
+}
+
+/**
+  * @brief  sends a word to the itm stimulus port, little endian
+  * @note   None
+  * @retval None
+  */
+static void record_send_u32(uint32_t value){
+	for(uint8_t i = 0; i < 4; i++){
+		record_send(value & 0xFF);
+		value >>= 8;
+	}
+}
@@ -0,0 +1,59 @@
+/*
+ * Autor: Nico Korn
+ * Date: 19.10.2026
+ * Firmware for a alarmlcock with custom made STM32F103 microcontroller board.
+ *  *
+ * Copyright (c) 2026 Nico Korn
+ *
+ * record_scenario.c this module contents the scenario of the replay on the target
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+
+
+
+// ----------------------------------------------------------------------------
+
+#include "record.h"
+#include "event.h"
+
+/* the scenario is replaced with the output of tools/record_decode.py --c of a recording.
+ * example: the alarm rings at 07:00, a double click on snooze during the alarm, then the setup modes
+ * are stepped through and back to the clock. */
+const Record_Entry			record_scenario[] = {
+									{0,		RECORD_TYPE_RTC,	25199},
+									{200,	RECORD_TYPE_ADC,	120},
+									{1000,	RECORD_TYPE_RTC,	25200},
+									{1000,	RECORD_TYPE_ALARM,	25200},
+									{3000,	RECORD_TYPE_EVENT,	EVENT_RECORD(EVENT_TYPE_DOUBLE_CLICK,	EVENT_SOURCE_SNOOZE,	0)},
+									{5000,	RECORD_TYPE_ADC,	40},
+									{6000,	RECORD_TYPE_EVENT,	EVENT_RECORD(EVENT_TYPE_PRESS,	EVENT_SOURCE_MODE,	0)},
+									{7000,	RECORD_TYPE_EVENT,	EVENT_RECORD(EVENT_TYPE_PRESS,	EVENT_SOURCE_PLUS,	0)},
+									{8000,	RECORD_TYPE_EVENT,	EVENT_RECORD(EVENT_TYPE_PRESS,	EVENT_SOURCE_MODE,	0)},
+									{9000,	RECORD_TYPE_EVENT,	EVENT_RECORD(EVENT_TYPE_PRESS,	EVENT_SOURCE_MODE,	0)},
+									{10000,	RECORD_TYPE_EVENT,	EVENT_RECORD(EVENT_TYPE_PRESS,	EVENT_SOURCE_MODE,	0)},
+									{11000,	RECORD_TYPE_EVENT,	EVENT_RECORD(EVENT_TYPE_PRESS,	EVENT_SOURCE_MODE,	0)},
+									{12000,	RECORD_TYPE_EVENT,	EVENT_RECORD(EVENT_TYPE_PRESS,	EVENT_SOURCE_MODE,	0)},
+									{13000,	RECORD_TYPE_EVENT,	EVENT_RECORD(EVENT_TYPE_PRESS,	EVENT_SOURCE_MODE,	0)},
+									{14000,	RECORD_TYPE_EVENT,	EVENT_RECORD(EVENT_TYPE_PRESS,	EVENT_SOURCE_MODE,	0)},
+									{15000,	RECORD_TYPE_EVENT,	EVENT_RECORD(EVENT_TYPE_PRESS,	EVENT_SOURCE_MODE,	0)}
+									};
+const uint16_t				record_scenario_length = sizeof(record_scenario)/sizeof(Record_Entry);
@@ -0,0 +1,187 @@
+/*
+ * Autor: Nico Korn
+ * Date: 19.10.2026
+ * Firmware for a alarmlcock with custom made STM32F103 microcontroller board.
+ *  *
+ * Copyright (c) 2026 Nico Korn
+ *
+ * scheduler.c this module contents the cooperative task scheduler
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+
+
+
+// ----------------------------------------------------------------------------
+
+#include "scheduler.h"
+
+/* defines */
+
+/* private variables */
+static Task					*scheduler_tasks[SCHEDULER_TASKS];	// the registration order is the priority
+static uint8_t				scheduler_task_count;
+static void					(*scheduler_overrun_callback)(Task *task);
+
+/* global variables */
+
+/* private functions */
+static void scheduler_execute(Task *task, uint32_t now);
+
+
+
+/**
+  * @brief  initialization of the scheduler
+  * @note   the overrun callback reports tasks which overrun their budget, it can be NULL
+  * @retval None
+  */
+void init_scheduler(void (*overrun_callback)(Task *task)){
+	scheduler_task_count = 0;
+	scheduler_overrun_callback = overrun_callback;
+}
+
+/**
+  * @brief  registers a task, a periodic task is released immediately, a one shot task waits for scheduler_start()
+  * @note   the tasks which are registered first run first
+  * @retval 1 if the task has been registered, 0 if the task list is full
+  */
+uint8_t scheduler_add(Task *task){
+	if(scheduler_task_count >= SCHEDULER_TASKS){
+		return 0;
+	}
+	task->runs = 0;
+	task->overruns = 0;
+	task->deadline_misses = 0;
+	task->max_latency = 0;
+	task->max_cycles = 0;
+	task->last_cycles = 0;
+	task->release = HAL_GetTick();
+	task->active = task->period != 0;
+	scheduler_tasks[scheduler_task_count++] = task;
+	return 1;
+}
+
+/**
+  * @brief  releases a task after delay ms
+  * @note   a pending one shot task is delayed again, can be called from an interrupt. The release is written
+  * 		before the task is activated, so the main loop never sees an active task with an old release.
+  * @retval None
+  */
+void scheduler_start(Task *task, uint32_t delay){
+	task->release = HAL_GetTick() + delay;
+	task->active = 1;
+}
+
+/**
+  * @brief  stops a task until it is started again
+  * @note   None
+  * @retval None
+  */
+void scheduler_stop(Task *task){
+	task->active = 0;
+}
+
+/**
+  * @brief  changes the period of a task
+  * @note   a task can change its own period, it applies to its next release
+  * @retval None
+  */
+void scheduler_set_period(Task *task, uint16_t period){
+	task->period = period;
+}
+
+/**
+  * @brief  runs every released task once, called from the main loop
+  * @note   None
+  * @retval ms until the next release or SCHEDULER_IDLE
+  */
+uint32_t scheduler_run(void){
+	uint32_t now = HAL_GetTick();
+	uint32_t wait = SCHEDULER_IDLE;
+	uint32_t release;
+	Task *task;
+
+	for(uint8_t i = 0; i < scheduler_task_count; i++){
+		task = scheduler_tasks[i];
+		if(task->active && (int32_t)(now - task->release) >= 0){
+			scheduler_execute(task, now);
+			now = HAL_GetTick();
+		}
+	}
+	/* time until the next release */
+	for(uint8_t i = 0; i < scheduler_task_count; i++){
+		task = scheduler_tasks[i];
+		if(task->active){
+			release = task->release;
+			if((int32_t)(release - now) <= 0){
+				return 0;
+			}
+			if(release - now < wait){
+				wait = release - now;
+			}
+		}
+	}
+	return wait;
+}
+
+/**
+  * @brief  runs a task and updates its statistics and release
+  * @note   None
+  * @retval None
+  */
+static void scheduler_execute(Task *task, uint32_t now){
+	uint32_t start, cycles;
+	uint32_t latency = now - task->release;
+
+	if(latency > task->max_latency){
+		task->max_latency = latency;
+	}
+	/* a one shot task can be started again while it runs */
+	if(task->period == 0){
+		task->active = 0;
+	}
+
+	start = get_cyclecount();
+	task->run();
+	cycles = get_cyclecount() - start;
+
+	task->runs++;
+	task->last_cycles = cycles;
+	if(cycles > task->max_cycles){
+		task->max_cycles = cycles;
+	}
+	if(cycles_to_us(cycles) > task->budget){
+		task->overruns++;
+		if(scheduler_overrun_callback != NULL){
+			scheduler_overrun_callback(task);
+		}
+	}
+
+	/* the next release, a periodic task which missed releases continues one period from now */
+	if(task->period != 0 && task->active){
+		if(latency >= task->period){
+			task->deadline_misses++;
+			task->release = now + task->period;
+		}else{
+			task->release += task->period;
+		}
+	}
+}
@@ -164,7 +164,9 @@ void PendSV_Handler(void)
   */
 void SysTick_Handler(void)
 {
+  PROFILE_BEGIN(PROFILE_SCOPE_SYSTICK_IRQ);
   HAL_IncTick();
+  PROFILE_END(PROFILE_SCOPE_SYSTICK_IRQ);
 }
 
 /******************************************************************************/
@@ -180,6 +182,7 @@ void SysTick_Handler(void)
   * @retval None
   */
 void EXTI0_IRQHandler(void){
+	PROFILE_BEGIN(PROFILE_SCOPE_EXTI0_IRQ);
 	/* EXTI line interrupt detected */
 	if(__HAL_GPIO_EXTI_GET_IT(BUTTON_MODE) != RESET){
 		/* clear interrupt pending bits */
@@ -187,6 +190,7 @@ void EXTI0_IRQHandler(void){
 		/* call callback */
 		HAL_GPIO_EXTI_Callback(BUTTON_MODE);
 	}
+	PROFILE_END(PROFILE_SCOPE_EXTI0_IRQ);
 }
 
 /**
@@ -195,6 +199,7 @@ void EXTI0_IRQHandler(void){
   * @retval None
   */
 void EXTI1_IRQHandler(void){
+	PROFILE_BEGIN(PROFILE_SCOPE_EXTI1_IRQ);
 	/* EXTI line interrupt detected */
 	if(__HAL_GPIO_EXTI_GET_IT(BUTTON_PLUS) != RESET){
 		/* clear interrupt pending bits */
@@ -202,6 +207,7 @@ void EXTI1_IRQHandler(void){
 		/* call callback */
 		HAL_GPIO_EXTI_Callback(BUTTON_PLUS);
 	}
+	PROFILE_END(PROFILE_SCOPE_EXTI1_IRQ);
 }
 
 /**
@@ -210,6 +216,7 @@ void EXTI1_IRQHandler(void){
   * @retval None
   */
 void EXTI2_IRQHandler(void){
+	PROFILE_BEGIN(PROFILE_SCOPE_EXTI2_IRQ);
 	/* EXTI line interrupt detected */
 	if(__HAL_GPIO_EXTI_GET_IT(BUTTON_MINUS) != RESET){
 		/* clear interrupt pending bits */
@@ -217,6 +224,7 @@ void EXTI2_IRQHandler(void){
 		/* call callback */
 		HAL_GPIO_EXTI_Callback(BUTTON_MINUS);
 	}
+	PROFILE_END(PROFILE_SCOPE_EXTI2_IRQ);
 }
 
 /**
@@ -225,6 +233,7 @@ void EXTI2_IRQHandler(void){
   * @retval None
   */
 void EXTI15_10_IRQHandler(void){
+	PROFILE_BEGIN(PROFILE_SCOPE_EXTI15_10_IRQ);
 	/* EXTI line interrupt detected */
 	if(__HAL_GPIO_EXTI_GET_IT(BUTTON_SNOOZE) != RESET){
 		/* clear interrupt pending bits */
@@ -239,6 +248,7 @@ void EXTI15_10_IRQHandler(void){
 		/* call callback */
 		HAL_GPIO_EXTI_Callback(SWITCH_ALARM);
 	}
+	PROFILE_END(PROFILE_SCOPE_EXTI15_10_IRQ);
 }
 
 /**
@@ -247,6 +257,7 @@ void EXTI15_10_IRQHandler(void){
   * @retval None
   */
 void TIM1_UP_IRQHandler(void){
+	PROFILE_BEGIN(PROFILE_SCOPE_TIM1_IRQ);
 	/* TIM1 Update event */
 	if(__HAL_TIM_GET_FLAG(&TIM1_Handle, TIM_FLAG_UPDATE) != RESET){
 		if(__HAL_TIM_GET_IT_SOURCE(&TIM1_Handle, TIM_IT_UPDATE) !=RESET){
@@ -256,6 +267,7 @@ void TIM1_UP_IRQHandler(void){
 			BUTTON_TIM1_Callback();
 		}
 	}
+	PROFILE_END(PROFILE_SCOPE_TIM1_IRQ);
 }
 
 /**
@@ -264,7 +276,9 @@ void TIM1_UP_IRQHandler(void){
   * @retval None
   */
 void TIM2_IRQHandler(void){
+	PROFILE_BEGIN(PROFILE_SCOPE_TIM2_IRQ);
 	WS2812_TIM2_callback();
+	PROFILE_END(PROFILE_SCOPE_TIM2_IRQ);
 }
 
 /**
@@ -273,6 +287,7 @@ void TIM2_IRQHandler(void){
   * @retval None
   */
 void TIM3_IRQHandler(void){
+	PROFILE_BEGIN(PROFILE_SCOPE_TIM3_IRQ);
 	/* TIM3 Update event */
 	if(__HAL_TIM_GET_FLAG(&TIM3_Handle, TIM_FLAG_UPDATE) != RESET){
 		if(__HAL_TIM_GET_IT_SOURCE(&TIM3_Handle, TIM_IT_UPDATE) !=RESET){
@@ -282,6 +297,7 @@ void TIM3_IRQHandler(void){
 			SNOOZE_TIM3_callback(&alarmclock);
 		}
 	}
+	PROFILE_END(PROFILE_SCOPE_TIM3_IRQ);
 }
 
 /**
@@ -290,6 +306,7 @@ void TIM3_IRQHandler(void){
   * @retval None
   */
 void TIM4_IRQHandler(void){
+	PROFILE_BEGIN(PROFILE_SCOPE_TIM4_IRQ);
 	/* TIM4 Update event */
 	if(__HAL_TIM_GET_FLAG(&TIM4_Handle, TIM_FLAG_UPDATE) != RESET){
 		if(__HAL_TIM_GET_IT_SOURCE(&TIM4_Handle, TIM_IT_UPDATE) !=RESET){
@@ -299,6 +316,7 @@ void TIM4_IRQHandler(void){
 			BUZZER_TIM4_callback(&alarmclock);
 		}
 	}
+	PROFILE_END(PROFILE_SCOPE_TIM4_IRQ);
 }
 
 /**
@@ -307,6 +325,7 @@ void TIM4_IRQHandler(void){
   * @retval None
   */
 void RTC_Alarm_IRQHandler(void){
+	PROFILE_BEGIN(PROFILE_SCOPE_RTC_ALARM_IRQ);
 	  if(__HAL_RTC_ALARM_GET_IT_SOURCE(&RTC_Handle, RTC_IT_ALRA))
 	  {
 	    /* Get the status of the Interrupt */
@@ -325,6 +344,29 @@ void RTC_Alarm_IRQHandler(void){
 
 	  /* Change RTC state */
 	  RTC_Handle.State = HAL_RTC_STATE_READY;
+	PROFILE_END(PROFILE_SCOPE_RTC_ALARM_IRQ);
+}
+
+/**
+  * @brief  This function handles RTC global interrupt request (second interrupt).
+  * @param  None
+  * @retval None
+  */
+void RTC_IRQHandler(void){
+	PROFILE_BEGIN(PROFILE_SCOPE_RTC_IRQ);
+	  if(__HAL_RTC_SECOND_GET_IT_SOURCE(&RTC_Handle, RTC_IT_SEC))
+	  {
+	    /* Get the status of the Interrupt */
+	    if(__HAL_RTC_SECOND_GET_FLAG(&RTC_Handle, RTC_FLAG_SEC) != (uint32_t)RESET)
+	    {
+	      /* Second callback */
+	      RTC_SecondEventCallback();
+
+	      /* Clear the Second interrupt pending bit */
+	      __HAL_RTC_SECOND_CLEAR_FLAG(&RTC_Handle, RTC_FLAG_SEC);
+	    }
+	  }
+	PROFILE_END(PROFILE_SCOPE_RTC_IRQ);
 }
 
 /**
@@ -333,7 +375,9 @@ void RTC_Alarm_IRQHandler(void){
   * @retval None
   */
 void ADC1_2_IRQHandler(void){
+	PROFILE_BEGIN(PROFILE_SCOPE_ADC_IRQ);
 	HAL_ADC_IRQHandler(&ADC_Handle);
+	PROFILE_END(PROFILE_SCOPE_ADC_IRQ);
 }
 
 /**
@@ -342,7 +386,9 @@ void ADC1_2_IRQHandler(void){
 * @retval None
 */
 void DMA1_Channel1_IRQHandler(void){
+	PROFILE_BEGIN(PROFILE_SCOPE_DMA1_CH1_IRQ);
 	HAL_DMA_IRQHandler(ADC_Handle.DMA_Handle);
+	PROFILE_END(PROFILE_SCOPE_DMA1_CH1_IRQ);
 }
 
 
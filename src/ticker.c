@@ -0,0 +1,152 @@
+/*
+ * Autor: Nico Korn
+ * Date: 19.10.2026
+ * Firmware for a alarmlcock with custom made STM32F103 microcontroller board.
+ *  *
+ * Copyright (c) 2026 Nico Korn
+ *
+ * ticker.c this module contents a non blocking running text for messages on the display.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+
+// ----------------------------------------------------------------------------
+
+#include "ticker.h"
+
+/* defines */
+#define TICKER_START_HOLD		500 	// in ms, the beginning of the text is shown before it starts running
+#define TICKER_SCROLL_PERIOD	30 		// in ms, minimum period between two scroll steps
+#define TICKER_END_HOLD			500 	// in ms, the end of the text is shown before the message is done
+
+/* private variables */
+static Ticker_State			ticker_state;
+static char					*ticker_string;
+static uint8_t				*ticker_red, *ticker_green, *ticker_blue;
+static uint16_t				*ticker_ambient_factor;
+static int16_t				ticker_offset;
+static int16_t				ticker_scroll_end;
+static uint32_t				ticker_step_tick;
+
+/* global variables */
+extern volatile uint8_t 		WS2812_TC;					// led transmission flag
+
+/**
+  * @brief  initialization of the ticker
+  * @note   None
+  * @retval None
+  */
+void init_ticker(void){
+	ticker_state = TICKER_IDLE;
+	ticker_string = NULL;
+}
+
+/**
+  * @brief  starts a new message on the ticker, a running message is replaced
+  * @note   the string is not copied and has to stay valid until the message is done
+  * @retval None
+  */
+void ticker_start(char *string, uint8_t *red, uint8_t *green, uint8_t *blue, uint16_t *ambient_factor){
+	ticker_string = string;
+	ticker_red = red;
+	ticker_green = green;
+	ticker_blue = blue;
+	ticker_ambient_factor = ambient_factor;
+	/* the text starts at the left border of the display */
+	ticker_offset = 0;
+	ticker_scroll_end = get_string_scroll_end(string);
+	ticker_step_tick = HAL_GetTick();
+	ticker_state = TICKER_HOLD_START;
+}
+
+/**
+  * @brief  stops the running message without queueing a done event
+  * @note   None
+  * @retval None
+  */
+void ticker_stop(void){
+	ticker_state = TICKER_IDLE;
+}
+
+/**
+  * @brief  checks if a message is running on the ticker
+  * @note   None
+  * @retval 1 if a message is running, else 0
+  */
+uint8_t ticker_busy(void){
+	return ticker_state != TICKER_IDLE;
+}
+
+/**
+  * @brief  advances the running message by one step and draws it on the display, has to be called every display tick
+  * @note   if the message is done, EVENT_TYPE_DONE of EVENT_SOURCE_TICKER is queued
+  * @retval 1 if the ticker has drawn the display, else 0
+  */
+uint8_t ticker_tick(void){
+	uint32_t elapsed;
+
+	if(ticker_state == TICKER_IDLE){
+		return 0;
+	}
+
+	/* advance the message by at most one step per display tick */
+	elapsed = HAL_GetTick() - ticker_step_tick;
+	switch(ticker_state){
+		case TICKER_HOLD_START:	if(elapsed >= TICKER_START_HOLD){
+									ticker_step_tick = HAL_GetTick();
+									if(ticker_offset-1 > ticker_scroll_end){
+										ticker_offset--;
+										ticker_state = TICKER_SCROLL;
+									}else{
+										ticker_state = TICKER_HOLD_END;
+									}
+								}
+		break;
+		case TICKER_SCROLL:		if(elapsed >= TICKER_SCROLL_PERIOD){
+									ticker_step_tick = HAL_GetTick();
+									if(ticker_offset-1 > ticker_scroll_end){
+										ticker_offset--;
+									}else{
+										ticker_state = TICKER_HOLD_END;
+									}
+								}
+		break;
+		case TICKER_HOLD_END:	if(elapsed >= TICKER_END_HOLD){
+									ticker_state = TICKER_IDLE;
+									/* report the finished message */
+									queue_event(EVENT_TYPE_DONE, EVENT_SOURCE_TICKER, 0);
+									return 0;
+								}
+		break;
+		case TICKER_IDLE:
+		break;
+	}
+
+	/* erase frame buffer */
+	WS2812_clear_buffer();
+	/* write the visible part of the message into the frame buffer */
+	draw_string_frame(ticker_string, ticker_offset, 0, ticker_red, ticker_green, ticker_blue, ticker_ambient_factor);
+	/* wait for the data transmission to the led's to be ready */
+	WS2812_wait_transmission();
+	/* send frame buffer to the leds */
+	sendbuf_WS2812();
+	return 1;
+}
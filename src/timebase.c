@@ -0,0 +1,237 @@
+/*
+ * Autor: Nico Korn
+ * Date: 19.10.2026
+ * Firmware for a alarmlcock with custom made STM32F103 microcontroller board.
+ *  *
+ * Copyright (c) 2026 Nico Korn
+ *
+ * timebase.c this module contents the software time base on the 32 bit rtc counter
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+
+
+
+// ----------------------------------------------------------------------------
+
+#include "timebase.h"
+
+/* defines */
+#define TIMEBASE_DAYS_PER_ERA		146097U		// days of 400 gregorian years
+#define TIMEBASE_EPOCH_DAYS			730425U		// days from 1.3.0000 to 1.1.2000
+
+/* private variables */
+static volatile uint32_t	timebase_seconds;		// last read counter value
+static uint32_t				timebase_date_day = 0xFFFFFFFF;	// day of the cached date
+static RTC_DateTypeDef		timebase_date;			// cached date of timebase_date_day
+
+/* global variables */
+
+/* private functions */
+static void timebase_enter_config(void);
+static void timebase_exit_config(void);
+
+
+
+/**
+  * @brief  initializes the time base with the recent counter value
+  * @note   the rtc must be initialized with HAL_RTC_Init() before
+  * @retval None
+  */
+void init_timebase(void){
+	timebase_seconds = timebase_read();
+}
+
+/**
+  * @brief  reads the 32 bit rtc counter
+  * @note   the counter is split into two 16 bit registers, the high register is read twice
+  * 		to catch a carry between the two reads
+  * @retval seconds since the epoch
+  */
+uint32_t timebase_read(void){
+	uint16_t high, low;
+
+	high = RTC->CNTH;
+	low = RTC->CNTL;
+	if(RTC->CNTH != high){
+		high = RTC->CNTH;
+		low = RTC->CNTL;
+	}
+	return ((uint32_t)high << 16) | low;
+}
+
+/**
+  * @brief  writes the 32 bit rtc counter
+  * @note   None
+  * @retval None
+  */
+void timebase_write(uint32_t seconds){
+	timebase_enter_config();
+	RTC->CNTH = seconds >> 16;
+	RTC->CNTL = seconds & 0xFFFF;
+	timebase_exit_config();
+	timebase_seconds = seconds;
+}
+
+/**
+  * @brief  reads the counter once a second
+  * @note   called from the rtc second interrupt
+  * @retval None
+  */
+void timebase_second(void){
+	timebase_seconds = timebase_read();
+}
+
+/**
+  * @brief  returns the last read counter value without accessing the rtc
+  * @retval seconds since the epoch
+  */
+uint32_t timebase_now(void){
+	return timebase_seconds;
+}
+
+/**
+  * @brief  converts seconds since the epoch to the time of the day
+  * @note   None
+  * @retval None
+  */
+void timebase_get_time(uint32_t seconds, RTC_TimeTypeDef *time){
+	seconds = seconds % TIMEBASE_SECONDS_PER_DAY;
+	time->Hours = seconds / 3600;
+	seconds = seconds % 3600;
+	time->Minutes = seconds / 60;
+	time->Seconds = seconds % 60;
+}
+
+/**
+  * @brief  converts seconds since the epoch to the date
+  * @note   the date is calculated once a day, the other calls return the cached date.
+  * 		the conversion works with gregorian eras of 400 years and needs no loops
+  * @retval None
+  */
+void timebase_get_date(uint32_t seconds, RTC_DateTypeDef *date){
+	uint32_t day = seconds / TIMEBASE_SECONDS_PER_DAY;
+	uint32_t days, era, day_of_era, year_of_era, day_of_year, month_index, year;
+
+	if(day != timebase_date_day){
+		/* days since 1.3.0000, the year starts in march to have the leap day at the end */
+		days = day + TIMEBASE_EPOCH_DAYS;
+		era = days / TIMEBASE_DAYS_PER_ERA;
+		day_of_era = days - era * TIMEBASE_DAYS_PER_ERA;
+		year_of_era = (day_of_era - day_of_era/1460 + day_of_era/36524 - day_of_era/146096) / 365;
+		day_of_year = day_of_era - (365*year_of_era + year_of_era/4 - year_of_era/100);
+		month_index = (5*day_of_year + 2) / 153;
+		year = year_of_era + era * 400;
+
+		timebase_date.Date = day_of_year - (153*month_index + 2)/5 + 1;
+		timebase_date.Month = month_index < 10 ? month_index + 3 : month_index - 9;
+		timebase_date.Year = (timebase_date.Month <= 2 ? year + 1 : year) - 2000;
+		timebase_date.WeekDay = (day + TIMEBASE_EPOCH_WEEKDAY) % 7;
+		timebase_date_day = day;
+	}
+	*date = timebase_date;
+}
+
+/**
+  * @brief  sets the time of the day, the date is kept
+  * @note   None
+  * @retval None
+  */
+void timebase_set_time(RTC_TimeTypeDef *time){
+	uint32_t day = timebase_read() / TIMEBASE_SECONDS_PER_DAY;
+
+	timebase_write(day * TIMEBASE_SECONDS_PER_DAY + time->Hours * 3600U + time->Minutes * 60U + time->Seconds);
+}
+
+/**
+  * @brief  converts a date and time to seconds since the epoch
+  * @note   the year of the date counts from 2000
+  * @retval seconds since the epoch
+  */
+uint32_t timebase_from_calendar(RTC_DateTypeDef *date, RTC_TimeTypeDef *time){
+	uint32_t year = date->Year + 2000;
+	uint32_t month = date->Month;
+	uint32_t era, year_of_era, day_of_year, day_of_era, days;
+
+	/* the year starts in march */
+	if(month <= 2){
+		year--;
+	}
+	era = year / 400;
+	year_of_era = year - era * 400;
+	day_of_year = (153*(month > 2 ? month - 3 : month + 9) + 2)/5 + date->Date - 1;
+	day_of_era = year_of_era * 365 + year_of_era/4 - year_of_era/100 + day_of_year;
+	days = era * TIMEBASE_DAYS_PER_ERA + day_of_era - TIMEBASE_EPOCH_DAYS;
+
+	return days * TIMEBASE_SECONDS_PER_DAY + time->Hours * 3600U + time->Minutes * 60U + time->Seconds;
+}
+
+/**
+  * @brief  calculates the next point in time with the given time of the day
+  * @note   a time of the day equal to seconds results in the next day
+  * @retval seconds since the epoch
+  */
+uint32_t timebase_next(uint32_t seconds, RTC_TimeTypeDef *time){
+	uint32_t next = (seconds / TIMEBASE_SECONDS_PER_DAY) * TIMEBASE_SECONDS_PER_DAY + time->Hours * 3600U + time->Minutes * 60U + time->Seconds;
+
+	if(next <= seconds){
+		next += TIMEBASE_SECONDS_PER_DAY;
+	}
+	return next;
+}
+
+/**
+  * @brief  sets the rtc alarm register and enables the alarm interrupt
+  * @note   the alarm interrupt is raised when the counter reaches seconds
+  * @retval None
+  */
+void timebase_set_alarm(uint32_t seconds){
+	timebase_enter_config();
+	RTC->ALRH = seconds >> 16;
+	RTC->ALRL = seconds & 0xFFFF;
+	timebase_exit_config();
+	/* clear a pending alarm and enable the interrupt on the exti line of the alarm */
+	RTC->CRL &= ~RTC_CRL_ALRF;
+	RTC->CRH |= RTC_CRH_ALRIE;
+	__HAL_RTC_ALARM_EXTI_ENABLE_IT();
+	__HAL_RTC_ALARM_EXTI_ENABLE_RISING_EDGE();
+}
+
+/**
+  * @brief  enters the configuration mode of the rtc to write counter or alarm
+  * @note   None
+  * @retval None
+  */
+static void timebase_enter_config(void){
+	/* wait for the last write operation to be finished */
+	while(!(RTC->CRL & RTC_CRL_RTOFF));
+	RTC->CRL |= RTC_CRL_CNF;
+}
+
+/**
+  * @brief  leaves the configuration mode of the rtc, the registers are written now
+  * @note   None
+  * @retval None
+  */
+static void timebase_exit_config(void){
+	RTC->CRL &= ~RTC_CRL_CNF;
+	while(!(RTC->CRL & RTC_CRL_RTOFF));
+}
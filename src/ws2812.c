@@ -30,6 +30,11 @@
 // ----------------------------------------------------------------------------
 #include <lightsensor.h>
 #include "ws2812.h"
+#include "effect.h"
+#include "particle.h"
+#include "latency.h"
+#include "profile.h"
+#include "record.h"
 #include "stm32f1xx.h"
 #include <Math.h>
 #include <stdio.h>
@@ -44,16 +49,40 @@
 #define GPIO_BUFFERSIZE 		COL*24
 /* background RGB color buffer size */
 #define BACKGROUND_BUFFERSIZE 	ROW*COL*3
+/* colorfall hue steps between the rows of the first frame and between two frames */
+#define COLORFALL_ROW_HUE_STEP		20
+#define COLORFALL_FRAME_HUE_STEP	15
 /* global variables */
-uint8_t 					WS2812_TC;												//global scope: used in the main routine
+volatile uint8_t 			WS2812_TC;												//global scope: used in the main routine
 /* private variables */
-static uint8_t				stop_flag = 0;
 static uint8_t 				TIM2_overflows = 0;
-static uint8_t				init = 0;
 static uint8_t				clock_background_framebuffer[BACKGROUND_BUFFERSIZE];	//11 rows * 11 cols * 3 (RGB) = 363 --- separate frame buffer for background fx --- 1 array entry contents a color component information in 8 bit. 3 entries together = 1 RGB Information
 static uint16_t 			WS2812_IO_High = 0xFFFF;
 static uint16_t 			WS2812_IO_Low = 0x0000;
 static uint16_t 			WS2812_IO_framedata[GPIO_BUFFERSIZE];					// 11 cols * 24 bits (R(8bit), G(8bit), B(8bit)) = 266 --- output array transferred to GPIO output --- 1 array entry contents 16 bits parallel to GPIO output
+static uint8_t				colorfall_red, colorfall_green, colorfall_blue;
+static uint16_t				colorfall_hue;
+static uint8_t				background_row_offset;							// physical row of the top row in the background frame buffer
+static uint8_t				flash_count = 3;
+static uint16_t				colorfall_frames = 20;
+static uint16_t				led_test_frames = 380;
+
+/* private functions */
+static uint8_t* WS2812_background_row(uint8_t row);
+static void WS2812_background_scroll_up(void);
+static void WS2812_background_fill_row(uint8_t row, uint8_t red, uint8_t green, uint8_t blue);
+static void WS2812_background_to_framedata(void);
+static void WS2812_flash_step(Effect *effect);
+static uint8_t WS2812_flash_done(Effect *effect);
+static void WS2812_colorfall_step(Effect *effect);
+static uint8_t WS2812_colorfall_done(Effect *effect);
+static void WS2812_draw_glyph(const Number *number, int16_t x_offset, int8_t y_offset, uint8_t *red, uint8_t *green, uint8_t *blue, uint16_t *ambient_factor);
+
+/* private effects */
+static Effect				WS2812_effect_flash = 		{"flash",		EFFECT_CLASS_ALARM,		NULL,	WS2812_flash_step,		WS2812_flash_done,		12,	0,	&flash_count};
+static Effect				WS2812_effect_colorfall = 	{"colorfall",	EFFECT_CLASS_ALARM,		NULL,	WS2812_colorfall_step,	WS2812_colorfall_done,	10,	0,	&colorfall_frames};
+static Effect				WS2812_effect_led_test = 	{"led test",	EFFECT_CLASS_SYSTEM,	NULL,	WS2812_colorfall_step,	WS2812_colorfall_done,	10,	0,	&led_test_frames};
+
 /* private numbers and letters */
 static Number 				zero;
 static Number 				one;
@@ -66,6 +95,7 @@ static Number 				seven;
 static Number 				eight;
 static Number 				nine;
 static Number 				doublepoint;
+static const Number			*number_glyphs[10] = {&zero, &one, &two, &three, &four, &five, &six, &seven, &eight, &nine};	// glyph of a digit value
 static Letter 				m;
 static Letter 				w;
 static Letter 				a;
@@ -116,10 +146,38 @@ void init_ws2812(void){
 	init_timer();
 	init_font();
 
+	/* register effects, the order of the alarm effects sets the alarm style index */
+	if(!effect_register(&WS2812_effect_flash) || !effect_register(&WS2812_effect_colorfall)
+			|| !effect_register(&WS2812_effect_led_test)){
+		/* the registry is full, increase EFFECT_REGISTRY_LENGTH */
+		while(1){
+			//error
+		}
+	}
+
 	/* set transmission flag to 1 */
 	WS2812_TC = 1;
 }
 
+/**
+  * @brief  waits for the end of the recent data transmission to the leds
+  * @note   the core sleeps until the transmission complete interrupt, a pending interrupt
+  * 		wakes the core up although the interrupts are disabled during the check
+  * @retval None
+  */
+void WS2812_wait_transmission(void){
+	uint32_t primask = __get_PRIMASK();
+
+	__disable_irq();
+	while(!WS2812_TC){
+		__WFI();
+		/* let the pending interrupt run */
+		__set_PRIMASK(primask);
+		__disable_irq();
+	}
+	__set_PRIMASK(primask);
+}
+
 /**
   * @brief  initialization of hw timer for the serial data output
   * @note   None
@@ -272,6 +330,9 @@ void init_dma(void){
   * @retval None
   */
 void sendbuf_WS2812(){
+	PROFILE_BEGIN(PROFILE_SCOPE_SENDBUF);
+	latency_stamp(LATENCY_STAGE_SEND);
+	RECORD_INPUT(RECORD_TYPE_FRAME, 0);
 	/* transmission complete flag, indicate that transmission is taking place */
 	WS2812_TC = 0;
 
@@ -318,13 +379,16 @@ void sendbuf_WS2812(){
 
 	/* start TIM2 */
 	__HAL_TIM_ENABLE(&TIM2_Handle);
+	PROFILE_END(PROFILE_SCOPE_SENDBUF);
 }
 
 /* DMA1 Channel2 Interrupt Handler gets executed once the complete frame buffer
  * has been transmitted to the LEDs */
 void DMA1_Channel7_IRQHandler(void){
+	PROFILE_BEGIN(PROFILE_SCOPE_DMA1_CH7_IRQ);
 	/* set irq handler */
 	HAL_DMA_IRQHandler(&DMA_HandleStruct_CC2);
+	PROFILE_END(PROFILE_SCOPE_DMA1_CH7_IRQ);
 }
 
 /**
@@ -403,6 +467,7 @@ void DMA_SetConfiguration(DMA_HandleTypeDef *hdma, uint32_t SrcAddress, uint32_t
 void TransferComplete(DMA_HandleTypeDef *DmaHandle){
 	/* clear DMA7 transfer complete interrupt flag */
 	HAL_NVIC_ClearPendingIRQ(DMA1_Channel7_IRQn);
+	latency_stamp(LATENCY_STAGE_TRANSFER_COMPLETE);
 
 	/* enable TIM2 Update interrupt to append 50us dead period */
 	__HAL_TIM_ENABLE_IT(&TIM2_Handle, TIM_IT_UPDATE);
@@ -2179,32 +2244,12 @@ Letter char_to_letter(char charistic){
   * @retval None
   */
 Number char_to_number(char charistic){
-	Number number;
-	switch(charistic){
-		case '0':	return number = zero;
-		break;
-		case '1':	return number = one;
-		break;
-		case '2':	return number = two;
-		break;
-		case '3':	return number = three;
-		break;
-		case '4':	return number = four;
-		break;
-		case '5':	return number = five;
-		break;
-		case '6':	return number = six;
-		break;
-		case '7':	return number = seven;
-		break;
-		case '8':	return number = eight;
-		break;
-		case '9':	return number = nine;
-		break;
-		case ':':	return number = doublepoint;
-		break;
-		default: return number = zero;
+	if(charistic >= '0' && charistic <= '9'){
+		return *number_glyphs[charistic - '0'];
+	}else if(charistic == ':'){
+		return doublepoint;
 	}
+	return zero;
 }
 
 /* This function sets the color of a single pixel in the clock_background_framebuffer
@@ -2218,6 +2263,7 @@ void WS2812_framedata_setPixel(uint8_t row, uint16_t column, uint8_t red, uint8_
 
 	uint8_t i;
 
+	PROFILE_BEGIN(PROFILE_SCOPE_SETPIXEL);
 	for (i = 0; i < 8; i++){
 		/* clear the data for pixel */
 		WS2812_IO_framedata[((column*24)+i)] &= ~(0x01<<row);
@@ -2229,6 +2275,7 @@ void WS2812_framedata_setPixel(uint8_t row, uint16_t column, uint8_t red, uint8_
 		WS2812_IO_framedata[((column*24)+8+i)] |= ((((red<<i) & 0x80)>>7)<<row);
 		WS2812_IO_framedata[((column*24)+16+i)] |= ((((blue<<i) & 0x80)>>7)<<row);
 	}
+	PROFILE_END(PROFILE_SCOPE_SETPIXEL);
 }
 
 /* This function clears the ws2812 color buffer
@@ -2237,12 +2284,14 @@ void WS2812_framedata_setPixel(uint8_t row, uint16_t column, uint8_t red, uint8_
  * none
  */
 void WS2812_clear_buffer(){
+	PROFILE_BEGIN(PROFILE_SCOPE_CLEAR_BUFFER);
 	/* clear frame buffer */
 	for(uint8_t y=0; y<ROW;y++){
 		for(uint16_t x=0; x<COL; x++){
 			WS2812_framedata_setPixel(y, x, 0x00, 0x00, 0x00);
 		}
 	}
+	PROFILE_END(PROFILE_SCOPE_CLEAR_BUFFER);
 }
 
 /* This function sets a line with start point and end point
@@ -2312,16 +2361,13 @@ void WS2812_set_line(int8_t row_start, int16_t column_start, int8_t row_end, int
   */
 void WS2812_color_wheel_plus(uint8_t *red, uint8_t *green, uint8_t *blue){
 	//set next colors
-	if(*green == 0x00 && *red < 0xff && *blue >= 0x00){
+	if(*green == 0x00 && *red < 0xff){
 		*red += 0x01;
-		*green = 0x00;
 		*blue -= 0x01;
-	}else if(*green < 0xff && *red >= 0x00 && *blue == 0x00){
+	}else if(*green < 0xff && *blue == 0x00){
 		*red -= 0x01;
 		*green += 0x01;
-		*blue = 0x00;
-	}else if(*green >= 0x00 && *red == 0x00 && *blue < 0xff){
-		*red = 0x00;
+	}else if(*red == 0x00 && *blue < 0xff){
 		*green -= 0x01;
 		*blue += 0x01;
 	}
@@ -2334,127 +2380,158 @@ void WS2812_color_wheel_plus(uint8_t *red, uint8_t *green, uint8_t *blue){
   */
 void WS2812_color_wheel_minus(uint8_t *red, uint8_t *green, uint8_t *blue){
 	//set next colors
-	if(*green == 0x00 && *red >= 0x00 && *blue < 0xff){
+	if(*green == 0x00 && *blue < 0xff){
 		*red -= 0x01;
-		*green = 0x00;
 		*blue += 0x01;
-	}else if(*green >= 0x00 && *red < 0xff && *blue == 0x00){
+	}else if(*red < 0xff && *blue == 0x00){
 		*red += 0x01;
 		*green -= 0x01;
-		*blue = 0x00;
-	}else if(*green < 0xff && *red == 0x00 && *blue >= 0x00){
-		*red = 0x00;
+	}else if(*green < 0xff && *red == 0x00){
 		*green += 0x01;
 		*blue -= 0x01;
 	}
 }
 
 /**
-  * @brief  led test
-  * @note   this function is used to test the rgb leds on all colors
-  * @retval -
+  * @brief  converts a hue into a color of the color wheel
+  * @note   the color wheel has WS2812_HUE_STEPS steps in 3 linear segments red->green->blue->red, hue 0 is
+  * 		pure red and hue n is the color after n calls of WS2812_color_wheel_plus starting at pure red
+  * @param  hue in the range 0..WS2812_HUE_STEPS-1
+  * @retval color in rgb
   */
-void WS2812_led_test(){
-	uint8_t redtest = 0xff;
-	uint8_t greentest = 0x00;
-	uint8_t bluetest = 0x00;
-
-	for(uint16_t i = 0; i<380; i++){
-		while(!WS2812_TC);
-		/* fill the complete buffer at first round */
-		if(i == 0){
-			for(uint8_t y = 0; y<ROW; y++){
-				/* set the color with the color wheel function */
-				for(uint8_t s=0; s<20; s++){
-					WS2812_color_wheel_plus(&redtest, &greentest, &bluetest);
-				}
-				for(uint16_t x = 0; x<COL; x++){
-					/* fill buffer for first frame */
-					clock_background_framebuffer[(y*COL*3)+(x*3)] = redtest;
-					clock_background_framebuffer[(y*COL*3)+(x*3)+1] = greentest;
-					clock_background_framebuffer[(y*COL*3)+(x*3)+2] = bluetest;
-				}
-			}
-		}else{
-			/* set the color with the color wheel function */
-			for(uint8_t s=0; s<15; s++){
-				WS2812_color_wheel_plus(&redtest, &greentest, &bluetest);
-			}
-			/* shift 1 row up */
-			for(uint16_t j=0; j<ROW-1; j++){
-				for(uint16_t s=0; s<3*COL; s++){
-					clock_background_framebuffer[j*COL*3+s] = clock_background_framebuffer[(j+1)*COL*3+s];
-				}
-			}
-			/* write new color in bottom row */
-			for(uint16_t j=0; j<COL; j++){
-				clock_background_framebuffer[((ROW-1)*COL*3)+(j*3)] = redtest;
-				clock_background_framebuffer[((ROW-1)*COL*3)+(j*3)+1] = greentest;
-				clock_background_framebuffer[((ROW-1)*COL*3)+(j*3)+2] = bluetest;
-			}
-		}
-		/* write buffer into buffer... lol */
-		for(uint8_t y = 0; y<ROW; y++){
-			for(uint16_t x = 0; x<COL; x++){
-				WS2812_framedata_setPixel(y, x, (uint8_t)clock_background_framebuffer[(y*COL*3)+(x*3)], (uint8_t)clock_background_framebuffer[(y*COL*3)+(x*3)+1], (uint8_t)clock_background_framebuffer[(y*COL*3)+(x*3)+2]);
-			}
-		}
-		sendbuf_WS2812();
-		HAL_Delay(10);
+void WS2812_hue_to_rgb(uint16_t hue, uint8_t *red, uint8_t *green, uint8_t *blue){
+	if(hue < 0xff){
+		*red = 0xff-hue;
+		*green = hue;
+		*blue = 0x00;
+	}else if(hue < 2*0xff){
+		hue -= 0xff;
+		*red = 0x00;
+		*green = 0xff-hue;
+		*blue = hue;
+	}else{
+		hue -= 2*0xff;
+		*red = hue;
+		*green = 0x00;
+		*blue = 0xff-hue;
 	}
 }
 
 /**
-  * @brief  matrix effect background
-  * @note   this function is used to test the rgb leds on all colors
-  * @retval -
+  * @brief  adds a step to a hue and wraps it around the color wheel
+  * @note   None
+  * @retval hue in the range 0..WS2812_HUE_STEPS-1
   */
-void WS2812_background_matrix(){
-	uint16_t drops[3];
-	uint16_t row_width = 11;
-
-	/* init clock_background_framebuffer */
-	if(init == 0){
-		init = 1;
-		for(uint8_t y = 0; y<ROW-1; y++){
-			for(uint16_t x = 0; x<COL; x++){
-				/* fill complete buffer */
-				clock_background_framebuffer[(y*11*3)+(x*3)] = 0x00;	//red
-				clock_background_framebuffer[(y*11*3)+(x*3)+1] = 0x00;	//green
-				clock_background_framebuffer[(y*11*3)+(x*3)+2] = 0x00;	//blue
-			}
-		}
+uint16_t WS2812_hue_add(uint16_t hue, uint16_t step){
+	hue += step;
+	while(hue >= WS2812_HUE_STEPS){
+		hue -= WS2812_HUE_STEPS;
 	}
+	return hue;
+}
 
-	/* frame buffer shift down */
-	/* shift 1 row down */
-	for(uint16_t row=9; row>0; row--){
-		for(uint16_t s=0; s<33; s++){
-			clock_background_framebuffer[row*row_width*3+s] = clock_background_framebuffer[(row-1)*row_width*3+s];
-		}
+/**
+  * @brief  gets a row of the background frame buffer
+  * @note   the rows are a ring, the row offset is the physical row of the top row on the display
+  * @retval pointer to the first color component of the row
+  */
+static uint8_t* WS2812_background_row(uint8_t row){
+	row += background_row_offset;
+	if(row >= ROW){
+		row -= ROW;
 	}
+	return &clock_background_framebuffer[row*COL*3];
+}
 
-	/* set drops with random numbers */
-	for(int i = 0; i<3; i++){
-		drops[i] = (rand() % 11);
+/**
+  * @brief  scrolls the background frame buffer 1 row up
+  * @note   only the row offset is moved, the old top row becomes the bottom row and has to be overwritten
+  * @retval -
+  */
+static void WS2812_background_scroll_up(void){
+	background_row_offset++;
+	if(background_row_offset >= ROW){
+		background_row_offset = 0;
 	}
+}
 
-	/* write top row into frame buffer with drops*/
+/**
+  * @brief  fills a row of the background frame buffer with a color
+  * @note   None
+  * @retval -
+  */
+static void WS2812_background_fill_row(uint8_t row, uint8_t red, uint8_t green, uint8_t blue){
+	uint8_t *pixel = WS2812_background_row(row);
 	for(uint16_t x = 0; x<COL; x++){
-		for(uint8_t i = 0; i<3; i++){
-			if(x == drops[i]){
-				clock_background_framebuffer[3*x] = 0x00;
-				clock_background_framebuffer[3*x+1] = rand() & 0x33;
-				clock_background_framebuffer[3*x+2] = 0x00;
-			}
-		}
+		*pixel++ = red;
+		*pixel++ = green;
+		*pixel++ = blue;
 	}
-	/* write buffer into buffer... lol */
-	for(uint8_t y = 0; y<ROW-1; y++){
+}
+
+/**
+  * @brief  writes the background frame buffer into the frame buffer
+  * @note   the rows are read in the order of the row ring
+  * @retval -
+  */
+static void WS2812_background_to_framedata(void){
+	uint8_t *pixel;
+	for(uint8_t y = 0; y<ROW; y++){
+		pixel = WS2812_background_row(y);
 		for(uint16_t x = 0; x<COL; x++){
-			WS2812_framedata_setPixel(y, x, (uint8_t)clock_background_framebuffer[(y*11*3)+(x*3)], (uint8_t)clock_background_framebuffer[(y*11*3)+(x*3)+1], (uint8_t)clock_background_framebuffer[(y*11*3)+(x*3)+2]);
+			WS2812_framedata_setPixel(y, x, pixel[0], pixel[1], pixel[2]);
+			pixel += 3;
+		}
+	}
+}
+
+/**
+  * @brief  draws one frame of the colorfall into the frame buffer
+  * @note   the first frame fills the complete display, every following frame scrolls the colors 1 row up
+  * @retval -
+  */
+void WS2812_colorfall_frame(uint16_t frame){
+	/* fill the complete buffer at first round */
+	if(frame == 0){
+		colorfall_hue = 0;
+		background_row_offset = 0;
+		for(uint8_t y = 0; y<ROW; y++){
+			/* set the color with the color wheel */
+			colorfall_hue = WS2812_hue_add(colorfall_hue, COLORFALL_ROW_HUE_STEP);
+			WS2812_hue_to_rgb(colorfall_hue, &colorfall_red, &colorfall_green, &colorfall_blue);
+			WS2812_background_fill_row(y, colorfall_red, colorfall_green, colorfall_blue);
 		}
+	}else{
+		/* set the color with the color wheel */
+		colorfall_hue = WS2812_hue_add(colorfall_hue, COLORFALL_FRAME_HUE_STEP);
+		WS2812_hue_to_rgb(colorfall_hue, &colorfall_red, &colorfall_green, &colorfall_blue);
+		/* scroll 1 row up and write new color in bottom row */
+		WS2812_background_scroll_up();
+		WS2812_background_fill_row(ROW-1, colorfall_red, colorfall_green, colorfall_blue);
+	}
+	WS2812_background_to_framedata();
+}
+
+/**
+  * @brief  led test
+  * @note   this function is used to test the rgb leds on all colors, the test runs on the effect player
+  * @retval -
+  */
+void WS2812_led_test(){
+	effect_play(&WS2812_effect_led_test);
+}
+
+/**
+  * @brief  matrix effect background
+  * @note   falling green drops from the particle engine, the frame buffer is not cleared
+  * @retval -
+  */
+void WS2812_background_matrix(){
+	if(particle_get_style() != PARTICLE_STYLE_RAIN){
+		particle_start(PARTICLE_STYLE_RAIN);
 	}
+	particle_tick();
+	particle_draw();
 }
 
 /**
@@ -2469,107 +2546,50 @@ void WS2812_foreground_colour(uint8_t red, uint8_t green, uint8_t blue){
 			WS2812_framedata_setPixel(y, x, red, green, blue);
 		}
 	}
-	while(!WS2812_TC);
+	WS2812_wait_transmission();
 	/* send frame buffer to the leds */
 	sendbuf_WS2812();
 }
 
 /**
-  * @brief  this function lets the display flash
-  * @note   this function lets the display flash
+  * @brief  draws one frame of the flash effect, the display is white on even and dark on odd frames
+  * @note   None
   * @retval -
   */
-uint8_t WS2812_display_flash(uint32_t speed_ms, uint8_t flash_count){
-	for(uint8_t i = 0; i<flash_count; i++){
-		if(stop_flag){
-			stop_flag = 0;
-			return 1;
+static void WS2812_flash_step(Effect *effect){
+	uint8_t brightness = (effect->frame & 0x01) ? 0x00 : 0xFF;
+	for(uint8_t y=0; y<ROW;y++){
+		for(uint16_t x=0; x<COL; x++){
+			WS2812_framedata_setPixel(y, x, brightness, brightness, brightness);
 		}
-		/* set foreground to white */
-		WS2812_foreground_colour(0xFF, 0xFF , 0xFF);
-		/* wait until peripherals are ready */
-		while(!WS2812_TC);
-		/* send frame buffer to the leds */
-		sendbuf_WS2812();
-		/* wait specified time */
-		HAL_Delay(speed_ms>>2);
-		/* clear display */
-		WS2812_foreground_colour(0x00, 0x00, 0x00);
-		/* wait until peripherals are ready */
-		while(!WS2812_TC);
-		/* send frame buffer to the leds */
-		sendbuf_WS2812();
-		/* wait specified time */
-		HAL_Delay(speed_ms>>2);
 	}
 }
 
 /**
-  * @brief  led test
-  * @note   this function shows a colorfall on the display
+  * @brief  checks if the display has flashed the number of times given by the effect data
+  * @note   None
+  * @retval 1 if the effect is finished, else 0
+  */
+static uint8_t WS2812_flash_done(Effect *effect){
+	return effect->frame >= 2*(*(uint8_t*)effect->data);
+}
+
+/**
+  * @brief  draws one frame of the colorfall effect
+  * @note   None
   * @retval -
   */
-uint8_t WS2812_display_colorfall(void){
-	uint8_t redtest = 0xff;
-	uint8_t greentest = 0x00;
-	uint8_t bluetest = 0x00;
-
-	for(uint16_t i = 0; i<20; i++){
-		if(stop_flag){
-			stop_flag = 0;
-			return 1;
-		}
-		while(!WS2812_TC);
-		/* fill the complete buffer at first round */
-		if(i == 0){
-			for(uint8_t y = 0; y<ROW; y++){
-				/* set the color with the color wheel function */
-				for(uint8_t s=0; s<20; s++){
-					WS2812_color_wheel_plus(&redtest, &greentest, &bluetest);
-				}
-				for(uint16_t x = 0; x<COL; x++){
-					/* fill buffer for first frame */
-					clock_background_framebuffer[(y*COL*3)+(x*3)] = redtest;
-					clock_background_framebuffer[(y*COL*3)+(x*3)+1] = greentest;
-					clock_background_framebuffer[(y*COL*3)+(x*3)+2] = bluetest;
-				}
-			}
-		}else{
-			/* set the color with the color wheel function */
-			for(uint8_t s=0; s<15; s++){
-				WS2812_color_wheel_plus(&redtest, &greentest, &bluetest);
-			}
-			/* shift 1 row up */
-			for(uint16_t j=0; j<ROW-1; j++){
-				for(uint16_t s=0; s<3*COL; s++){
-					clock_background_framebuffer[j*COL*3+s] = clock_background_framebuffer[(j+1)*COL*3+s];
-				}
-			}
-			/* write new color in bottom row */
-			for(uint16_t j=0; j<COL; j++){
-				clock_background_framebuffer[((ROW-1)*COL*3)+(j*3)] = redtest;
-				clock_background_framebuffer[((ROW-1)*COL*3)+(j*3)+1] = greentest;
-				clock_background_framebuffer[((ROW-1)*COL*3)+(j*3)+2] = bluetest;
-			}
-		}
-		/* write buffer into buffer... lol */
-		for(uint8_t y = 0; y<ROW; y++){
-			for(uint16_t x = 0; x<COL; x++){
-				WS2812_framedata_setPixel(y, x, (uint8_t)clock_background_framebuffer[(y*COL*3)+(x*3)], (uint8_t)clock_background_framebuffer[(y*COL*3)+(x*3)+1], (uint8_t)clock_background_framebuffer[(y*COL*3)+(x*3)+2]);
-			}
-		}
-		sendbuf_WS2812();
-		HAL_Delay(10);
-	}
+static void WS2812_colorfall_step(Effect *effect){
+	WS2812_colorfall_frame(effect->frame);
 }
 
 /**
-  * @brief  stops running animations
+  * @brief  checks if the colorfall has shown the number of frames given by the effect data
   * @note   None
-  * @retval None
+  * @retval 1 if the effect is finished, else 0
   */
-void WS2812_stop_animation(void){
-	stop_flag = 1;
+static uint8_t WS2812_colorfall_done(Effect *effect){
+	return effect->frame >= *(uint16_t*)effect->data;
 }
 
 /**
@@ -2588,14 +2608,14 @@ void draw_letter(char character, int16_t x_offset, int8_t y_offset, uint8_t *red
 }
 
 /**
-  * @brief  draws a a number into the IO buffer
-  * @note   None
+  * @brief  draws a number glyph into the IO buffer
+  * @note   pixels outside of the display are clipped
   * @retval None
   */
-void draw_number(char character, int16_t x_offset, int8_t y_offset, uint8_t *red, uint8_t *green, uint8_t *blue, uint16_t *ambient_factor){
+static void WS2812_draw_glyph(const Number *number, int16_t x_offset, int8_t y_offset, uint8_t *red, uint8_t *green, uint8_t *blue, uint16_t *ambient_factor){
 	for(int16_t x = 0; x < 3; x++){
 		for(int8_t y = 0; y < 7; y++){
-			if(char_to_number(character).number_construction[x][y] != 0 && (y_offset+y >= 0) && (y_offset+y < ROW) && (x_offset+x >= 0) && (x_offset+x < COL)){
+			if(number->number_construction[x][y] != 0 && (y_offset+y >= 0) && (y_offset+y < ROW) && (x_offset+x >= 0) && (x_offset+x < COL)){
 				WS2812_framedata_setPixel((uint8_t)y_offset + (uint8_t)y, (uint16_t)x_offset + (uint16_t)x, (uint8_t)*red*(uint8_t)*ambient_factor, (uint8_t)*green*(uint8_t)*ambient_factor, (uint8_t)*blue*(uint8_t)*ambient_factor);
 			}
 		}
@@ -2603,13 +2623,34 @@ void draw_number(char character, int16_t x_offset, int8_t y_offset, uint8_t *red
 }
 
 /**
-  * @brief  draws a a letter into the IO buffer
+  * @brief  draws a a number into the IO buffer
   * @note   None
   * @retval None
   */
-void draw_string(char *string, int16_t x_offset, int8_t y_offset, uint8_t *red, uint8_t *green, uint8_t *blue, uint16_t *ambient_factor){
+void draw_number(char character, int16_t x_offset, int8_t y_offset, uint8_t *red, uint8_t *green, uint8_t *blue, uint16_t *ambient_factor){
+	Number number = char_to_number(character);
+	WS2812_draw_glyph(&number, x_offset, y_offset, red, green, blue, ambient_factor);
+}
+
+/**
+  * @brief  draws the number glyph of a digit value into the IO buffer
+  * @note   values above 9 are not drawn
+  * @retval None
+  */
+void draw_digit(uint8_t digit, int16_t x_offset, int8_t y_offset, uint8_t *red, uint8_t *green, uint8_t *blue, uint16_t *ambient_factor){
+	if(digit > 9){
+		return;
+	}
+	WS2812_draw_glyph(number_glyphs[digit], x_offset, y_offset, red, green, blue, ambient_factor);
+}
+
+/**
+  * @brief  calculates the last scroll offset of a string which is too long for the display
+  * @note   returns 0 if the string fits on the display and therefore needs no scrolling
+  * @retval scroll end offset
+  */
+int16_t get_string_scroll_end(char *string){
 	int16_t length = strlen(string);
-	int16_t x_offset_letter = x_offset;
 	int16_t additional_frame = 0;
 	/* calculate the amount of frames to roll the whole text through the display */
 	for(uint8_t i = 0; i < length; i++){
@@ -2617,57 +2658,34 @@ void draw_string(char *string, int16_t x_offset, int8_t y_offset, uint8_t *red,
 			additional_frame+=2;
 		}
 	}
-	/* if text length is longer than the display, let it run through it, else just write text on it*/
+	/* if text length is longer than the display, it has to run through it */
 	if(4*length > COL){
-		/* write and display */
-		for(int16_t j = 0; j>((-4)*length)+(17)-additional_frame; j--){
-			/* erase frame buffer */
-			WS2812_clear_buffer();
-			/* write letters into buffer for 1 frame */
-			for(uint8_t i = 0; i < length; i++){
-				draw_letter(*(string+i), j+x_offset_letter, y_offset, red, green, blue, ambient_factor);
-				if(*(string+i+1) == 'm' || *(string+i+1) == 'w'){
-					x_offset_letter += 4;
-				}else if(*(string+i) == 'm' || *(string+i) == 'w'){
-					x_offset_letter += 6;
-				}else{
-					x_offset_letter += 4;
-				}
-			}
-			x_offset_letter = x_offset;
-			/* wait for the data transmission to the led's to be ready */
-			while(!WS2812_TC);
-			/* send frame buffer to the leds */
-			sendbuf_WS2812();
-			/* delay that the user can read the message */
-			/* roll through the text with XX ms period */
-			if(j == 0){
-				HAL_Delay(500);
-			}else{
-				HAL_Delay(30);
-			}
-		}
-		/* wait a bit to show the letters */
-		HAL_Delay(500);
+		return ((-4)*length)+COL-additional_frame;
 	}else{
-		/* erase frame buffer */
-		WS2812_clear_buffer();
-		/* write letters into buffer for 1 frame */
-		for(uint8_t i = 0; i < length; i++){
-			draw_letter(*(string+i), x_offset_letter, y_offset, red, green, blue, ambient_factor);
-			if(*(string+i+1) == 'm' || *(string+i+1) == 'w'){
-				x_offset_letter += 4;
-			}else if(*(string+i) == 'm' || *(string+i) == 'w'){
-				x_offset_letter += 6;
-			}else{
-				x_offset_letter += 4;
-			}
+		return 0;
+	}
+}
+
+/**
+  * @brief  draws the letters of a string into the IO buffer
+  * @note   the IO buffer is neither erased nor sent
+  * @retval None
+  */
+void draw_string_frame(char *string, int16_t x_offset, int8_t y_offset, uint8_t *red, uint8_t *green, uint8_t *blue, uint16_t *ambient_factor){
+	int16_t length = strlen(string);
+	int16_t x_offset_letter = x_offset;
+
+	PROFILE_BEGIN(PROFILE_SCOPE_DRAW_STRING);
+	/* write letters into buffer for 1 frame */
+	for(uint8_t i = 0; i < length; i++){
+		draw_letter(*(string+i), x_offset_letter, y_offset, red, green, blue, ambient_factor);
+		if(*(string+i+1) == 'm' || *(string+i+1) == 'w'){
+			x_offset_letter += 4;
+		}else if(*(string+i) == 'm' || *(string+i) == 'w'){
+			x_offset_letter += 6;
+		}else{
+			x_offset_letter += 4;
 		}
-		x_offset_letter = x_offset;
-		/* wait for the data transmission to the led's to be ready */
-		while(!WS2812_TC);
-		/* send frame buffer to the leds */
-		sendbuf_WS2812();
-		/* delay that the user can read the message */
 	}
+	PROFILE_END(PROFILE_SCOPE_DRAW_STRING);
 }
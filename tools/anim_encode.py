@@ -0,0 +1,198 @@
+#!/usr/bin/env python3
+"""
+Encoder for the animation assets of the alarmclock.
+
+The animations are written as text files (tools/animations/*.anim):
+
+    # comment
+    name sunrise
+    period 80                   frame period in ms
+    color . 000000              palette entry: character and rgb in hex
+    color s 604000
+    frame                       followed by ROW lines with COL characters
+    .................
+    ...
+
+The first frame is encoded as key frame, every following frame as delta
+against the previous frame or as key frame if that is shorter. The format
+is described in include/animation.h.
+
+usage: anim_encode.py -o src/animation_assets.c tools/animations/*.anim
+"""
+
+import argparse
+import os
+import sys
+
+ROW = 7
+COL = 17
+
+ANIMATION_VERSION = 1
+FRAME_DELTA = 0x00
+FRAME_KEY = 0x01
+OP_END = 0x00
+OP_RUN = 0x80
+OP_PIXEL = 0xC0
+MAX_SKIP = 0x7F
+MAX_RUN = 64
+MAX_PALETTE = 64
+
+
+def parse(path):
+    name = os.path.splitext(os.path.basename(path))[0]
+    period = 50
+    palette = []
+    keys = {}
+    frames = []
+    lines = None
+    for number, line in enumerate(open(path), 1):
+        line = line.rstrip('\n')
+        if not line.strip() or line.lstrip().startswith('#'):
+            continue
+        if lines is not None and len(lines) < ROW:
+            if len(line) != COL:
+                sys.exit('%s:%d: expected %d pixels' % (path, number, COL))
+            try:
+                lines.append([keys[c] for c in line])
+            except KeyError as e:
+                sys.exit('%s:%d: unknown color %s' % (path, number, e))
+            if len(lines) == ROW:
+                frames.append([p for row in lines for p in row])
+            continue
+        words = line.split()
+        if words[0] == 'name':
+            name = words[1]
+        elif words[0] == 'period':
+            period = int(words[1])
+        elif words[0] == 'color':
+            keys[words[1]] = len(palette)
+            palette.append(bytes.fromhex(words[2]))
+        elif words[0] == 'frame':
+            lines = []
+        else:
+            sys.exit('%s:%d: unknown keyword %s' % (path, number, words[0]))
+    if lines is not None and len(lines) != ROW:
+        sys.exit('%s: last frame is incomplete' % path)
+    if not frames or len(frames) > 255:
+        sys.exit('%s: 1..255 frames expected' % path)
+    if not palette or len(palette) > MAX_PALETTE:
+        sys.exit('%s: 1..%d colors expected' % (path, MAX_PALETTE))
+    if not 0 < period < 256:
+        sys.exit('%s: period 1..255 ms expected' % path)
+    return name, period, palette, frames
+
+
+def encode_frame(frame, previous, palette):
+    """encodes the pixels which differ from previous, previous None is a key frame"""
+    if previous is None:
+        dark = [None] * len(frame)
+        changed = [palette[c] != b'\x00\x00\x00' for c in frame]
+    else:
+        dark = previous
+        changed = [c != p for c, p in zip(frame, dark)]
+    ops = bytearray([FRAME_KEY if previous is None else FRAME_DELTA])
+    i = 0
+    skip = 0
+    while i < len(frame):
+        if not changed[i]:
+            skip += 1
+            i += 1
+            continue
+        while skip:
+            n = min(skip, MAX_SKIP)
+            ops.append(n)
+            skip -= n
+        run = 1
+        while i + run < len(frame) and run < MAX_RUN and changed[i + run] and frame[i + run] == frame[i]:
+            run += 1
+        if run == 1:
+            ops.append(OP_PIXEL | frame[i])
+        else:
+            ops += bytes([OP_RUN | (run - 1), frame[i]])
+        i += run
+    ops.append(OP_END)
+    return bytes(ops)
+
+
+def decode(data):
+    """reference decoder, used to verify the encoded asset"""
+    assert data[0] == ANIMATION_VERSION
+    size, count = data[1], data[3]
+    palette = [bytes(data[4 + 3 * i:7 + 3 * i]) for i in range(size)]
+    position = 4 + 3 * size
+    canvas = [b'\x00\x00\x00'] * (ROW * COL)
+    frames = []
+    for _ in range(count):
+        if data[position] == FRAME_KEY:
+            canvas = [b'\x00\x00\x00'] * (ROW * COL)
+        position += 1
+        pixel = 0
+        while data[position] != OP_END:
+            op = data[position]
+            if op < OP_RUN:
+                pixel += op
+                position += 1
+            elif op < OP_PIXEL:
+                for _ in range((op & 0x3F) + 1):
+                    canvas[pixel] = palette[data[position + 1]]
+                    pixel += 1
+                position += 2
+            else:
+                canvas[pixel] = palette[op & 0x3F]
+                pixel += 1
+                position += 1
+        position += 1
+        frames.append(list(canvas))
+    assert position == len(data)
+    return frames
+
+
+def encode(period, palette, frames):
+    data = bytearray([ANIMATION_VERSION, len(palette), period, len(frames)])
+    for color in palette:
+        data += color
+    previous = None
+    for index, frame in enumerate(frames):
+        key = encode_frame(frame, None, palette)
+        if previous is not None:
+            delta = encode_frame(frame, previous, palette)
+            if len(delta) < len(key):
+                key = delta
+        data += key
+        previous = frame
+    return bytes(data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='encodes animations for the alarmclock')
+    parser.add_argument('-o', '--output', required=True, help='generated c source')
+    parser.add_argument('animations', nargs='+', help='.anim files')
+    args = parser.parse_args()
+
+    out = ['/*',
+           ' * animation_assets.c this module contents the animation assets, generated by tools/anim_encode.py.',
+           ' * Do not edit, change the .anim files in tools/animations and run the encoder again.',
+           ' */',
+           '',
+           '#include "animation.h"',
+           '']
+    for path in args.animations:
+        name, period, palette, frames = parse(path)
+        data = encode(period, palette, frames)
+        expected = [[palette[c] for c in frame] for frame in frames]
+        if decode(data) != expected:
+            sys.exit('%s: verification of the encoded animation failed' % path)
+        raw = len(frames) * ROW * COL * 3
+        out.append('/* %s: %d frames, %d bytes (%d bytes uncompressed) */' % (os.path.basename(path), len(frames), len(data), raw))
+        out.append('const uint8_t animation_%s[] = {' % name)
+        for i in range(0, len(data), 16):
+            out.append('\t' + ' '.join('0x%02X,' % b for b in data[i:i + 16]))
+        out.append('};')
+        out.append('')
+        print('%s: %d frames, %d bytes (%d bytes uncompressed)' % (name, len(frames), len(data), raw))
+    with open(args.output, 'w') as f:
+        f.write('\n'.join(out))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+"""
+Decoder for the cycle profiler records of the alarmclock.
+
+The firmware sends the records on an ITM stimulus port when PROFILE is
+defined in include/profile.h. The record format is described there.
+Capture the SWO output with the debugger, e.g. with openocd:
+
+    tpiu config internal swo.bin uart off 72000000 2000000
+    itm port 1 on
+
+and decode the capture:
+
+    profile_decode.py swo.bin
+
+Every report is printed as a table with the calls, the min, average and
+max cycles per call and the share of the report window of every scope.
+
+usage: profile_decode.py [--port N] [--raw] [--us] [file]
+"""
+
+import argparse
+import struct
+import sys
+
+RECORD_SYNC = 0xA5
+RECORD_REPORT = 0x01
+RECORD_NAME = 0x02
+RECORD_SCOPE = 0x03
+
+
+def itm_payload(data, port):
+    """Extracts the bytes of a stimulus port from an ITM/SWO stream."""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        header = data[i]
+        i += 1
+        if header & 0x03:
+            size = {1: 1, 2: 2, 3: 4}[header & 0x03]
+            payload = data[i:i + size]
+            i += size
+            if not header & 0x04 and header >> 3 == port:
+                out += payload
+        elif header in (0x00, 0x70, 0x80):
+            # synchronisation or overflow
+            continue
+        elif header & 0x80:
+            # timestamp or extension packet, the payload bytes continue while bit 7 is set
+            while i < len(data) and data[i] & 0x80:
+                i += 1
+            i += 1
+    return bytes(out)
+
+
+def records(data):
+    """Yields the records of the stimulus port stream."""
+    i = 0
+    while i + 2 <= len(data):
+        if data[i] != RECORD_SYNC:
+            i += 1
+            continue
+        kind = data[i + 1]
+        body = data[i + 2:]
+        if kind == RECORD_REPORT and len(body) >= 6:
+            count, mhz, window = struct.unpack_from('<BBI', body)
+            yield ('report', count, mhz, window)
+            i += 8
+        elif kind == RECORD_NAME and len(body) >= 2 and len(body) >= 2 + body[1]:
+            scope, length = body[0], body[1]
+            yield ('name', scope, body[2:2 + length].decode('ascii', 'replace'))
+            i += 4 + length
+        elif kind == RECORD_SCOPE and len(body) >= 17:
+            yield ('scope',) + struct.unpack_from('<BIIII', body)
+            i += 19
+        else:
+            # lost sync, search the next record
+            i += 1
+
+
+def print_report(report, scopes, names, in_us):
+    _, count, mhz, window = report
+    unit = 'us' if in_us else 'cycles'
+    div = float(mhz) if in_us else 1.0
+    print('window %.1f ms, %d MHz, %d scopes' % (window / (mhz * 1000.0), mhz, count))
+    print('%-20s %8s %12s %12s %12s %7s' % ('scope', 'calls', 'min ' + unit, 'avg ' + unit, 'max ' + unit, 'load'))
+    for scope, calls, cmin, cmax, total in sorted(scopes, key=lambda s: -s[4]):
+        name = names.get(scope, 'scope %d' % scope)
+        load = 100.0 * total / window if window else 0.0
+        print('%-20s %8d %12.1f %12.1f %12.1f %6.2f%%' % (name, calls, cmin / div, total / calls / div, cmax / div, load))
+    print('')
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('file', nargs='?', help='capture, stdin if omitted')
+    parser.add_argument('--port', type=int, default=1, help='stimulus port, PROFILE_ITM_PORT')
+    parser.add_argument('--raw', action='store_true', help='the capture contains the port bytes only')
+    parser.add_argument('--us', action='store_true', help='print microseconds instead of cycles')
+    args = parser.parse_args()
+
+    if args.file:
+        with open(args.file, 'rb') as f:
+            data = f.read()
+    else:
+        data = sys.stdin.buffer.read()
+    if not args.raw:
+        data = itm_payload(data, args.port)
+
+    names = {}
+    report = None
+    scopes = []
+    for record in records(data):
+        if record[0] == 'name':
+            names[record[1]] = record[2]
+        elif record[0] == 'scope':
+            if report is not None:
+                scopes.append(record[1:])
+        elif record[0] == 'report':
+            if report is not None:
+                print_report(report, scopes, names, args.us)
+            report = record
+            scopes = []
+    if report is not None:
+        print_report(report, scopes, names, args.us)
+
+
+if __name__ == '__main__':
+    main()
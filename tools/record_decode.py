@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+"""
+Decoder for the input recordings of the alarmclock.
+
+The firmware sends the records on an ITM stimulus port when RECORD is
+defined in include/record.h. The record format is described there.
+Capture the SWO output with the debugger, e.g. with openocd:
+
+    tpiu config internal swo.bin uart off 72000000 2000000
+    itm port 2 on
+
+and decode the capture into a recording, one record per line:
+
+    record_decode.py swo.bin > snooze.rec
+
+The recording is replayed by the host simulation:
+
+    sim/alarmclock_sim --replay snooze.rec --seconds 60 --report
+
+or on the target, after it has been converted into src/record_scenario.c:
+
+    record_decode.py --c swo.bin
+
+--report prints the frame intervals and the time from every queued event
+to the next transmitted frame of the capture, e.g. of a replay run.
+
+usage: record_decode.py [--port N] [--raw] [--c | --report] [file]
+"""
+
+import argparse
+import struct
+import sys
+
+from profile_decode import itm_payload
+
+RECORD_SYNC = 0x5A
+RECORD_SIZE = 10
+RECORD_PIN_LEVEL = 0x8000
+TYPES = ['pin', 'event', 'rtc', 'alarm', 'adc', 'frame']
+C_TYPES = ['RECORD_TYPE_PIN', 'RECORD_TYPE_EVENT', 'RECORD_TYPE_RTC', 'RECORD_TYPE_ALARM',
+           'RECORD_TYPE_ADC', 'RECORD_TYPE_FRAME']
+# Event_Type and Event_Source of include/event.h, an event record is packed with EVENT_RECORD
+EVENT_TYPES = ['NONE', 'PRESS', 'LONG_PRESS', 'REPEAT', 'DOUBLE_CLICK', 'SWITCH', 'BEEP', 'DONE']
+EVENT_SOURCES = ['NONE', 'MODE', 'PLUS', 'MINUS', 'SNOOZE', 'SWITCH_ALARM', 'BUZZER', 'TICKER']
+
+
+def records(data):
+    """Yields (ms, type, value) of the records of the stimulus port stream."""
+    i = 0
+    while i + RECORD_SIZE <= len(data):
+        if data[i] != RECORD_SYNC or data[i + 1] >= len(TYPES):
+            # lost sync, search the next record
+            i += 1
+            continue
+        ms, value = struct.unpack_from('<II', data, i + 2)
+        yield ms, data[i + 1], value
+        i += RECORD_SIZE
+
+
+def event_fields(value):
+    """Returns the names of the type and the source and the payload of an event record."""
+    kind, source = value >> 24, (value >> 16) & 0xFF
+    kind = EVENT_TYPES[kind] if kind < len(EVENT_TYPES) else str(kind)
+    source = EVENT_SOURCES[source] if source < len(EVENT_SOURCES) else str(source)
+    return kind, source, value & 0xFFFF
+
+
+def c_value(kind, value):
+    if TYPES[kind] != 'event':
+        return '0x%x' % value
+    event_type, source, payload = event_fields(value)
+    return 'EVENT_RECORD(EVENT_TYPE_%s,\tEVENT_SOURCE_%s,\t%u)' % (event_type, source, payload)
+
+
+def print_recording(entries):
+    print('# ms type value')
+    for ms, kind, value in entries:
+        print('%u %s 0x%x' % (ms, TYPES[kind], value))
+
+
+def print_c(entries):
+    """Prints the array of src/record_scenario.c, the times start at 0."""
+    first = entries[0][0] if entries else 0
+    print('const Record_Entry\t\t\trecord_scenario[] = {')
+    lines = ['\t\t\t\t\t\t\t\t\t{%u,\t%s,\t%s}' % (ms - first, C_TYPES[kind], c_value(kind, value))
+             for ms, kind, value in entries if TYPES[kind] not in ('pin', 'frame')]
+    print(',\n'.join(lines))
+    print('\t\t\t\t\t\t\t\t\t};')
+
+
+def print_report(entries):
+    frames = [ms for ms, kind, _ in entries if TYPES[kind] == 'frame']
+    intervals = [b - a for a, b in zip(frames, frames[1:])]
+    print('frames: %d' % len(frames))
+    if intervals:
+        print('frame interval: min %d ms, mean %.1f ms, max %d ms' %
+              (min(intervals), sum(intervals) / float(len(intervals)), max(intervals)))
+    latencies = {}
+    pending = []
+    for ms, kind, value in entries:
+        if TYPES[kind] == 'event':
+            pending.append((ms, value & 0xFFFF0000))
+        elif TYPES[kind] == 'frame':
+            for start, event in pending:
+                latencies.setdefault(event, []).append(ms - start)
+            pending = []
+    for event in sorted(latencies):
+        values = latencies[event]
+        event_type, source, _ = event_fields(event)
+        print('event %s %s to frame: %d events, mean %.1f ms, max %d ms' %
+              (source.lower(), event_type.lower(), len(values), sum(values) / float(len(values)), max(values)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('file', nargs='?', help='capture, stdin if omitted')
+    parser.add_argument('--port', type=int, default=2, help='stimulus port, RECORD_ITM_PORT')
+    parser.add_argument('--raw', action='store_true', help='the capture contains the port bytes only')
+    output = parser.add_mutually_exclusive_group()
+    output.add_argument('--c', action='store_true', help='print the scenario array of the target replay')
+    output.add_argument('--report', action='store_true', help='print frame intervals and event latencies')
+    args = parser.parse_args()
+
+    if args.file:
+        with open(args.file, 'rb') as f:
+            data = f.read()
+    else:
+        data = sys.stdin.buffer.read()
+    if not args.raw:
+        data = itm_payload(data, args.port)
+
+    entries = list(records(data))
+    if args.c:
+        print_c(entries)
+    elif args.report:
+        print_report(entries)
+    else:
+        print_recording(entries)
+
+
+if __name__ == '__main__':
+    main()